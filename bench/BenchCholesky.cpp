@@ -0,0 +1,53 @@
+#include "tool.hpp"
+
+using namespace mla;
+
+// n x n symmetric positive definite matrix.
+static Matrix make_spd(int n)
+{
+    Matrix a = make_matrix(n);
+    return dot(a.transpose(), a);
+}
+
+// Cholesky()
+static void BM_Cholesky_factorize(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_spd(n);
+    for (auto _ : state)
+    {
+        Cholesky cholesky = a.cholesky();
+        benchmark::DoNotOptimize(cholesky.factor().data());
+    }
+    report(state, 1.0 / 3 * n * n * n, 16.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Cholesky_factorize);
+
+// solve(const Vector& b)
+static void BM_Cholesky_solve_vector(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Cholesky cholesky = make_spd(n).cholesky();
+    Vector b = make_vector(n);
+    for (auto _ : state)
+    {
+        Vector vector = cholesky.solve(b);
+        benchmark::DoNotOptimize(vector.data());
+    }
+    report(state, 2.0 * n * n, 8.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Cholesky_solve_vector);
+
+// inverse()
+static void BM_Cholesky_inverse(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Cholesky cholesky = make_spd(n).cholesky();
+    for (auto _ : state)
+    {
+        Matrix matrix = cholesky.inverse();
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 2.0 * n * n * n, 24.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Cholesky_inverse);
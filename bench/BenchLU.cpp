@@ -0,0 +1,62 @@
+#include "tool.hpp"
+
+using namespace mla;
+
+// LU()
+static void BM_LU_factorize(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        LU lu = a.lu();
+        benchmark::DoNotOptimize(lu.factors().data());
+    }
+    report(state, 2.0 / 3 * n * n * n, 16.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_LU_factorize);
+
+// solve(const Vector& b)
+static void BM_LU_solve_vector(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    LU lu = make_matrix(n).lu();
+    Vector b = make_vector(n);
+    for (auto _ : state)
+    {
+        Vector vector = lu.solve(b);
+        benchmark::DoNotOptimize(vector.data());
+    }
+    report(state, 2.0 * n * n, 8.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_LU_solve_vector);
+
+// solve(const Matrix& b)
+static void BM_LU_solve_matrix(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    LU lu = make_matrix(n).lu();
+    Matrix b = make_matrix(n);
+    for (auto _ : state)
+    {
+        Matrix matrix = lu.solve(b);
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 2.0 * n * n * n, 24.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_LU_solve_matrix);
+
+// solve(ConstMatrixView a, const Vector& b)
+static void BM_LU_solve_direct(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    Vector b = make_vector(n);
+    for (auto _ : state)
+    {
+        Vector vector = solve(a, b);
+        benchmark::DoNotOptimize(vector.data());
+    }
+    report(state, 2.0 / 3 * n * n * n + 2.0 * n * n, 16.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_LU_solve_direct);
@@ -0,0 +1,72 @@
+#include "tool.hpp"
+
+using namespace mla;
+
+// dot() of 4x4 transforms
+static void BM_Mat_dot(benchmark::State& state)
+{
+    Mat4 a = {{4, -2, 1, 0}, {-2, 4, -2, 1}, {1, -2, 4, -2}, {0, 1, -2, 4}};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Mat4 mat = dot(a, a);
+        benchmark::DoNotOptimize(mat);
+    }
+    report(state, 128, 384);
+}
+BENCHMARK(BM_Mat_dot);
+
+// dot() of a 4x4 transform and a point
+static void BM_Mat_dot_vec(benchmark::State& state)
+{
+    Mat4 a = {{4, -2, 1, 0}, {-2, 4, -2, 1}, {1, -2, 4, -2}, {0, 1, -2, 4}};
+    Vec4 v = {1, 2, 3, 1};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Vec4 vec = dot(a, v);
+        benchmark::DoNotOptimize(vec);
+    }
+    report(state, 32, 192);
+}
+BENCHMARK(BM_Mat_dot_vec);
+
+// det()
+static void BM_Mat_det(benchmark::State& state)
+{
+    Mat3 a = {{1, 2, 3}, {4, 5, 6}, {7, 8, 0}};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.det());
+    }
+    report(state, 17, 72);
+}
+BENCHMARK(BM_Mat_det);
+
+// inv()
+static void BM_Mat_inv(benchmark::State& state)
+{
+    Mat4 a = {{4, -2, 1, 0}, {-2, 4, -2, 1}, {1, -2, 4, -2}, {0, 1, -2, 4}};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Mat4 mat = a.inv();
+        benchmark::DoNotOptimize(mat);
+    }
+    report(state, 128, 256);
+}
+BENCHMARK(BM_Mat_inv);
+
+// the same inverse through the dynamic Matrix, for comparison
+static void BM_Mat_inv_dynamic(benchmark::State& state)
+{
+    Matrix a = Mat4({4, -2, 1, 0}, {-2, 4, -2, 1}, {1, -2, 4, -2}, {0, 1, -2, 4});
+    for (auto _ : state)
+    {
+        Matrix matrix = a.inv();
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 128, 256);
+}
+BENCHMARK(BM_Mat_inv_dynamic);
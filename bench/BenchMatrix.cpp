@@ -0,0 +1,456 @@
+#include "tool.hpp"
+
+using namespace mla;
+
+// Matrix(int row, int col, double element)
+static void BM_Matrix_construct(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    for (auto _ : state)
+    {
+        Matrix matrix(n, n, 1);
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 0, 8.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_construct);
+
+// Matrix(const Matrix& that)
+static void BM_Matrix_copy(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        Matrix matrix = a;
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 0, 16.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_copy);
+
+// operator==()
+static void BM_Matrix_compare(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n), b = make_matrix(n);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a == b);
+    }
+    report(state, 0, 16.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_compare);
+
+// operator[]() begin() end()
+static void BM_Matrix_access(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    const Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        double sum = 0;
+        for (const auto& row : a)
+        {
+            for (int c = 0; c < n; c++)
+            {
+                sum += row[c];
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    report(state, 1.0 * n * n, 8.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_access);
+
+// rank()
+static void BM_Matrix_rank(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a.rank());
+    }
+    report(state, 2.0 / 3 * n * n * n, 16.0 * n * n);
+}
+// serial elimination, several minutes per iteration at order 4096
+BENCHMARK(BM_Matrix_rank)->RangeMultiplier(2)->Range(2, 2048);
+
+// rank() of a matrix of rank 16, the elimination stops after 16 pivots
+static void BM_Matrix_rank_low(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = dot(make_matrix(n).split_col(16).first, make_matrix(n).split_row(16).first);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a.rank());
+    }
+    report(state, 2.0 * 16 * n * n, 16.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_rank_low);
+
+// det()
+static void BM_Matrix_det(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a.det());
+    }
+    report(state, 2.0 / 3 * n * n * n, 16.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_det);
+
+// inv()
+static void BM_Matrix_inv(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        Matrix matrix = a.inv();
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 2.0 * n * n * n, 24.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_inv);
+
+// append_row() append_col()
+static void BM_Matrix_append_row(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        Matrix matrix = a;
+        matrix.append_row(a);
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 0, 32.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_append_row);
+
+static void BM_Matrix_append_col(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        Matrix matrix = a;
+        matrix.append_col(a);
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 0, 48.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_append_col);
+
+// operator+=() operator-=() operator*=()
+template <typename Action>
+static void run_in_place(benchmark::State& state, Action action)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n), b(n, n, 1);
+    for (auto _ : state)
+    {
+        action(a, b);
+        benchmark::ClobberMemory();
+    }
+    report(state, 1.0 * n * n, 24.0 * n * n);
+}
+
+static void BM_Matrix_add_assign(benchmark::State& state)
+{
+    run_in_place(state, [](Matrix& a, const Matrix& b)
+                 { a += b; });
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_add_assign);
+
+static void BM_Matrix_sub_assign(benchmark::State& state)
+{
+    run_in_place(state, [](Matrix& a, const Matrix& b)
+                 { a -= b; });
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_sub_assign);
+
+static void BM_Matrix_mul_assign(benchmark::State& state)
+{
+    run_in_place(state, [](Matrix& a, const Matrix& b)
+                 { a *= b; });
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_mul_assign);
+
+static void BM_Matrix_scale_assign(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        a *= 1.0;
+        benchmark::ClobberMemory();
+    }
+    report(state, 1.0 * n * n, 16.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_scale_assign);
+
+// E()
+static void BM_Matrix_E_swap(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        a.E(0, n - 1);
+        benchmark::ClobberMemory();
+    }
+    report(state, 0, 32.0 * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_E_swap);
+
+static void BM_Matrix_E_scale(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        a.E(0, 1.0);
+        benchmark::ClobberMemory();
+    }
+    report(state, n, 16.0 * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_E_scale);
+
+static void BM_Matrix_E_sum(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        a.E(0, n - 1, 0.0);
+        benchmark::ClobberMemory();
+    }
+    report(state, 2.0 * n, 24.0 * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_E_sum);
+
+// transform_row_echelon()
+static void BM_Matrix_transform_row_echelon(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        Matrix matrix = a;
+        matrix.transform_row_echelon();
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 2.0 / 3 * n * n * n, 16.0 * n * n);
+}
+// serial elimination, several minutes per iteration at order 4096
+BENCHMARK(BM_Matrix_transform_row_echelon)->RangeMultiplier(2)->Range(2, 2048);
+
+// map() across threads
+static void BM_Matrix_map(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        a.map([](int r, int c, double& e)
+              { e = r + c; },
+              true);
+        benchmark::ClobberMemory();
+    }
+    report(state, 1.0 * n * n, 8.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_map);
+
+// map() on the elements only, across threads
+static void BM_Matrix_map_element(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    const double scale = 0.5;
+    for (auto _ : state)
+    {
+        a.map([scale](double& e)
+              { e = e * scale + 1; },
+              true);
+        benchmark::ClobberMemory();
+    }
+    report(state, 2.0 * n * n, 16.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_map_element);
+
+// split_row() split_col()
+static void BM_Matrix_split_row(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        auto pair = a.split_row(n / 2);
+        benchmark::DoNotOptimize(pair.first.data());
+    }
+    report(state, 0, 16.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_split_row);
+
+static void BM_Matrix_split_col(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        auto pair = a.split_col(n / 2);
+        benchmark::DoNotOptimize(pair.first.data());
+    }
+    report(state, 0, 16.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_split_col);
+
+// transpose() transpose_inplace()
+static void BM_Matrix_transpose(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        Matrix matrix = a.transpose();
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 0, 16.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_transpose);
+
+static void BM_Matrix_transpose_inplace(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        a.transpose_inplace();
+        benchmark::ClobberMemory();
+    }
+    report(state, 0, 16.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_transpose_inplace);
+
+// eye()
+static void BM_Matrix_eye(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    for (auto _ : state)
+    {
+        Matrix matrix = Matrix::eye(n);
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 0, 8.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_eye);
+
+// operator+() operator-() operator*()
+template <typename Action>
+static void run_binary(benchmark::State& state, Action action)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n), b = make_matrix(n);
+    for (auto _ : state)
+    {
+        Matrix matrix = action(a, b);
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 1.0 * n * n, 24.0 * n * n);
+}
+
+static void BM_Matrix_add(benchmark::State& state)
+{
+    run_binary(state, [](const Matrix& a, const Matrix& b)
+               { return Matrix(a + b); });
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_add);
+
+static void BM_Matrix_sub(benchmark::State& state)
+{
+    run_binary(state, [](const Matrix& a, const Matrix& b)
+               { return Matrix(a - b); });
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_sub);
+
+static void BM_Matrix_mul(benchmark::State& state)
+{
+    run_binary(state, [](const Matrix& a, const Matrix& b)
+               { return Matrix(a * b); });
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_mul);
+
+static void BM_Matrix_scale(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        Matrix matrix = a * 2.0;
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 1.0 * n * n, 16.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_scale);
+
+// a + b * 2 - c * d, evaluated in a single pass through lazy()
+static void BM_Matrix_expression(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n), b = make_matrix(n), c = make_matrix(n), d = make_matrix(n);
+    for (auto _ : state)
+    {
+        Matrix matrix = lazy(a) + lazy(b) * 2 - lazy(c) * lazy(d);
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 4.0 * n * n, 40.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_expression);
+
+// dot()
+static void BM_Matrix_dot(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n), b = make_matrix(n);
+    for (auto _ : state)
+    {
+        Matrix matrix = dot(a, b);
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 2.0 * n * n * n, 24.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_dot);
+
+// dot() on float
+static void BM_Matrix_dot_float(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    const Matrix m = make_matrix(n);
+    BasicMatrix<float> a(n, n, 0);
+    std::copy(m.data(), m.data() + std::ptrdiff_t(n) * n, a.data());
+    for (auto _ : state)
+    {
+        BasicMatrix<float> matrix = dot(a, a);
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 2.0 * n * n * n, 12.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_Matrix_dot_float);
+
+// to_string()
+static void BM_Matrix_to_string(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a.to_string());
+    }
+    report(state, 0, 8.0 * n * n);
+}
+BENCHMARK(BM_Matrix_to_string)->RangeMultiplier(2)->Range(2, 512);
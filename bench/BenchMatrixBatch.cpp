@@ -0,0 +1,94 @@
+#include "tool.hpp"
+
+using namespace mla;
+
+// Batch sizes, with the matrix order as the second argument.
+#define MY_BENCHMARK_BATCH(function) BENCHMARK(function)->ArgsProduct({{1 << 10, 1 << 16}, {3, 4, 8}})
+
+static std::vector<Matrix> make_matrices(int size, int n)
+{
+    std::vector<Matrix> matrices;
+    for (int i = 0; i < size; i++)
+    {
+        Matrix matrix = make_matrix(n);
+        matrix[0][0] += i % 10;
+        matrices.push_back(matrix);
+    }
+    return matrices;
+}
+
+// dot(const MatrixBatch& a, const MatrixBatch& b)
+static void BM_MatrixBatch_dot(benchmark::State& state)
+{
+    const int size = int(state.range(0)), n = int(state.range(1));
+    MatrixBatch a(make_matrices(size, n));
+    for (auto _ : state)
+    {
+        MatrixBatch batch = dot(a, a);
+        benchmark::DoNotOptimize(batch.data());
+    }
+    report(state, 2.0 * size * n * n * n, 24.0 * size * n * n);
+}
+MY_BENCHMARK_BATCH(BM_MatrixBatch_dot);
+
+// dot(const Matrix& a, const Matrix& b) one by one, for comparison
+static void BM_MatrixBatch_dot_loop(benchmark::State& state)
+{
+    const int size = int(state.range(0)), n = int(state.range(1));
+    std::vector<Matrix> a = make_matrices(size, n);
+    for (auto _ : state)
+    {
+        for (const auto& matrix : a)
+        {
+            Matrix product = dot(matrix, matrix);
+            benchmark::DoNotOptimize(product.data());
+        }
+    }
+    report(state, 2.0 * size * n * n * n, 24.0 * size * n * n);
+}
+MY_BENCHMARK_BATCH(BM_MatrixBatch_dot_loop);
+
+// det()
+static void BM_MatrixBatch_det(benchmark::State& state)
+{
+    const int size = int(state.range(0)), n = int(state.range(1));
+    MatrixBatch a(make_matrices(size, n));
+    for (auto _ : state)
+    {
+        Vector det = a.det();
+        benchmark::DoNotOptimize(det.data());
+    }
+    report(state, 2.0 / 3 * size * n * n * n, 8.0 * size * n * n);
+}
+MY_BENCHMARK_BATCH(BM_MatrixBatch_det);
+
+// inv()
+static void BM_MatrixBatch_inv(benchmark::State& state)
+{
+    const int size = int(state.range(0)), n = int(state.range(1));
+    MatrixBatch a(make_matrices(size, n));
+    for (auto _ : state)
+    {
+        MatrixBatch batch = a.inv();
+        benchmark::DoNotOptimize(batch.data());
+    }
+    report(state, 2.0 * size * n * n * n, 16.0 * size * n * n);
+}
+MY_BENCHMARK_BATCH(BM_MatrixBatch_inv);
+
+// Matrix::inv() one by one, for comparison
+static void BM_MatrixBatch_inv_loop(benchmark::State& state)
+{
+    const int size = int(state.range(0)), n = int(state.range(1));
+    std::vector<Matrix> a = make_matrices(size, n);
+    for (auto _ : state)
+    {
+        for (const auto& matrix : a)
+        {
+            Matrix inverse = matrix.inv();
+            benchmark::DoNotOptimize(inverse.data());
+        }
+    }
+    report(state, 2.0 * size * n * n * n, 16.0 * size * n * n);
+}
+MY_BENCHMARK_BATCH(BM_MatrixBatch_inv_loop);
@@ -0,0 +1,56 @@
+#include "tool.hpp"
+
+#include <cstdio>
+#include <filesystem>
+
+using namespace mla;
+
+// Path of the file the benchmarks write and read.
+static std::string bench_path(int n)
+{
+    return (std::filesystem::temp_directory_path() / ("mla_bench_" + std::to_string(n) + ".mat")).string();
+}
+
+// save(const BasicMatrix<T>& matrix, const std::string& path)
+static void BM_MatrixFile_save(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        save(a, bench_path(n));
+    }
+    std::remove(bench_path(n).c_str());
+    report(state, 0, 8.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_MatrixFile_save);
+
+// load(const std::string& path)
+static void BM_MatrixFile_load(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    save(make_matrix(n), bench_path(n));
+    for (auto _ : state)
+    {
+        Matrix a = load(bench_path(n));
+        benchmark::DoNotOptimize(a.data());
+    }
+    std::remove(bench_path(n).c_str());
+    report(state, 0, 8.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_MatrixFile_load);
+
+// MappedMatrix(const std::string& path), the time to open, the elements are paged in on use
+static void BM_MatrixFile_map(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    save(make_matrix(n), bench_path(n));
+    for (auto _ : state)
+    {
+        MappedMatrix a(bench_path(n));
+        benchmark::DoNotOptimize(a.data());
+    }
+    std::remove(bench_path(n).c_str());
+    report(state, 0, 8.0 * n * n);
+}
+MY_BENCHMARK_MATRIX(BM_MatrixFile_map);
@@ -0,0 +1,72 @@
+#include "tool.hpp"
+
+#include <sstream>
+
+using namespace mla;
+
+// Orders of the matrices written and read as text.
+#define MY_BENCHMARK_TEXT(function) BENCHMARK(function)->RangeMultiplier(4)->Range(2, 512)
+
+// write_csv(std::ostream& os, const BasicMatrix<T>& matrix, char delimiter)
+static void BM_MatrixText_write_csv(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        std::ostringstream oss;
+        write_csv(oss, a);
+        benchmark::DoNotOptimize(oss.tellp());
+    }
+    report(state, 0, 8.0 * n * n);
+}
+MY_BENCHMARK_TEXT(BM_MatrixText_write_csv);
+
+// read_csv(std::istream& is, char delimiter)
+static void BM_MatrixText_read_csv(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    std::ostringstream oss;
+    write_csv(oss, Matrix(make_matrix(n) * 0.1));
+    const std::string text = oss.str();
+    for (auto _ : state)
+    {
+        std::istringstream iss(text);
+        Matrix a = read_csv(iss);
+        benchmark::DoNotOptimize(a.data());
+    }
+    report(state, 0, 8.0 * n * n);
+}
+MY_BENCHMARK_TEXT(BM_MatrixText_read_csv);
+
+// write_matrix_market(std::ostream& os, const BasicMatrix<T>& matrix)
+static void BM_MatrixText_write_matrix_market(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_matrix(n);
+    for (auto _ : state)
+    {
+        std::ostringstream oss;
+        write_matrix_market(oss, a);
+        benchmark::DoNotOptimize(oss.tellp());
+    }
+    report(state, 0, 8.0 * n * n);
+}
+MY_BENCHMARK_TEXT(BM_MatrixText_write_matrix_market);
+
+// read_matrix_market(std::istream& is)
+static void BM_MatrixText_read_matrix_market(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    std::ostringstream oss;
+    write_matrix_market(oss, Matrix(make_matrix(n) * 0.1));
+    const std::string text = oss.str();
+    for (auto _ : state)
+    {
+        std::istringstream iss(text);
+        Matrix a = read_matrix_market(iss);
+        benchmark::DoNotOptimize(a.data());
+    }
+    report(state, 0, 8.0 * n * n);
+}
+MY_BENCHMARK_TEXT(BM_MatrixText_read_matrix_market);
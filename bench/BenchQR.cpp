@@ -0,0 +1,49 @@
+#include "tool.hpp"
+
+using namespace mla;
+
+// Tall 4n x n matrix with full column rank.
+static Matrix make_tall(int n)
+{
+    Matrix a(4 * n, n, 0);
+    for (int r = 0; r < 4 * n; r++)
+    {
+        for (int c = 0; c < n; c++)
+        {
+            a[r][c] = r == c ? n : (r * 7 + c * 3) % 11 - 5;
+        }
+    }
+    return a;
+}
+
+// Orders of the tall matrices, n columns and 4n rows.
+#define MY_BENCHMARK_TALL(function) BENCHMARK(function)->RangeMultiplier(2)->Range(2, 1024)
+
+// QR()
+static void BM_QR_factorize(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_tall(n);
+    for (auto _ : state)
+    {
+        QR qr = a.qr();
+        benchmark::DoNotOptimize(qr.factors().data());
+    }
+    report(state, 2.0 * 4 * n * n * n - 2.0 / 3 * n * n * n, 16.0 * 4 * n * n);
+}
+MY_BENCHMARK_TALL(BM_QR_factorize);
+
+// lstsq(ConstMatrixView a, const Vector& b)
+static void BM_QR_lstsq(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Matrix a = make_tall(n);
+    Vector b = make_vector(4 * n);
+    for (auto _ : state)
+    {
+        Vector x = lstsq(a, b);
+        benchmark::DoNotOptimize(x.data());
+    }
+    report(state, 2.0 * 4 * n * n * n - 2.0 / 3 * n * n * n, 16.0 * 4 * n * n);
+}
+MY_BENCHMARK_TALL(BM_QR_lstsq);
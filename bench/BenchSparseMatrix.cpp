@@ -0,0 +1,64 @@
+#include "tool.hpp"
+
+#include <cstdint> // std::int64_t
+
+using namespace mla;
+
+// n x n matrix with about 8 nonzeros per row.
+static SparseMatrix make_sparse(int n)
+{
+    std::vector<Triplet> triplets;
+    triplets.reserve(std::size_t(n) * 8);
+    for (int i = 0; i < n; i++)
+    {
+        triplets.push_back({i, i, 8});
+        for (int k = 1; k < 8; k++)
+        {
+            triplets.push_back({i, int((std::int64_t(i) * 7919 + k * 104729) % n), -1});
+        }
+    }
+    return SparseMatrix(n, n, triplets);
+}
+
+// SparseMatrix(int rows, int cols, const std::vector<Triplet>& triplets)
+static void BM_SparseMatrix_build(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    for (auto _ : state)
+    {
+        SparseMatrix matrix = make_sparse(n);
+        benchmark::DoNotOptimize(matrix.values().data());
+    }
+    report(state, 0, 8.0 * 16 * n);
+}
+BENCHMARK(BM_SparseMatrix_build)->RangeMultiplier(8)->Range(8, 1 << 21);
+
+// dot(const SparseMatrix& a, const Vector& x)
+static void BM_SparseMatrix_dot_vector(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    SparseMatrix a = make_sparse(n);
+    Vector x = make_vector(n);
+    for (auto _ : state)
+    {
+        Vector vector = dot(a, x);
+        benchmark::DoNotOptimize(vector.data());
+    }
+    report(state, 2.0 * a.nonzero_size(), 12.0 * a.nonzero_size() + 24.0 * n);
+}
+BENCHMARK(BM_SparseMatrix_dot_vector)->RangeMultiplier(8)->Range(8, 1 << 21);
+
+// dot(const SparseMatrix& a, ConstMatrixView b)
+static void BM_SparseMatrix_dot_matrix(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    SparseMatrix a = make_sparse(n);
+    Matrix b(n, 32, 1);
+    for (auto _ : state)
+    {
+        Matrix matrix = dot(a, b);
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    report(state, 2.0 * 32 * a.nonzero_size(), 12.0 * a.nonzero_size() + 16.0 * 32 * n);
+}
+BENCHMARK(BM_SparseMatrix_dot_matrix)->RangeMultiplier(8)->Range(8, 1 << 18);
@@ -0,0 +1,44 @@
+#include "tool.hpp"
+
+using namespace mla;
+
+// dot() of many 3D vectors
+static void BM_Vec_dot(benchmark::State& state)
+{
+    Vec3 a = {1, 2, 3}, b = {4, 5, 6};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(dot(a, b));
+    }
+    report(state, 6, 48);
+}
+BENCHMARK(BM_Vec_dot);
+
+// cross() of many 3D vectors
+static void BM_Vec_cross(benchmark::State& state)
+{
+    Vec3 a = {1, 2, 3}, b = {4, 5, 6};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Vec3 vec = cross(a, b);
+        benchmark::DoNotOptimize(vec);
+    }
+    report(state, 9, 72);
+}
+BENCHMARK(BM_Vec_cross);
+
+// a + b * 2 - c
+static void BM_Vec_arithmetic(benchmark::State& state)
+{
+    Vec4 a = {1, 2, 3, 4}, b = {5, 6, 7, 8}, c = {9, 10, 11, 12};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Vec4 vec = a + b * 2 - c;
+        benchmark::DoNotOptimize(vec);
+    }
+    report(state, 12, 128);
+}
+BENCHMARK(BM_Vec_arithmetic);
@@ -0,0 +1,336 @@
+#include "tool.hpp"
+
+using namespace mla;
+
+// Vector(int n, double element)
+static void BM_Vector_construct(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    for (auto _ : state)
+    {
+        Vector vector(n, 1);
+        benchmark::DoNotOptimize(vector.data());
+    }
+    report(state, 0, 8.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_construct);
+
+// Vector(const Vector& that)
+static void BM_Vector_copy(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Vector a = make_vector(n);
+    for (auto _ : state)
+    {
+        Vector vector = a;
+        benchmark::DoNotOptimize(vector.data());
+    }
+    report(state, 0, 16.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_copy);
+
+// operator==()
+static void BM_Vector_compare(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Vector a = make_vector(n), b = make_vector(n);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a == b);
+    }
+    report(state, 0, 16.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_compare);
+
+// operator[]()
+static void BM_Vector_access(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    const Vector a = make_vector(n);
+    for (auto _ : state)
+    {
+        double sum = 0;
+        for (int i = 0; i < n; i++)
+        {
+            sum += a[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    report(state, n, 8.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_access);
+
+// length()
+static void BM_Vector_length(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Vector a = make_vector(n);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a.length());
+    }
+    report(state, 2.0 * n, 8.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_length);
+
+// count_leading_zeros()
+static void BM_Vector_count_leading_zeros(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Vector a(n, 0);
+    a[n - 1] = 1;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a.count_leading_zeros());
+    }
+    report(state, 0, 8.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_count_leading_zeros);
+
+// is_zero()
+static void BM_Vector_is_zero(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Vector a(n, 0);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a.is_zero());
+    }
+    report(state, 0, 8.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_is_zero);
+
+// append(const Vector& vector)
+static void BM_Vector_append(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Vector a = make_vector(n);
+    for (auto _ : state)
+    {
+        Vector vector;
+        vector.append(a).append(a).append(1);
+        benchmark::DoNotOptimize(vector.data());
+    }
+    report(state, 0, 32.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_append);
+
+// unitize()
+static void BM_Vector_unitize(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Vector a = make_vector(n);
+    for (auto _ : state)
+    {
+        a.unitize();
+        benchmark::ClobberMemory();
+    }
+    report(state, 3.0 * n, 24.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_unitize);
+
+// operator+=() operator-=() operator*=()
+template <typename Action>
+static void run_in_place(benchmark::State& state, Action action, double flops)
+{
+    const int n = int(state.range(0));
+    Vector a = make_vector(n), b(n, 1);
+    for (auto _ : state)
+    {
+        action(a, b);
+        benchmark::ClobberMemory();
+    }
+    report(state, flops * n, 24.0 * n);
+}
+
+static void BM_Vector_add_assign(benchmark::State& state)
+{
+    run_in_place(state, [](Vector& a, const Vector& b)
+                 { a += b; }, 1);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_add_assign);
+
+static void BM_Vector_sub_assign(benchmark::State& state)
+{
+    run_in_place(state, [](Vector& a, const Vector& b)
+                 { a -= b; }, 1);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_sub_assign);
+
+static void BM_Vector_mul_assign(benchmark::State& state)
+{
+    run_in_place(state, [](Vector& a, const Vector& b)
+                 { a *= b; }, 1);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_mul_assign);
+
+static void BM_Vector_scale_assign(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Vector a = make_vector(n);
+    for (auto _ : state)
+    {
+        a *= 1.0;
+        benchmark::ClobberMemory();
+    }
+    report(state, n, 16.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_scale_assign);
+
+// operator+() operator-() operator*()
+template <typename Action>
+static void run_binary(benchmark::State& state, Action action)
+{
+    const int n = int(state.range(0));
+    Vector a = make_vector(n), b = make_vector(n);
+    for (auto _ : state)
+    {
+        Vector vector = action(a, b);
+        benchmark::DoNotOptimize(vector.data());
+    }
+    report(state, n, 24.0 * n);
+}
+
+static void BM_Vector_add(benchmark::State& state)
+{
+    run_binary(state, [](const Vector& a, const Vector& b)
+               { return Vector(a + b); });
+}
+MY_BENCHMARK_VECTOR(BM_Vector_add);
+
+static void BM_Vector_sub(benchmark::State& state)
+{
+    run_binary(state, [](const Vector& a, const Vector& b)
+               { return Vector(a - b); });
+}
+MY_BENCHMARK_VECTOR(BM_Vector_sub);
+
+static void BM_Vector_mul(benchmark::State& state)
+{
+    run_binary(state, [](const Vector& a, const Vector& b)
+               { return Vector(a * b); });
+}
+MY_BENCHMARK_VECTOR(BM_Vector_mul);
+
+static void BM_Vector_scale(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Vector a = make_vector(n);
+    for (auto _ : state)
+    {
+        Vector vector = a * 2.0;
+        benchmark::DoNotOptimize(vector.data());
+    }
+    report(state, n, 16.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_scale);
+
+// a + b * 2 - c * d, evaluated in a single pass through lazy()
+static void BM_Vector_expression(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Vector a = make_vector(n), b = make_vector(n), c = make_vector(n), d = make_vector(n);
+    for (auto _ : state)
+    {
+        Vector vector = lazy(a) + lazy(b) * 2 - lazy(c) * lazy(d);
+        benchmark::DoNotOptimize(vector.data());
+    }
+    report(state, 4.0 * n, 40.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_expression);
+
+// dot()
+static void BM_Vector_dot(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Vector a = make_vector(n), b = make_vector(n);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(dot(a, b));
+    }
+    report(state, 2.0 * n, 16.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_dot);
+
+// dot() on float, twice the elements per instruction and half the bytes
+static void BM_Vector_dot_float(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    BasicVector<float> a(n, 0), b(n, 0);
+    for (int i = 0; i < n; i++)
+    {
+        a[i] = b[i] = float(i % 7 + 1);
+    }
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(dot(a, b));
+    }
+    report(state, 2.0 * n, 8.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_dot_float);
+
+// is_orthogonal()
+static void BM_Vector_is_orthogonal(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Vector a = make_vector(n), b = make_vector(n);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(is_orthogonal(a, b));
+    }
+    report(state, 2.0 * n, 16.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_is_orthogonal);
+
+// is_parallel()
+static void BM_Vector_is_parallel(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Vector a = make_vector(n), b = make_vector(n);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(is_parallel(a, b));
+    }
+    report(state, 6.0 * n, 48.0 * n);
+}
+MY_BENCHMARK_VECTOR(BM_Vector_is_parallel);
+
+// cross(), only defined for three dimensional vectors
+static void BM_Vector_cross(benchmark::State& state)
+{
+    Vector a = {1, 2, 3}, b = {4, 5, 6};
+    for (auto _ : state)
+    {
+        Vector vector = cross(a, b);
+        benchmark::DoNotOptimize(vector.data());
+    }
+    report(state, 9, 72);
+}
+BENCHMARK(BM_Vector_cross);
+
+// cross() with the temporaries taken from the pool of the thread instead of the global heap
+static void BM_Vector_cross_pool(benchmark::State& state)
+{
+    MemoryResourceScope scope(thread_pool_resource());
+    Vector a = {1, 2, 3}, b = {4, 5, 6};
+    for (auto _ : state)
+    {
+        Vector vector = cross(a, b);
+        benchmark::DoNotOptimize(vector.data());
+    }
+    report(state, 9, 72);
+}
+BENCHMARK(BM_Vector_cross_pool);
+
+// to_string()
+static void BM_Vector_to_string(benchmark::State& state)
+{
+    const int n = int(state.range(0));
+    Vector a = make_vector(n);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a.to_string());
+    }
+    report(state, 0, 8.0 * n);
+}
+BENCHMARK(BM_Vector_to_string)->RangeMultiplier(8)->Range(2, 1 << 18);
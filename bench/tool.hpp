@@ -0,0 +1,47 @@
+#ifndef TOOL_HPP
+#define TOOL_HPP
+
+#include <benchmark/benchmark.h>
+
+#include "../sources/mla.h"
+
+// Vector lengths, up to as many elements as the largest matrix.
+#define MY_BENCHMARK_VECTOR(function) BENCHMARK(function)->RangeMultiplier(8)->Range(2, 4096 * 4096)
+
+// Orders of square matrices.
+#define MY_BENCHMARK_MATRIX(function) BENCHMARK(function)->RangeMultiplier(2)->Range(2, 4096)
+
+// Report the work done by one iteration as floating-point and memory throughput, GFLOP/s and GB/s.
+inline void report(benchmark::State& state, double flops, double bytes)
+{
+    state.counters["GFLOP"] = benchmark::Counter(flops * 1e-9, benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["GB"] = benchmark::Counter(bytes * 1e-9, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Vector of n elements, none of them zero.
+inline mla::Vector make_vector(int n)
+{
+    mla::Vector vector(n, 0);
+    for (int i = 0; i < n; i++)
+    {
+        vector[i] = i % 7 + 1;
+    }
+    return vector;
+}
+
+// Square matrix of order n, diagonally dominant so that it is well conditioned.
+inline mla::Matrix make_matrix(int n)
+{
+    mla::Matrix matrix(n, n, 0);
+    double* data = matrix.data();
+    for (int r = 0; r < n; r++)
+    {
+        for (int c = 0; c < n; c++)
+        {
+            data[r * n + c] = r == c ? n : (r * 7 + c * 3) % 11 - 5;
+        }
+    }
+    return matrix;
+}
+
+#endif // TOOL_HPP
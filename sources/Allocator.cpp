@@ -0,0 +1,169 @@
+#include "Allocator.h"
+
+#include <algorithm> // std::max
+#include <cstdint>   // std::uintptr_t
+#include <cstdlib>   // std::malloc std::free
+#include <new>       // std::bad_alloc placement new
+
+namespace mla
+{
+
+/*
+ * Aligned blocks carved from malloc: the block is over-allocated by ALIGNMENT bytes and the pointer
+ * returned by malloc is kept just before the aligned address. Aligned operator new goes through
+ * memalign, which costs several times a malloc and dominates the construction of small vectors.
+ */
+class AlignedResource : public std::pmr::memory_resource
+{
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        alignment = std::max(alignment, ALIGNMENT);
+        void* raw = std::malloc(bytes + alignment);
+        if (raw == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        // malloc aligns to at least 16 bytes, so there is always room for the pointer before the block
+        void* block = reinterpret_cast<void*>((reinterpret_cast<std::uintptr_t>(raw) + alignment) & ~std::uintptr_t(alignment - 1));
+        static_cast<void**>(block)[-1] = raw;
+        return block;
+    }
+
+    void do_deallocate(void* p, std::size_t, std::size_t) override
+    {
+        std::free(static_cast<void**>(p)[-1]);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& that) const noexcept override
+    {
+        return this == &that;
+    }
+};
+
+/*
+ * Free lists of blocks per size class, a whole multiple of ALIGNMENT up to MAX_BYTES. A freed block is pushed
+ * onto the list of its class and handed out again by the next allocation of that class, so the temporaries
+ * of a loop take no lock and never reach malloc after the first iteration. Larger blocks go upstream.
+ */
+class ThreadPoolResource : public std::pmr::memory_resource
+{
+private:
+    static constexpr std::size_t MAX_BYTES = 64 * ALIGNMENT;
+
+    // Freed block, linked through its first bytes.
+    struct Block
+    {
+        Block* next;
+    };
+
+    // Resource the blocks come from.
+    std::pmr::memory_resource* upstream_;
+
+    // Free blocks of ALIGNMENT * (i + 1) bytes.
+    Block* free_[MAX_BYTES / ALIGNMENT] = {};
+
+    static bool pooled(std::size_t bytes, std::size_t alignment)
+    {
+        return bytes != 0 && bytes <= MAX_BYTES && alignment <= ALIGNMENT;
+    }
+
+    static std::size_t size_class(std::size_t bytes)
+    {
+        return (bytes - 1) / ALIGNMENT;
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if (!pooled(bytes, alignment))
+        {
+            return upstream_->allocate(bytes, alignment);
+        }
+
+        const std::size_t i = size_class(bytes);
+        if (Block* block = free_[i])
+        {
+            free_[i] = block->next;
+            return block;
+        }
+        return upstream_->allocate((i + 1) * ALIGNMENT, ALIGNMENT);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        if (!pooled(bytes, alignment))
+        {
+            upstream_->deallocate(p, bytes, alignment);
+            return;
+        }
+
+        const std::size_t i = size_class(bytes);
+        free_[i] = new (p) Block{free_[i]};
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& that) const noexcept override
+    {
+        return this == &that;
+    }
+
+public:
+    explicit ThreadPoolResource(std::pmr::memory_resource* upstream)
+        : upstream_(upstream)
+    {
+    }
+
+    ThreadPoolResource(const ThreadPoolResource&) = delete;
+
+    ThreadPoolResource& operator=(const ThreadPoolResource&) = delete;
+
+    ~ThreadPoolResource()
+    {
+        for (std::size_t i = 0; i < MAX_BYTES / ALIGNMENT; i++)
+        {
+            while (Block* block = free_[i])
+            {
+                free_[i] = block->next;
+                upstream_->deallocate(block, (i + 1) * ALIGNMENT, ALIGNMENT);
+            }
+        }
+    }
+};
+
+// Resource of the vectors and matrices constructed by this thread, nullptr for the default one.
+static thread_local std::pmr::memory_resource* current_resource = nullptr;
+
+std::pmr::memory_resource* default_memory_resource()
+{
+    static AlignedResource resource;
+    return &resource;
+}
+
+std::pmr::memory_resource* thread_pool_resource()
+{
+    static thread_local ThreadPoolResource pool(default_memory_resource());
+    return &pool;
+}
+
+std::pmr::memory_resource* memory_resource()
+{
+    return current_resource == nullptr ? default_memory_resource() : current_resource;
+}
+
+void set_memory_resource(std::pmr::memory_resource* resource)
+{
+    current_resource = resource;
+}
+
+MemoryResourceScope::MemoryResourceScope(std::pmr::memory_resource* resource)
+    : previous_(current_resource)
+{
+    current_resource = resource;
+}
+
+MemoryResourceScope::~MemoryResourceScope()
+{
+    current_resource = previous_;
+}
+
+} // namespace mla
@@ -0,0 +1,163 @@
+/**
+ * @file Allocator.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief Aligned allocator backed by a pluggable memory resource.
+ * @version 1.0
+ * @date 2026.10.17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <cstddef>         // std::size_t
+#include <memory_resource> // std::pmr::memory_resource
+
+namespace mla
+{
+
+// Alignment of the element storage of vectors and matrices, the width of an AVX-512 register and of a cache line.
+constexpr std::size_t ALIGNMENT = 64;
+
+/**
+ * @brief Return the default memory resource, ALIGNMENT aligned blocks from malloc and free.
+ *
+ * @return the default memory resource
+ */
+std::pmr::memory_resource* default_memory_resource();
+
+/**
+ * @brief Return a pool of the calling thread, which keeps freed blocks for reuse without locking.
+ *
+ * Memory taken from it must be freed by the same thread, before the thread exits.
+ *
+ * @return the pool of the calling thread
+ */
+std::pmr::memory_resource* thread_pool_resource();
+
+/**
+ * @brief Return the memory resource of the calling thread, used by the vectors and matrices it constructs.
+ *
+ * @return the memory resource of the calling thread
+ */
+std::pmr::memory_resource* memory_resource();
+
+/**
+ * @brief Set the memory resource of the calling thread, used by the vectors and matrices it constructs.
+ *
+ * A vector or matrix keeps the resource it was constructed with and must not outlive it.
+ * Moving one into an object built with another resource copies the elements.
+ *
+ * @param resource a memory resource, nullptr for the default one
+ */
+void set_memory_resource(std::pmr::memory_resource* resource);
+
+/**
+ * @brief Use a memory resource on the calling thread until the end of the scope, such as an arena for the temporaries of a loop.
+ */
+class MemoryResourceScope
+{
+private:
+    // Resource of the thread before the scope.
+    std::pmr::memory_resource* previous_;
+
+public:
+    /**
+     * @brief Set the memory resource of the calling thread.
+     *
+     * @param resource a memory resource, nullptr for the default one
+     */
+    explicit MemoryResourceScope(std::pmr::memory_resource* resource);
+
+    MemoryResourceScope(const MemoryResourceScope&) = delete;
+
+    MemoryResourceScope& operator=(const MemoryResourceScope&) = delete;
+
+    /**
+     * @brief Restore the memory resource of the thread before the scope.
+     */
+    ~MemoryResourceScope();
+};
+
+/**
+ * @brief Allocator of ALIGNMENT aligned storage, taken from the memory resource of the constructing thread.
+ *
+ * Like std::pmr::polymorphic_allocator it is not propagated on assignment or swap, so a container keeps
+ * its resource for its whole lifetime.
+ *
+ * @tparam T element type
+ */
+template <typename T>
+class Allocator
+{
+    template <typename U>
+    friend class Allocator;
+
+private:
+    // Resource the storage comes from.
+    std::pmr::memory_resource* resource_;
+
+public:
+    using value_type = T;
+
+    Allocator() noexcept
+        : resource_(memory_resource())
+    {
+    }
+
+    Allocator(std::pmr::memory_resource* resource) noexcept
+        : resource_(resource == nullptr ? default_memory_resource() : resource)
+    {
+    }
+
+    template <typename U>
+    Allocator(const Allocator<U>& that) noexcept
+        : resource_(that.resource_)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(resource_->allocate(bytes(n), ALIGNMENT));
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        resource_->deallocate(p, bytes(n), ALIGNMENT);
+    }
+
+    // A copy takes its storage from the resource of the thread that makes it.
+    Allocator select_on_container_copy_construction() const
+    {
+        return Allocator();
+    }
+
+    std::pmr::memory_resource* resource() const
+    {
+        return resource_;
+    }
+
+    template <typename U>
+    bool operator==(const Allocator<U>& that) const noexcept
+    {
+        return resource_ == that.resource_ || resource_->is_equal(*that.resource_);
+    }
+
+    template <typename U>
+    bool operator!=(const Allocator<U>& that) const noexcept
+    {
+        return !(*this == that);
+    }
+
+private:
+    // Whole multiples of the alignment, which pool resources need to return aligned blocks.
+    static std::size_t bytes(std::size_t n)
+    {
+        return (n * sizeof(T) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+};
+
+} // namespace mla
+
+#endif // ALLOCATOR_H
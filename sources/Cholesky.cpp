@@ -0,0 +1,250 @@
+#include "Cholesky.h"
+
+#include "gemm.h"
+#include "parallel.h"
+#include "simd.h"
+#include "utility.hpp"
+
+#include <algorithm> // std::fill std::max std::min
+#include <cmath>     // std::abs std::log std::sqrt
+#include <limits>    // std::numeric_limits
+
+namespace mla
+{
+
+// Order of the diagonal blocks, the panel below a block is solved against it row by row.
+static constexpr int NB = 128;
+
+// Number of columns of the trailing matrix updated by one product, only the lower block triangle is updated.
+static constexpr int STRIP = 256;
+
+// Sum of x[i] * y[i] for 0 <= i < n, inlined for the short rows inside a block.
+// Four partial sums hide the latency of the additions.
+static inline double dot(int n, const double* x, const double* y)
+{
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        s0 += x[i] * y[i];
+        s1 += x[i + 1] * y[i + 1];
+        s2 += x[i + 2] * y[i + 2];
+        s3 += x[i + 3] * y[i + 3];
+    }
+    for (; i < n; i++)
+    {
+        s0 += x[i] * y[i];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+static void throw_not_spd()
+{
+    throw std::runtime_error("Error: Not a symmetric positive definite matrix.");
+}
+
+Cholesky::Cholesky(ConstMatrixView matrix)
+    : factor_(matrix)
+{
+    // check square matrix
+    utility::check_size(matrix.row_size(), matrix.col_size());
+
+    const int n = size();
+    double* a = factor_.data();
+
+    // only the lower triangle is read, so the upper one has to mirror it within rounding error
+    double max = 0;
+    for (int i = 0; i < n * n; i++)
+    {
+        max = std::max(max, std::abs(a[i]));
+    }
+    const double tolerance = n * std::numeric_limits<double>::epsilon() * max;
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < i; j++)
+        {
+            if (std::abs(a[std::ptrdiff_t(i) * n + j] - a[std::ptrdiff_t(j) * n + i]) > tolerance)
+            {
+                throw_not_spd();
+            }
+        }
+    }
+
+    std::vector<double> panel; // -A21^T of the current block column
+    for (int k = 0; k < n; k += NB)
+    {
+        const int nb = std::min(NB, n - k);
+
+        // diagonal block, the columns left of the block are already eliminated by the trailing updates
+        for (int i = k; i < k + nb; i++)
+        {
+            double* row_i = a + std::ptrdiff_t(i) * n;
+            for (int j = k; j < i; j++)
+            {
+                const double* row_j = a + std::ptrdiff_t(j) * n;
+                row_i[j] = (row_i[j] - dot(j - k, row_i + k, row_j + k)) / row_j[j];
+            }
+            const double d = row_i[i] - dot(i - k, row_i + k, row_i + k);
+            if (!(d > 0)) // also rejects NaN
+            {
+                throw_not_spd();
+            }
+            row_i[i] = std::sqrt(d);
+        }
+
+        // panel below the diagonal block: L21 = A21 L11^-T, the rows are independent
+        kernel::parallel_for(k + nb, n, std::max(1, kernel::PARALLEL_GRAIN / (nb * nb)), [=](int begin, int end)
+                             {
+            for (int i = begin; i < end; i++)
+            {
+                double* row_i = a + std::ptrdiff_t(i) * n;
+                for (int j = k; j < k + nb; j++)
+                {
+                    const double* row_j = a + std::ptrdiff_t(j) * n;
+                    row_i[j] = (row_i[j] - dot(j - k, row_i + k, row_j + k)) / row_j[j];
+                }
+            } });
+
+        // trailing update A22 -= L21 L21^T as products of strips of the lower block triangle
+        const int m = n - k - nb;
+        if (m == 0)
+        {
+            break;
+        }
+        panel.resize(std::size_t(nb) * m);
+        for (int i = 0; i < m; i++)
+        {
+            const double* row_i = a + std::ptrdiff_t(k + nb + i) * n + k;
+            for (int t = 0; t < nb; t++)
+            {
+                panel[std::size_t(t) * m + i] = -row_i[t];
+            }
+        }
+        for (int j = 0; j < m; j += STRIP)
+        {
+            const int w = std::min(STRIP, m - j);
+            double* c = a + std::ptrdiff_t(k + nb + j) * n + k + nb + j;
+            kernel::gemm(m - j, w, nb, a + std::ptrdiff_t(k + nb + j) * n + k, n, panel.data() + j, m, c, n);
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        std::fill(a + std::ptrdiff_t(i) * n + i + 1, a + std::ptrdiff_t(i + 1) * n, 0);
+    }
+}
+
+int Cholesky::size() const
+{
+    return factor_.row_size();
+}
+
+const Matrix& Cholesky::factor() const
+{
+    return factor_;
+}
+
+double Cholesky::logdet() const
+{
+    const int n = size();
+    const double* a = factor_.data();
+    double sum = 0;
+    for (int i = 0; i < n; i++)
+    {
+        sum += std::log(a[std::ptrdiff_t(i) * n + i]);
+    }
+    return 2 * sum;
+}
+
+Vector Cholesky::solve(const Vector& b) const
+{
+    utility::check_size(size(), b.size());
+
+    const int n = size();
+    const double* a = factor_.data();
+    Vector x = b;
+    double* xd = x.data();
+
+    // forward substitution with L
+    for (int i = 0; i < n; i++)
+    {
+        const double* row = a + std::ptrdiff_t(i) * n;
+        xd[i] = (xd[i] - kernel::dot(i, row, xd)) / row[i];
+    }
+
+    // back substitution with L^T, sweeping the rows of L
+    for (int i = n - 1; i >= 0; i--)
+    {
+        const double* row = a + std::ptrdiff_t(i) * n;
+        xd[i] /= row[i];
+        const double xi = xd[i];
+        for (int j = 0; j < i; j++)
+        {
+            xd[j] -= row[j] * xi;
+        }
+    }
+
+    return x;
+}
+
+Matrix Cholesky::solve(const Matrix& b) const
+{
+    utility::check_size(size(), b.row_size());
+
+    const int n = size();
+    const int m = b.col_size();
+    const double* a = factor_.data();
+    Matrix x = b;
+    double* xd = x.data();
+
+    // the columns of X are independent, each chunk sweeps its own columns row by row
+    const int grain = std::max(1, kernel::PARALLEL_GRAIN / std::max(1, n * n));
+    kernel::parallel_for(0, m, grain, [=](int begin, int end)
+                         {
+        // forward substitution with L
+        for (int i = 0; i < n; i++)
+        {
+            const double* l = a + std::ptrdiff_t(i) * n;
+            double* row_i = xd + std::ptrdiff_t(i) * m;
+            for (int j = 0; j < i; j++)
+            {
+                const double* row_j = xd + std::ptrdiff_t(j) * m;
+                for (int c = begin; c < end; c++)
+                {
+                    row_i[c] -= l[j] * row_j[c];
+                }
+            }
+            for (int c = begin; c < end; c++)
+            {
+                row_i[c] /= l[i];
+            }
+        }
+
+        // back substitution with L^T, sweeping the rows of L
+        for (int i = n - 1; i >= 0; i--)
+        {
+            const double* l = a + std::ptrdiff_t(i) * n;
+            double* row_i = xd + std::ptrdiff_t(i) * m;
+            for (int c = begin; c < end; c++)
+            {
+                row_i[c] /= l[i];
+            }
+            for (int j = 0; j < i; j++)
+            {
+                double* row_j = xd + std::ptrdiff_t(j) * m;
+                for (int c = begin; c < end; c++)
+                {
+                    row_j[c] -= l[j] * row_i[c];
+                }
+            }
+        } });
+
+    return x;
+}
+
+Matrix Cholesky::inverse() const
+{
+    return solve(Matrix::eye(size()));
+}
+
+} // namespace mla
@@ -0,0 +1,103 @@
+/**
+ * @file Cholesky.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief Cholesky factorization class.
+ * @version 1.0
+ * @date 2026.10.16
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef CHOLESKY_H
+#define CHOLESKY_H
+
+#include "Matrix.h"
+#include "MatrixView.h"
+
+namespace mla
+{
+
+/**
+ * @brief Cholesky factorization of a symmetric positive definite matrix, A = LL^T.
+ *
+ * Takes about half the work of LU and needs no pivoting. The matrix is factorized once,
+ * then the log determinant, the inverse and any number of linear systems are computed from L.
+ */
+class Cholesky
+{
+private:
+    // L (lower triangle), the upper triangle is zero.
+    Matrix factor_;
+
+public:
+    /*
+     * Constructor / Destructor
+     */
+
+    /**
+     * @brief Factorize a symmetric positive definite matrix.
+     *
+     * Throws if the matrix is not symmetric (within rounding error) or not positive definite.
+     *
+     * @param matrix a symmetric positive definite matrix or view
+     */
+    explicit Cholesky(ConstMatrixView matrix);
+
+    /*
+     * Examination (will not change the object itself)
+     */
+
+    /**
+     * @brief Return the order of the factorized matrix.
+     *
+     * @return the order of the factorized matrix
+     */
+    int size() const;
+
+    /**
+     * @brief Return the lower triangular factor L.
+     *
+     * @return the lower triangular factor L
+     */
+    const Matrix& factor() const;
+
+    /**
+     * @brief Compute the natural logarithm of the determinant of the factorized matrix.
+     *
+     * Does not overflow or underflow where det() of a large matrix would.
+     *
+     * @return the natural logarithm of the determinant
+     */
+    double logdet() const;
+
+    /*
+     * Production (will produce new object)
+     */
+
+    /**
+     * @brief Solve the linear system Ax = b.
+     *
+     * @param b a vector of the same size as the matrix order
+     * @return the solution x
+     */
+    Vector solve(const Vector& b) const;
+
+    /**
+     * @brief Solve the linear systems AX = B, one for each column of B.
+     *
+     * @param b a matrix with as many rows as the matrix order
+     * @return the solution X
+     */
+    Matrix solve(const Matrix& b) const;
+
+    /**
+     * @brief Compute the inverse of the factorized matrix.
+     *
+     * @return the inverse of the factorized matrix
+     */
+    Matrix inverse() const;
+};
+
+} // namespace mla
+
+#endif // CHOLESKY_H
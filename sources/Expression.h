@@ -0,0 +1,377 @@
+/**
+ * @file Expression.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief Lazily evaluated element-wise expressions.
+ * @version 1.0
+ * @date 2026.10.16
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <cstddef>     // std::ptrdiff_t
+#include <type_traits> // std::decay_t std::remove_const_t
+#include <utility>     // std::declval
+
+#include "parallel.h"
+
+namespace mla
+{
+
+template <typename T>
+class BasicVector;
+
+template <typename T>
+class BasicVectorView;
+
+template <typename T>
+class BasicMatrix;
+
+template <typename T>
+class BasicMatrixView;
+
+namespace expr
+{
+
+/*
+ * Nodes of an expression tree. Every node returns its element at a flat index, without bounds checking,
+ * and tells whether it reads elements of [begin, end) at other indices than its own, in which case writing
+ * the result into that range while evaluating would overwrite elements before they are read.
+ */
+
+// Element-wise addition.
+struct Add
+{
+    template <typename T>
+    static T apply(const T& a, const T& b)
+    {
+        return a + b;
+    }
+};
+
+// Element-wise difference.
+struct Sub
+{
+    template <typename T>
+    static T apply(const T& a, const T& b)
+    {
+        return a - b;
+    }
+};
+
+// Element-wise (Hadamard) product.
+struct Mul
+{
+    template <typename T>
+    static T apply(const T& a, const T& b)
+    {
+        return a * b;
+    }
+};
+
+// Reference to the elements of a vector or a matrix.
+template <typename T>
+class Leaf
+{
+private:
+    const T* data_;
+    int size_;
+
+public:
+    Leaf(const T* data, int size)
+        : data_(data)
+        , size_(size)
+    {
+    }
+
+    T operator[](int index) const
+    {
+        return data_[index];
+    }
+
+    bool overlaps(const T* begin, const T* end) const
+    {
+        return data_ != begin && data_ < end && begin < data_ + size_;
+    }
+};
+
+// Reference to the elements of a matrix view, whose rows are stride elements apart.
+template <typename T>
+class Strided
+{
+private:
+    const T* data_;
+    int rows_;
+    int cols_;
+    int stride_;
+
+public:
+    Strided(const T* data, int rows, int cols, int stride)
+        : data_(data)
+        , rows_(rows)
+        , cols_(cols)
+        , stride_(stride)
+    {
+    }
+
+    T operator[](int index) const
+    {
+        // a view of whole rows is contiguous and needs no division
+        return stride_ == cols_ ? data_[index] : data_[std::ptrdiff_t(index / cols_) * stride_ + index % cols_];
+    }
+
+    bool overlaps(const T* begin, const T* end) const
+    {
+        if (rows_ == 0 || cols_ == 0 || (stride_ == cols_ && data_ == begin))
+        {
+            return false;
+        }
+        return data_ < end && begin < data_ + std::ptrdiff_t(rows_ - 1) * stride_ + cols_;
+    }
+};
+
+// Element-wise binary operation of two nodes.
+template <typename L, typename R, typename Op>
+class Binary
+{
+private:
+    L left_;
+    R right_;
+
+public:
+    Binary(const L& left, const R& right)
+        : left_(left)
+        , right_(right)
+    {
+    }
+
+    auto operator[](int index) const
+    {
+        return Op::apply(left_[index], right_[index]);
+    }
+
+    template <typename T>
+    bool overlaps(const T* begin, const T* end) const
+    {
+        return left_.overlaps(begin, end) || right_.overlaps(begin, end);
+    }
+};
+
+// Node multiplied by a scalar.
+template <typename E, typename T>
+class Scale
+{
+private:
+    E node_;
+    T c_;
+
+public:
+    Scale(const E& node, const T& c)
+        : node_(node)
+        , c_(c)
+    {
+    }
+
+    T operator[](int index) const
+    {
+        return node_[index] * c_;
+    }
+
+    bool overlaps(const T* begin, const T* end) const
+    {
+        return node_.overlaps(begin, end);
+    }
+};
+
+// Scalar type of the elements of a node.
+template <typename E>
+using value_t = std::decay_t<decltype(std::declval<const E&>()[0])>;
+
+} // namespace expr
+
+/**
+ * @brief Vector expression, returned by operations with a lazy() operand and evaluated in a single pass when assigned to a vector.
+ *
+ * An expression refers to the elements of its operands instead of copying them,
+ * so it must be evaluated before the operands are destroyed (do not store it with `auto`).
+ *
+ * @tparam E root node of the expression tree
+ */
+template <typename E>
+class VectorExpression
+{
+private:
+    // Root node of the expression tree.
+    E node_;
+
+    // Number of elements.
+    int size_;
+
+public:
+    // Scalar type of the elements.
+    using value_type = expr::value_t<E>;
+
+    VectorExpression(const E& node, int size)
+        : node_(node)
+        , size_(size)
+    {
+    }
+
+    /**
+     * @brief Return the root node of the expression tree.
+     *
+     * @return the root node of the expression tree
+     */
+    const E& node() const
+    {
+        return node_;
+    }
+
+    /**
+     * @brief Return the number of elements of the result.
+     *
+     * @return the number of elements of the result
+     */
+    int size() const
+    {
+        return size_;
+    }
+};
+
+/**
+ * @brief Matrix expression, returned by operations with a lazy() operand and evaluated in a single pass when assigned to a matrix.
+ *
+ * An expression refers to the elements of its operands instead of copying them,
+ * so it must be evaluated before the operands are destroyed (do not store it with `auto`).
+ *
+ * @tparam E root node of the expression tree
+ */
+template <typename E>
+class MatrixExpression
+{
+private:
+    // Root node of the expression tree.
+    E node_;
+
+    // Number of rows.
+    int rows_;
+
+    // Number of columns.
+    int cols_;
+
+public:
+    // Scalar type of the elements.
+    using value_type = expr::value_t<E>;
+
+    MatrixExpression(const E& node, int rows, int cols)
+        : node_(node)
+        , rows_(rows)
+        , cols_(cols)
+    {
+    }
+
+    /**
+     * @brief Return the root node of the expression tree.
+     *
+     * @return the root node of the expression tree
+     */
+    const E& node() const
+    {
+        return node_;
+    }
+
+    /**
+     * @brief Return the number of rows of the result.
+     *
+     * @return the number of rows of the result
+     */
+    int row_size() const
+    {
+        return rows_;
+    }
+
+    /**
+     * @brief Return the number of columns of the result.
+     *
+     * @return the number of columns of the result
+     */
+    int col_size() const
+    {
+        return cols_;
+    }
+};
+
+namespace expr
+{
+
+// Root node of an expression operand, vectors, matrices and their views are leaves.
+template <typename T>
+Leaf<T> node(const BasicVector<T>& vector)
+{
+    return Leaf<T>(vector.data(), vector.size());
+}
+
+template <typename T>
+Leaf<std::remove_const_t<T>> node(const BasicVectorView<T>& view)
+{
+    return Leaf<std::remove_const_t<T>>(view.data(), view.size());
+}
+
+template <typename T>
+Leaf<T> node(const BasicMatrix<T>& matrix)
+{
+    return Leaf<T>(matrix.data(), matrix.row_size() * matrix.col_size());
+}
+
+// A view of a block of a matrix may not be contiguous.
+template <typename T>
+Strided<std::remove_const_t<T>> node(const BasicMatrixView<T>& view)
+{
+    return Strided<std::remove_const_t<T>>(view.data(), view.row_size(), view.col_size(), view.stride());
+}
+
+template <typename E>
+const E& node(const VectorExpression<E>& expression)
+{
+    return expression.node();
+}
+
+template <typename E>
+const E& node(const MatrixExpression<E>& expression)
+{
+    return expression.node();
+}
+
+// Node type of an operand.
+template <typename T>
+using node_t = std::decay_t<decltype(node(std::declval<const T&>()))>;
+
+// Evaluate assign(dst[i], node[i]) for 0 <= i < n, split across threads for large n.
+template <typename E, typename T, typename Assign>
+void evaluate(const E& node, int n, T* dst, Assign assign)
+{
+    auto run = [&](int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            assign(dst[i], node[i]);
+        }
+    };
+
+    if (n < kernel::PARALLEL_GRAIN)
+    {
+        run(0, n);
+    }
+    else
+    {
+        kernel::parallel_for(0, n, kernel::PARALLEL_GRAIN, run);
+    }
+}
+
+} // namespace expr
+
+} // namespace mla
+
+#endif // EXPRESSION_H
@@ -0,0 +1,247 @@
+#include "LU.h"
+
+#include "parallel.h"
+#include "utility.hpp"
+
+#include <algorithm> // std::swap_ranges
+#include <cmath>     // std::abs
+#include <complex>   // std::complex
+
+namespace mla
+{
+
+template <typename T>
+BasicLU<T>::BasicLU(BasicMatrixView<const T> matrix, Pivoting pivoting)
+    : factors_(matrix)
+    , permutation_(matrix.row_size())
+    , sign_(1)
+    , singular_(false)
+{
+    // check square matrix
+    utility::check_size(matrix.row_size(), matrix.col_size());
+
+    const int n = size();
+    T* a = factors_.data();
+
+    for (int i = 0; i < n; i++)
+    {
+        permutation_[i] = i;
+    }
+
+    for (int k = 0; k < n; k++)
+    {
+        // bring the largest candidate of column k to the diagonal, or the first nonzero one
+        int p = k;
+        for (int i = k + 1; i < n; i++)
+        {
+            if (pivoting == Pivoting::DIAGONAL ? a[std::ptrdiff_t(p) * n + k] == T(0)
+                                               : std::abs(a[std::ptrdiff_t(i) * n + k]) > std::abs(a[std::ptrdiff_t(p) * n + k]))
+            {
+                p = i;
+            }
+        }
+        if (p != k)
+        {
+            std::swap_ranges(a + std::ptrdiff_t(k) * n, a + std::ptrdiff_t(k + 1) * n, a + std::ptrdiff_t(p) * n);
+            std::swap(permutation_[k], permutation_[p]);
+            sign_ = -sign_;
+        }
+
+        const T* row_k = a + std::ptrdiff_t(k) * n;
+        const T pivot = row_k[k];
+        if (pivot == T(0))
+        {
+            singular_ = true;
+            continue;
+        }
+
+        // rank-1 update of the trailing rows, which are independent of each other
+        const int grain = std::max(1, kernel::PARALLEL_GRAIN / (n - k));
+        kernel::parallel_for(k + 1, n, grain, [=](int begin, int end)
+                             {
+            for (int i = begin; i < end; i++)
+            {
+                T* row_i = a + std::ptrdiff_t(i) * n;
+                const T l = row_i[k] / pivot;
+                row_i[k] = l;
+                if (l != T(0))
+                {
+                    for (int j = k + 1; j < n; j++)
+                    {
+                        row_i[j] -= l * row_k[j];
+                    }
+                }
+            } });
+    }
+}
+
+template <typename T>
+int BasicLU<T>::size() const
+{
+    return factors_.row_size();
+}
+
+template <typename T>
+bool BasicLU<T>::is_singular() const
+{
+    return singular_;
+}
+
+template <typename T>
+const BasicMatrix<T>& BasicLU<T>::factors() const
+{
+    return factors_;
+}
+
+template <typename T>
+const std::vector<int>& BasicLU<T>::permutation() const
+{
+    return permutation_;
+}
+
+template <typename T>
+T BasicLU<T>::det() const
+{
+    const int n = size();
+    const T* a = factors_.data();
+    T determinant = T(sign_);
+    for (int i = 0; i < n; i++)
+    {
+        determinant *= a[std::ptrdiff_t(i) * n + i];
+    }
+    return determinant;
+}
+
+template <typename T>
+BasicVector<T> BasicLU<T>::solve(const BasicVector<T>& b) const
+{
+    utility::check_size(size(), b.size());
+
+    if (singular_)
+    {
+        throw std::runtime_error("Error: Singular matrix.");
+    }
+
+    const int n = size();
+    const T* a = factors_.data();
+
+    // x = Pb
+    BasicVector<T> x(n, 0);
+    T* xd = x.data();
+    for (int i = 0; i < n; i++)
+    {
+        xd[i] = b.data()[permutation_[i]];
+    }
+
+    // forward substitution with the unit lower triangle
+    for (int i = 0; i < n; i++)
+    {
+        const T* row = a + std::ptrdiff_t(i) * n;
+        T sum = xd[i];
+        for (int j = 0; j < i; j++)
+        {
+            sum -= row[j] * xd[j];
+        }
+        xd[i] = sum;
+    }
+
+    // back substitution with the upper triangle
+    for (int i = n - 1; i >= 0; i--)
+    {
+        const T* row = a + std::ptrdiff_t(i) * n;
+        T sum = xd[i];
+        for (int j = i + 1; j < n; j++)
+        {
+            sum -= row[j] * xd[j];
+        }
+        xd[i] = sum / row[i];
+    }
+
+    return x;
+}
+
+template <typename T>
+BasicMatrix<T> BasicLU<T>::solve(const BasicMatrix<T>& b) const
+{
+    utility::check_size(size(), b.row_size());
+
+    if (singular_)
+    {
+        throw std::runtime_error("Error: Singular matrix.");
+    }
+
+    const int n = size();
+    const int m = b.col_size();
+    const T* a = factors_.data();
+
+    // X = PB
+    BasicMatrix<T> x(n, m, 0);
+    for (int i = 0; i < n; i++)
+    {
+        x[i] = b[permutation_[i]];
+    }
+    T* xd = x.data();
+
+    // the columns of X are independent, each chunk sweeps its own columns row by row
+    const int grain = std::max(1, kernel::PARALLEL_GRAIN / std::max(1, n * n));
+    kernel::parallel_for(0, m, grain, [=](int begin, int end)
+                         {
+        // forward substitution with the unit lower triangle
+        for (int i = 0; i < n; i++)
+        {
+            T* row_i = xd + std::ptrdiff_t(i) * m;
+            for (int j = 0; j < i; j++)
+            {
+                const T l = a[std::ptrdiff_t(i) * n + j];
+                const T* row_j = xd + std::ptrdiff_t(j) * m;
+                for (int c = begin; c < end; c++)
+                {
+                    row_i[c] -= l * row_j[c];
+                }
+            }
+        }
+
+        // back substitution with the upper triangle
+        for (int i = n - 1; i >= 0; i--)
+        {
+            T* row_i = xd + std::ptrdiff_t(i) * m;
+            for (int j = i + 1; j < n; j++)
+            {
+                const T u = a[std::ptrdiff_t(i) * n + j];
+                const T* row_j = xd + std::ptrdiff_t(j) * m;
+                for (int c = begin; c < end; c++)
+                {
+                    row_i[c] -= u * row_j[c];
+                }
+            }
+            const T u = a[std::ptrdiff_t(i) * n + i];
+            for (int c = begin; c < end; c++)
+            {
+                row_i[c] /= u;
+            }
+        } });
+
+    return x;
+}
+
+template <typename T>
+BasicMatrix<T> BasicLU<T>::inverse() const
+{
+    return solve(BasicMatrix<T>::eye(size()));
+}
+
+Vector solve(ConstMatrixView a, const Vector& b)
+{
+    return LU(a).solve(b);
+}
+
+Matrix solve(ConstMatrixView a, const Matrix& b)
+{
+    return LU(a).solve(b);
+}
+
+template class BasicLU<float>;
+template class BasicLU<double>;
+template class BasicLU<std::complex<double>>;
+
+} // namespace mla
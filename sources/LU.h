@@ -0,0 +1,159 @@
+/**
+ * @file LU.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief LU factorization class template.
+ * @version 1.0
+ * @date 2026.10.16
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef LU_H
+#define LU_H
+
+#include "Matrix.h"
+#include "MatrixView.h"
+
+namespace mla
+{
+
+// Choice of the pivot of each column of an LU factorization.
+enum class Pivoting
+{
+    // The largest magnitude of the column, the numerically stable choice.
+    PARTIAL,
+
+    // The diagonal element unless it is zero, the order of elimination by hand,
+    // which gives exact results on small integer matrices.
+    DIAGONAL,
+};
+
+/**
+ * @brief LU factorization with row pivoting, PA = LU.
+ *
+ * The matrix is factorized once, then the determinant, the inverse and any number of
+ * linear systems are computed from the stored factors.
+ *
+ * @tparam T scalar type of the elements
+ */
+template <typename T>
+class BasicLU
+{
+private:
+    // L (unit lower triangle, diagonal not stored) and U (upper triangle) packed in one matrix.
+    BasicMatrix<T> factors_;
+
+    // Row i of PA is row permutation_[i] of A.
+    std::vector<int> permutation_;
+
+    // Sign of the permutation, +1 or -1.
+    int sign_;
+
+    // Whether a pivot is exactly zero.
+    bool singular_;
+
+public:
+    /*
+     * Constructor / Destructor
+     */
+
+    /**
+     * @brief Factorize a square matrix or a square block of a matrix.
+     *
+     * @param matrix a square matrix or view
+     * @param pivoting choice of the pivots
+     */
+    explicit BasicLU(BasicMatrixView<const T> matrix, Pivoting pivoting = Pivoting::PARTIAL);
+
+    /*
+     * Examination (will not change the object itself)
+     */
+
+    /**
+     * @brief Return the order of the factorized matrix.
+     *
+     * @return the order of the factorized matrix
+     */
+    int size() const;
+
+    /**
+     * @brief Determine whether the factorized matrix is singular, that is a pivot is exactly zero.
+     *
+     * A matrix that is singular up to rounding may have a tiny nonzero pivot instead, see BasicMatrix::rank().
+     *
+     * @return true if the factorized matrix is singular
+     */
+    bool is_singular() const;
+
+    /**
+     * @brief Return the packed factors, L below the diagonal (unit diagonal implied) and U on and above it.
+     *
+     * @return the packed factors
+     */
+    const BasicMatrix<T>& factors() const;
+
+    /**
+     * @brief Return the row permutation, row i of PA is row permutation()[i] of A.
+     *
+     * @return the row permutation
+     */
+    const std::vector<int>& permutation() const;
+
+    /**
+     * @brief Compute the determinant of the factorized matrix, the signed product of the pivots.
+     *
+     * @return the determinant of the factorized matrix
+     */
+    T det() const;
+
+    /*
+     * Production (will produce new object)
+     */
+
+    /**
+     * @brief Solve the linear system Ax = b.
+     *
+     * @param b a vector of the same size as the matrix order
+     * @return the solution x
+     */
+    BasicVector<T> solve(const BasicVector<T>& b) const;
+
+    /**
+     * @brief Solve the linear systems AX = B, one for each column of B.
+     *
+     * @param b a matrix with as many rows as the matrix order
+     * @return the solution X
+     */
+    BasicMatrix<T> solve(const BasicMatrix<T>& b) const;
+
+    /**
+     * @brief Compute the inverse of the factorized matrix.
+     *
+     * @return the inverse of the factorized matrix
+     */
+    BasicMatrix<T> inverse() const;
+};
+
+using LU = BasicLU<double>;
+
+/**
+ * @brief Solve the linear system Ax = b by LU factorization, without forming the inverse.
+ *
+ * @param a a square matrix or view
+ * @param b a vector of the same size as the matrix order
+ * @return the solution x
+ */
+Vector solve(ConstMatrixView a, const Vector& b);
+
+/**
+ * @brief Solve the linear systems AX = B by LU factorization, without forming the inverse.
+ *
+ * @param a a square matrix or view
+ * @param b a matrix with as many rows as the matrix order
+ * @return the solution X
+ */
+Matrix solve(ConstMatrixView a, const Matrix& b);
+
+} // namespace mla
+
+#endif // LU_H
@@ -0,0 +1,639 @@
+/**
+ * @file Mat.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief Fixed-size matrix class template.
+ * @version 1.0
+ * @date 2026.10.16
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef MAT_H
+#define MAT_H
+
+#include <cstddef> // std::size_t
+
+#include "Matrix.h"
+#include "Vec.h"
+
+namespace mla
+{
+
+/**
+ * @brief Matrix of R rows and C columns stored inline, for small matrices such as 3x3/4x4 transforms.
+ *
+ * The shape is part of the type, so operands of incompatible shapes are rejected at compile time.
+ * Everything except the conversions from and to Matrix is constexpr.
+ *
+ * @tparam R number of rows
+ * @tparam C number of columns
+ */
+template <int R, int C>
+class Mat
+{
+    static_assert(R > 0 && C > 0, "Mat must have at least one row and one column.");
+
+    template <int R1, int K1, int C1>
+    friend constexpr Mat<R1, C1> dot(const Mat<R1, K1>& a, const Mat<K1, C1>& b);
+
+    template <int R1, int C1>
+    friend constexpr Vec<R1> dot(const Mat<R1, C1>& a, const Vec<C1>& v);
+
+private:
+    // Rows stored contiguously in row-major order.
+    Vec<C> rows_[R];
+
+public:
+    /*
+     * Constructor / Destructor
+     */
+
+    /**
+     * @brief Construct a zero matrix.
+     */
+    constexpr Mat();
+
+    /**
+     * @brief Construct a matrix from exactly R rows of exactly C numbers, such as `Mat<2, 2> m = {{1, 2}, {3, 4}}`.
+     *
+     * @param rows the rows
+     */
+    template <std::size_t... Ns, std::enable_if_t<sizeof...(Ns) == R && ((Ns == C) && ...), int> = 0>
+    constexpr Mat(const double (&... rows)[Ns]);
+
+    /**
+     * @brief Copy a dynamic matrix of R rows and C columns.
+     *
+     * @param matrix a matrix of R rows and C columns
+     */
+    explicit Mat(const Matrix& matrix);
+
+    /**
+     * @brief Convert to a dynamic matrix.
+     */
+    operator Matrix() const;
+
+    /*
+     * Comparison
+     */
+
+    /**
+     * @brief Check whether two matrices are equal.
+     *
+     * @param that another matrix
+     * @return true if two matrices are equal
+     */
+    constexpr bool operator==(const Mat& that) const;
+
+    /**
+     * @brief Check whether two matrices are not equal.
+     *
+     * @param that another matrix
+     * @return true if two matrices are not equal
+     */
+    constexpr bool operator!=(const Mat& that) const;
+
+    /*
+     * Access
+     */
+
+    /**
+     * @brief Return the reference to the row at the specified position.
+     *
+     * The index is checked unless MLA_NO_BOUNDS_CHECK is defined for the whole project.
+     *
+     * @param index index of the row to return
+     * @return reference to the row at the specified position
+     */
+    constexpr Vec<C>& operator[](int index);
+
+    /**
+     * @brief Return the const reference to the row at the specified position.
+     *
+     * The index is checked unless MLA_NO_BOUNDS_CHECK is defined for the whole project.
+     *
+     * @param index index of the row to return
+     * @return const reference to the row at the specified position
+     */
+    constexpr const Vec<C>& operator[](int index) const;
+
+    /*
+     * Examination (will not change the object itself)
+     */
+
+    /**
+     * @brief Return the number of rows.
+     *
+     * @return the number of rows
+     */
+    static constexpr int row_size();
+
+    /**
+     * @brief Return the number of columns.
+     *
+     * @return the number of columns
+     */
+    static constexpr int col_size();
+
+    /**
+     * @brief Calculate the determinant of a square matrix.
+     *
+     * @return the determinant
+     */
+    constexpr double det() const;
+
+    /**
+     * @brief Calculate the inverse of a square matrix.
+     *
+     * @return the inverse
+     */
+    constexpr Mat inv() const;
+
+    /**
+     * @brief Returns the transpose of the matrix.
+     *
+     * @return the transpose of the matrix
+     */
+    constexpr Mat<C, R> transpose() const;
+
+    /*
+     * Manipulation (will change the object itself)
+     */
+
+    /**
+     * @brief Addition.
+     *
+     * @param that another matrix
+     * @return self reference
+     */
+    constexpr Mat& operator+=(const Mat& that);
+
+    /**
+     * @brief Difference.
+     *
+     * @param that another matrix
+     * @return self reference
+     */
+    constexpr Mat& operator-=(const Mat& that);
+
+    /**
+     * @brief Hadamard product (entrywise product).
+     *
+     * @param that another matrix
+     * @return self reference
+     */
+    constexpr Mat& operator*=(const Mat& that);
+
+    /**
+     * @brief Scalar multiplication.
+     *
+     * @param c a number
+     * @return self reference
+     */
+    constexpr Mat& operator*=(const double c);
+
+    /*
+     * Production (will produce new object)
+     */
+
+    /**
+     * @brief Generate a unit matrix.
+     *
+     * @return a unit matrix
+     */
+    static constexpr Mat eye();
+};
+
+using Mat2 = Mat<2, 2>;
+using Mat3 = Mat<3, 3>;
+using Mat4 = Mat<4, 4>;
+
+/*
+ * Arithmetic
+ */
+
+/**
+ * @brief Return the addition of two matrices.
+ *
+ * @param a a matrix
+ * @param b another matrix of the same shape
+ * @return the addition of two matrices
+ */
+template <int R, int C>
+constexpr Mat<R, C> operator+(const Mat<R, C>& a, const Mat<R, C>& b);
+
+/**
+ * @brief Return the difference of two matrices.
+ *
+ * @param a a matrix
+ * @param b another matrix of the same shape
+ * @return the difference of two matrices
+ */
+template <int R, int C>
+constexpr Mat<R, C> operator-(const Mat<R, C>& a, const Mat<R, C>& b);
+
+/**
+ * @brief Return the Hadamard product (entrywise product) of two matrices.
+ *
+ * @param a a matrix
+ * @param b another matrix of the same shape
+ * @return the Hadamard product (entrywise product) of two matrices
+ */
+template <int R, int C>
+constexpr Mat<R, C> operator*(const Mat<R, C>& a, const Mat<R, C>& b);
+
+/**
+ * @brief Return the scalar multiplication of matrix and number.
+ *
+ * @param m a matrix
+ * @param c a number
+ * @return the scalar multiplication of matrix and number
+ */
+template <int R, int C>
+constexpr Mat<R, C> operator*(const Mat<R, C>& m, const double c);
+
+/**
+ * @brief Return the scalar multiplication of matrix and number.
+ *
+ * @param c a number
+ * @param m a matrix
+ * @return the scalar multiplication of matrix and number
+ */
+template <int R, int C>
+constexpr Mat<R, C> operator*(const double c, const Mat<R, C>& m);
+
+/**
+ * @brief Return the product of two matrices.
+ *
+ * @param a a matrix (R rows, K cols)
+ * @param b another matrix (K rows, C cols)
+ * @return the product of two matrices (R rows, C cols)
+ */
+template <int R, int K, int C>
+constexpr Mat<R, C> dot(const Mat<R, K>& a, const Mat<K, C>& b);
+
+/**
+ * @brief Return the product of a matrix and a column vector.
+ *
+ * @param a a matrix (R rows, C cols)
+ * @param v a vector of C elements
+ * @return the product, a vector of R elements
+ */
+template <int R, int C>
+constexpr Vec<R> dot(const Mat<R, C>& a, const Vec<C>& v);
+
+/*
+ * Print
+ */
+
+/**
+ * @brief Output matrix data to the specified output stream.
+ *
+ * @param os an output stream
+ * @param mat the matrix to be printed to the output stream
+ * @return self reference of the output stream
+ */
+template <int R, int C>
+std::ostream& operator<<(std::ostream& os, const Mat<R, C>& mat);
+
+template <int R, int C>
+constexpr Mat<R, C>::Mat()
+    : rows_{}
+{
+}
+
+template <int R, int C>
+template <std::size_t... Ns, std::enable_if_t<sizeof...(Ns) == R && ((Ns == C) && ...), int>>
+constexpr Mat<R, C>::Mat(const double (&... rows)[Ns])
+    : rows_{}
+{
+    const double* pointers[] = {rows...};
+    for (int r = 0; r < R; r++)
+    {
+        for (int c = 0; c < C; c++)
+        {
+            rows_[r][c] = pointers[r][c];
+        }
+    }
+}
+
+template <int R, int C>
+Mat<R, C>::Mat(const Matrix& matrix)
+    : rows_{}
+{
+    utility::check_size(matrix.row_size(), R);
+    utility::check_size(matrix.col_size(), C);
+
+    for (int r = 0; r < R; r++)
+    {
+        for (int c = 0; c < C; c++)
+        {
+            rows_[r][c] = matrix.data()[r * C + c];
+        }
+    }
+}
+
+template <int R, int C>
+Mat<R, C>::operator Matrix() const
+{
+    Matrix matrix(R, C, 0);
+    for (int r = 0; r < R; r++)
+    {
+        for (int c = 0; c < C; c++)
+        {
+            matrix.data()[r * C + c] = rows_[r][c];
+        }
+    }
+    return matrix;
+}
+
+template <int R, int C>
+constexpr bool Mat<R, C>::operator==(const Mat& that) const
+{
+    for (int r = 0; r < R; r++)
+    {
+        if (rows_[r] != that.rows_[r])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int R, int C>
+constexpr bool Mat<R, C>::operator!=(const Mat& that) const
+{
+    return !(*this == that);
+}
+
+template <int R, int C>
+constexpr Vec<C>& Mat<R, C>::operator[](int index)
+{
+    utility::check_index(index, R);
+
+    return rows_[index];
+}
+
+template <int R, int C>
+constexpr const Vec<C>& Mat<R, C>::operator[](int index) const
+{
+    utility::check_index(index, R);
+
+    return rows_[index];
+}
+
+template <int R, int C>
+constexpr int Mat<R, C>::row_size()
+{
+    return R;
+}
+
+template <int R, int C>
+constexpr int Mat<R, C>::col_size()
+{
+    return C;
+}
+
+template <int R, int C>
+constexpr double Mat<R, C>::det() const
+{
+    static_assert(R == C, "det() requires a square matrix.");
+
+    if constexpr (R == 1)
+    {
+        return rows_[0][0];
+    }
+    else if constexpr (R == 2)
+    {
+        return rows_[0][0] * rows_[1][1] - rows_[0][1] * rows_[1][0];
+    }
+    else if constexpr (R == 3)
+    {
+        return rows_[0][0] * (rows_[1][1] * rows_[2][2] - rows_[1][2] * rows_[2][1]) //
+               - rows_[0][1] * (rows_[1][0] * rows_[2][2] - rows_[1][2] * rows_[2][0])
+               + rows_[0][2] * (rows_[1][0] * rows_[2][1] - rows_[1][1] * rows_[2][0]);
+    }
+    else
+    {
+        // Gaussian elimination with partial pivoting
+        Mat a = *this;
+        double determinant = 1;
+        for (int k = 0; k < R; k++)
+        {
+            int p = k;
+            for (int i = k + 1; i < R; i++)
+            {
+                if (utility::abs(a.rows_[i][k]) > utility::abs(a.rows_[p][k]))
+                {
+                    p = i;
+                }
+            }
+            if (a.rows_[p][k] == 0)
+            {
+                return 0;
+            }
+            if (p != k)
+            {
+                Vec<C> row = a.rows_[k];
+                a.rows_[k] = a.rows_[p];
+                a.rows_[p] = row;
+                determinant = -determinant;
+            }
+            determinant *= a.rows_[k][k];
+            for (int i = k + 1; i < R; i++)
+            {
+                a.rows_[i] -= a.rows_[k] * (a.rows_[i][k] / a.rows_[k][k]);
+            }
+        }
+        return determinant;
+    }
+}
+
+template <int R, int C>
+constexpr Mat<R, C> Mat<R, C>::inv() const
+{
+    static_assert(R == C, "inv() requires a square matrix.");
+
+    // Gauss-Jordan elimination with partial pivoting, singular only for an exactly zero pivot
+    Mat a = *this;
+    Mat inverse = eye();
+    for (int k = 0; k < R; k++)
+    {
+        int p = k;
+        for (int i = k + 1; i < R; i++)
+        {
+            if (utility::abs(a.rows_[i][k]) > utility::abs(a.rows_[p][k]))
+            {
+                p = i;
+            }
+        }
+        if (a.rows_[p][k] == 0)
+        {
+            throw std::runtime_error("Error: Singular matrix.");
+        }
+        if (p != k)
+        {
+            Vec<C> row = a.rows_[k];
+            a.rows_[k] = a.rows_[p];
+            a.rows_[p] = row;
+            row = inverse.rows_[k];
+            inverse.rows_[k] = inverse.rows_[p];
+            inverse.rows_[p] = row;
+        }
+        const double pivot = a.rows_[k][k];
+        a.rows_[k] *= 1 / pivot;
+        inverse.rows_[k] *= 1 / pivot;
+        for (int i = 0; i < R; i++)
+        {
+            if (i != k)
+            {
+                const double l = a.rows_[i][k];
+                a.rows_[i] -= a.rows_[k] * l;
+                inverse.rows_[i] -= inverse.rows_[k] * l;
+            }
+        }
+    }
+    return inverse;
+}
+
+template <int R, int C>
+constexpr Mat<C, R> Mat<R, C>::transpose() const
+{
+    Mat<C, R> result;
+    for (int r = 0; r < R; r++)
+    {
+        for (int c = 0; c < C; c++)
+        {
+            result[c][r] = rows_[r][c];
+        }
+    }
+    return result;
+}
+
+template <int R, int C>
+constexpr Mat<R, C>& Mat<R, C>::operator+=(const Mat& that)
+{
+    for (int r = 0; r < R; r++)
+    {
+        rows_[r] += that.rows_[r];
+    }
+    return *this;
+}
+
+template <int R, int C>
+constexpr Mat<R, C>& Mat<R, C>::operator-=(const Mat& that)
+{
+    for (int r = 0; r < R; r++)
+    {
+        rows_[r] -= that.rows_[r];
+    }
+    return *this;
+}
+
+template <int R, int C>
+constexpr Mat<R, C>& Mat<R, C>::operator*=(const Mat& that)
+{
+    for (int r = 0; r < R; r++)
+    {
+        rows_[r] *= that.rows_[r];
+    }
+    return *this;
+}
+
+template <int R, int C>
+constexpr Mat<R, C>& Mat<R, C>::operator*=(const double c)
+{
+    for (int r = 0; r < R; r++)
+    {
+        rows_[r] *= c;
+    }
+    return *this;
+}
+
+template <int R, int C>
+constexpr Mat<R, C> Mat<R, C>::eye()
+{
+    static_assert(R == C, "eye() requires a square matrix.");
+
+    Mat result;
+    for (int i = 0; i < R; i++)
+    {
+        result.rows_[i][i] = 1;
+    }
+    return result;
+}
+
+template <int R, int C>
+constexpr Mat<R, C> operator+(const Mat<R, C>& a, const Mat<R, C>& b)
+{
+    Mat<R, C> result = a;
+    return result += b;
+}
+
+template <int R, int C>
+constexpr Mat<R, C> operator-(const Mat<R, C>& a, const Mat<R, C>& b)
+{
+    Mat<R, C> result = a;
+    return result -= b;
+}
+
+template <int R, int C>
+constexpr Mat<R, C> operator*(const Mat<R, C>& a, const Mat<R, C>& b)
+{
+    Mat<R, C> result = a;
+    return result *= b;
+}
+
+template <int R, int C>
+constexpr Mat<R, C> operator*(const Mat<R, C>& m, const double c)
+{
+    Mat<R, C> result = m;
+    return result *= c;
+}
+
+template <int R, int C>
+constexpr Mat<R, C> operator*(const double c, const Mat<R, C>& m)
+{
+    return m * c;
+}
+
+template <int R, int K, int C>
+constexpr Mat<R, C> dot(const Mat<R, K>& a, const Mat<K, C>& b)
+{
+    Mat<R, C> result;
+    for (int r = 0; r < R; r++)
+    {
+        double* z = result.rows_[r].data();
+        for (int k = 0; k < K; k++)
+        {
+            const double x = a.rows_[r].data()[k];
+            const double* y = b.rows_[k].data();
+            for (int c = 0; c < C; c++)
+            {
+                z[c] += x * y[c];
+            }
+        }
+    }
+    return result;
+}
+
+template <int R, int C>
+constexpr Vec<R> dot(const Mat<R, C>& a, const Vec<C>& v)
+{
+    Vec<R> result;
+    for (int r = 0; r < R; r++)
+    {
+        result.data()[r] = dot(a.rows_[r], v);
+    }
+    return result;
+}
+
+template <int R, int C>
+std::ostream& operator<<(std::ostream& os, const Mat<R, C>& mat)
+{
+    return os << Matrix(mat);
+}
+
+} // namespace mla
+
+#endif // MAT_H
@@ -1,426 +1,727 @@
 #include "Matrix.h"
 
+#include "Cholesky.h"
+#include "LU.h"
+#include "MatrixView.h"
+#include "QR.h"
+#include "gemm.h"
+#include "parallel.h"
+#include "simd.h"
+#include "text.hpp"
 #include "utility.hpp"
 
-#include <algorithm> // std::sort
+#include <algorithm> // std::copy std::max std::min std::stable_sort std::swap_ranges
+#include <cmath>     // std::abs std::isfinite std::isnan
+#include <complex>   // std::complex
+#include <limits>    // std::numeric_limits
+#include <utility>   // std::exchange
 
 namespace mla
 {
 
-Matrix::Matrix()
-    : rows_()
+// Number of rows holding about PARALLEL_GRAIN elements.
+static int row_grain(int cols)
 {
+    return std::max(1, kernel::PARALLEL_GRAIN / std::max(1, cols));
 }
 
-Matrix::Matrix(const std::initializer_list<Vector>& il)
-    : rows_(il.begin(), il.end())
+// Order of the square tiles of a transpose: a source tile and a destination tile stay in L1 together.
+static constexpr int TILE = 32;
+
+// Transpose an m x n tile of src into an n x m tile of dst.
+template <typename T>
+static void transpose_tile(int m, int n, const T* src, int lds, T* dst, int ldd)
 {
-    // the number of elements in each row needs to be equal
-    for (const auto& row : il)
+    for (int i = 0; i < m; i++)
     {
-        utility::check_size(row.size(), il.begin()->size());
+        for (int j = 0; j < n; j++)
+        {
+            dst[std::ptrdiff_t(j) * ldd + i] = src[std::ptrdiff_t(i) * lds + j];
+        }
     }
 }
 
-Matrix::Matrix(int row, int col, double element)
+/*
+ * Rank of the m x n row-major matrix a by Gaussian elimination with complete pivoting, which reveals the rank:
+ * the elimination stops at the first pivot not above the tolerance, as the remaining block is then negligible.
+ * A negative tolerance stands for max(m, n) * epsilon * max|a|, or zero if max|a| is not finite.
+ * NaN is taken as the largest magnitude and is never negligible, on every instruction set.
+ */
+template <typename T>
+static int pivoted_rank(std::vector<T> a, int m, int n, double tolerance)
 {
-    for (int i = 0; i < row; i++)
+    using R = utility::real_t<T>;
+
+    const int steps = std::min(m, n);
+    T* data = a.data();
+
+    // whether magnitude a is above b, a NaN being above any number
+    const auto above = [](R a, R b)
+    { return a > b || (std::isnan(a) && !std::isnan(b)); };
+
+    // largest magnitude of each row of the trailing block, refreshed by the update that changes the row
+    std::vector<R> row_max(m, 0);
+    for (int i = 0; i < m; i++)
     {
-        rows_.insert(rows_.end(), Vector(col, element));
+        const T* row = data + std::ptrdiff_t(i) * n;
+        for (int j = 0; j < n; j++)
+        {
+            row_max[i] = kernel::nan_max(row_max[i], std::abs(row[j]));
+        }
     }
-}
 
-Matrix::Matrix(const Matrix& that)
-    : rows_(that.rows_)
-{
+    for (int k = 0; k < steps; k++)
+    {
+        // complete pivoting: the largest element of the trailing block
+        int p = k;
+        for (int i = k + 1; i < m; i++)
+        {
+            if (above(row_max[i], row_max[p]))
+            {
+                p = i;
+            }
+        }
+        if (k == 0 && tolerance < 0)
+        {
+            tolerance = std::isfinite(row_max[p]) ? std::max(m, n) * std::numeric_limits<R>::epsilon() * row_max[p] : 0;
+        }
+        if (row_max[p] <= tolerance)
+        {
+            return k;
+        }
+
+        // bring it to (k, k), the rows by swapping their elements, the columns by swapping one element per row
+        T* row_p = data + std::ptrdiff_t(p) * n;
+        int q = k;
+        for (int j = k + 1; j < n; j++)
+        {
+            if (above(std::abs(row_p[j]), std::abs(row_p[q])))
+            {
+                q = j;
+            }
+        }
+        if (p != k)
+        {
+            std::swap_ranges(data + std::ptrdiff_t(k) * n, data + std::ptrdiff_t(k + 1) * n, row_p);
+            std::swap(row_max[k], row_max[p]);
+        }
+        if (q != k)
+        {
+            for (int i = k; i < m; i++)
+            {
+                T* row = data + std::ptrdiff_t(i) * n;
+                std::swap(row[k], row[q]);
+            }
+        }
+
+        // rank-1 update of the trailing rows, each one also finds its new largest magnitude
+        const T* row_k = data + std::ptrdiff_t(k) * n;
+        const T pivot = row_k[k];
+        const int grain = std::max(1, kernel::PARALLEL_GRAIN / (n - k));
+        R* maxima = row_max.data();
+        kernel::parallel_for(k + 1, m, grain, [=](int begin, int end)
+                             {
+            for (int i = begin; i < end; i++)
+            {
+                T* row_i = data + std::ptrdiff_t(i) * n;
+                maxima[i] = kernel::axpy_amax(n - k - 1, -row_i[k] / pivot, row_k + k + 1, row_i + k + 1);
+            } });
+    }
+    return steps;
 }
 
-Matrix::Matrix(Matrix&& that)
-    : rows_(std::move(that.rows_))
+template <typename T>
+BasicMatrix<T>::BasicMatrix()
+    : elements_()
+    , rows_(0)
+    , cols_(0)
 {
 }
 
-bool Matrix::operator==(const Matrix& that) const
+template <typename T>
+BasicMatrix<T>::BasicMatrix(const std::initializer_list<BasicVector<T>>& il)
+    : elements_()
+    , rows_(int(il.size()))
+    , cols_(il.size() == 0 ? 0 : il.begin()->size())
 {
-    if ((row_size() != that.row_size()) || (col_size() != that.col_size()))
+    elements_.reserve(std::size_t(rows_) * cols_);
+    for (const auto& row : il)
     {
-        return false;
+        // the number of elements in each row needs to be equal
+        utility::check_size(row.size(), cols_);
+
+        elements_.insert(elements_.end(), row.elements_.begin(), row.elements_.end());
     }
+}
 
-    for (int i = 0; i < row_size(); ++i)
+template <typename T>
+BasicMatrix<T>::BasicMatrix(int row, int col, const T& element)
+    : elements_(std::size_t(row) * col, element)
+    , rows_(row)
+    , cols_(row == 0 ? 0 : col)
+{
+}
+
+template <typename T>
+BasicMatrix<T>::BasicMatrix(const BasicMatrix& that)
+    : elements_(that.elements_)
+    , rows_(that.rows_)
+    , cols_(that.cols_)
+{
+}
+
+template <typename T>
+BasicMatrix<T>::BasicMatrix(BasicMatrix&& that) noexcept
+    : elements_(std::move(that.elements_))
+    , rows_(std::exchange(that.rows_, 0))
+    , cols_(std::exchange(that.cols_, 0))
+{
+}
+
+template <typename T>
+BasicMatrix<T>::BasicMatrix(BasicMatrixView<const T> view)
+    : elements_()
+    , rows_(view.row_size())
+    , cols_(view.row_size() == 0 ? 0 : view.col_size())
+{
+    elements_.reserve(std::size_t(rows_) * cols_);
+    for (int r = 0; r < rows_; r++)
     {
-        if (rows_[i] != that.rows_[i])
-        {
-            return false;
-        }
+        const T* row = view.data() + std::ptrdiff_t(r) * view.stride();
+        elements_.insert(elements_.end(), row, row + cols_);
     }
+}
 
-    return true;
+template <typename T>
+bool BasicMatrix<T>::operator==(const BasicMatrix& that) const
+{
+    return rows_ == that.rows_ && cols_ == that.cols_ && elements_ == that.elements_;
 }
 
-bool Matrix::operator!=(const Matrix& that) const
+template <typename T>
+bool BasicMatrix<T>::operator!=(const BasicMatrix& that) const
 {
     return !(*this == that);
 }
 
-Matrix& Matrix::operator=(const Matrix& that)
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator=(const BasicMatrix& that)
 {
     if (this != &that)
     {
+        elements_ = that.elements_;
         rows_ = that.rows_;
+        cols_ = that.cols_;
     }
 
     return *this;
 }
 
-Matrix& Matrix::operator=(Matrix&& that)
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator=(BasicMatrix&& that)
 {
     if (this != &that)
     {
-        rows_ = std::move(that.rows_);
+        elements_ = std::move(that.elements_);
+        rows_ = std::exchange(that.rows_, 0);
+        cols_ = std::exchange(that.cols_, 0);
     }
 
     return *this;
 }
 
-Vector& Matrix::operator[](int index)
+template <typename T>
+T* BasicMatrix<T>::data()
 {
-    utility::check_bounds(index, 0, row_size());
-
-    return rows_[index];
+    return elements_.data();
 }
 
-const Vector& Matrix::operator[](int index) const
+template <typename T>
+const T* BasicMatrix<T>::data() const
 {
-    utility::check_bounds(index, 0, row_size());
-
-    return rows_[index];
+    return elements_.data();
 }
 
-std::vector<Vector>::iterator Matrix::begin()
+template <typename T>
+typename BasicMatrix<T>::template RowIterator<T> BasicMatrix<T>::begin()
 {
-    return rows_.begin();
+    return RowIterator<T>(elements_.data(), cols_, cols_, 0);
 }
 
-std::vector<Vector>::const_iterator Matrix::begin() const
+template <typename T>
+typename BasicMatrix<T>::template RowIterator<const T> BasicMatrix<T>::begin() const
 {
-    return rows_.cbegin();
+    return RowIterator<const T>(elements_.data(), cols_, cols_, 0);
 }
 
-std::vector<Vector>::iterator Matrix::end()
+template <typename T>
+typename BasicMatrix<T>::template RowIterator<T> BasicMatrix<T>::end()
 {
-    return rows_.end();
+    return RowIterator<T>(elements_.data(), cols_, cols_, rows_);
 }
 
-std::vector<Vector>::const_iterator Matrix::end() const
+template <typename T>
+typename BasicMatrix<T>::template RowIterator<const T> BasicMatrix<T>::end() const
 {
-    return rows_.cend();
+    return RowIterator<const T>(elements_.data(), cols_, cols_, rows_);
 }
 
-int Matrix::row_size() const
+template <typename T>
+int BasicMatrix<T>::row_size() const
 {
-    return int(rows_.size());
+    return rows_;
 }
 
-int Matrix::col_size() const
+template <typename T>
+int BasicMatrix<T>::col_size() const
 {
-    return row_size() == 0 ? 0 : rows_.begin()->size();
+    return cols_;
 }
 
-std::string Matrix::to_string() const
+// Print the elements as [e11 e12 ...;\n e21 e22 ...] with six decimals, like std::to_string.
+template <typename T>
+static void print(text::Writer& writer, const BasicMatrix<T>& matrix)
 {
-    if (rows_.empty())
+    writer.put('[');
+    for (int r = 0; r < matrix.row_size(); r++)
     {
-        return "[]";
-    }
-
-    auto it = rows_.begin();
-    std::string s = "[";
-    while (true)
-    {
-        std::string row = it->to_string();
-        s.append(row.begin() + 1, row.end() - 1);
-        ++it;
-        if (it == rows_.end())
+        if (r != 0)
+        {
+            writer.put(";\n ");
+        }
+        const T* row = matrix.data() + std::size_t(r) * matrix.col_size();
+        for (int c = 0; c < matrix.col_size(); c++)
         {
-            return s.append("]");
+            if (c != 0)
+            {
+                writer.put(' ');
+            }
+            writer.fixed(row[c]);
         }
-        s.append(";\n ");
     }
+    writer.put(']');
+}
+
+template <typename T>
+std::string BasicMatrix<T>::to_string() const
+{
+    std::string s;
+    text::Writer writer(s);
+    print(writer, *this);
+    writer.flush();
     return s;
 }
 
-int Matrix::rank() const
+template <typename T>
+int BasicMatrix<T>::rank() const
 {
-    Matrix echelon = Matrix(*this).transform_row_echelon();
-    int zeros = 0;
-    for (const auto& r : echelon.rows_)
-    {
-        if (r.is_zero())
-        {
-            ++zeros;
-        }
-    }
-    return row_size() - zeros;
+    return view().rank();
 }
 
-double Matrix::det() const
+template <typename T>
+int BasicMatrix<T>::rank(double tolerance) const
+{
+    return view().rank(tolerance);
+}
+
+template <typename T>
+T BasicMatrix<T>::det() const
 {
     // check square matrix
     utility::check_size(row_size(), col_size());
 
-    Matrix echelon = Matrix(*this).transform_row_echelon();
-    double determinant = 1;
-    for (int i = 0; i < echelon.row_size(); i++)
-    {
-        determinant *= echelon[i][i];
-    }
-    return determinant;
+    return BasicLU<T>(*this, Pivoting::DIAGONAL).det();
 }
 
-Matrix Matrix::inv() const
+template <typename T>
+BasicMatrix<T> BasicMatrix<T>::inv() const
 {
     // check square matrix
     utility::check_size(row_size(), col_size());
 
-    // check invertible matrix
-    if (rank() != row_size())
-    {
-        throw std::runtime_error("Error: Singular matrix.");
-    }
+    return BasicLU<T>(*this, Pivoting::DIAGONAL).inverse();
+}
 
-    // 1. 生成同阶单位阵 E
-    // 2. 生成增广矩阵 A:E
-    // 3. 将 A:E 化为阶梯矩阵
-    Matrix echelon = Matrix(*this).append_col(Matrix::eye(row_size())).transform_row_echelon();
-    // 4. 将 A 化为对角矩阵
-    for (int c = 0; c < echelon.row_size(); ++c)
-    {
-        for (int r = 0; r < c; ++r)
-        {
-            echelon.E(r, c, -(echelon[r][c] / echelon[c][c]));
-        }
-    }
-    // 5. 将 A 化为单位阵
-    for (int r = 0; r < echelon.row_size(); ++r)
-    {
-        echelon.E(r, (1.0 / echelon[r][r]));
-    }
-    // 6. 此时原先的 E 即为 A 的逆
-    return echelon.split_col(row_size()).second;
+template <typename T>
+BasicLU<T> BasicMatrix<T>::lu() const
+{
+    return BasicLU<T>(*this);
 }
 
-Matrix& Matrix::append_row(const Matrix& matrix)
+template <>
+Cholesky BasicMatrix<double>::cholesky() const
+{
+    return Cholesky(*this);
+}
+
+template <>
+QR BasicMatrix<double>::qr() const
+{
+    return QR(*this);
+}
+
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::append_row(const BasicMatrix& matrix)
 {
     utility::check_size(col_size(), matrix.col_size());
 
-    rows_.insert(rows_.end(), matrix.rows_.begin(), matrix.rows_.end());
+    elements_.insert(elements_.end(), matrix.elements_.begin(), matrix.elements_.end());
+    rows_ += matrix.rows_;
     return *this;
 }
 
-Matrix& Matrix::append_col(const Matrix& matrix)
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::append_col(const BasicMatrix& matrix)
 {
     utility::check_size(row_size(), matrix.row_size());
 
-    for (int i = 0; i < row_size(); i++)
+    std::vector<T, Allocator<T>> elements(elements_.get_allocator());
+    elements.reserve(elements_.size() + matrix.elements_.size());
+    for (int r = 0; r < rows_; r++)
     {
-        rows_[i].append(matrix[i]);
+        auto row = elements_.begin() + std::ptrdiff_t(r) * cols_;
+        auto other = matrix.elements_.begin() + std::ptrdiff_t(r) * matrix.cols_;
+        elements.insert(elements.end(), row, row + cols_);
+        elements.insert(elements.end(), other, other + matrix.cols_);
     }
+    elements_ = std::move(elements);
+    cols_ += matrix.cols_;
     return *this;
 }
 
-Matrix& Matrix::operator+=(const Matrix& matrix)
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator+=(const BasicMatrix& matrix)
 {
     utility::check_size(row_size(), matrix.row_size());
     utility::check_size(col_size(), matrix.col_size());
 
-    for (int r = 0; r < row_size(); r++)
-    {
-        (*this)[r] += matrix[r];
-    }
+    const T* x = matrix.elements_.data();
+    T* y = elements_.data();
+    kernel::parallel_for(0, int(elements_.size()), kernel::PARALLEL_GRAIN, [=](int begin, int end)
+                         { kernel::add(end - begin, x + begin, y + begin); });
     return *this;
 }
 
-Matrix& Matrix::operator-=(const Matrix& matrix)
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator-=(const BasicMatrix& matrix)
 {
     utility::check_size(row_size(), matrix.row_size());
     utility::check_size(col_size(), matrix.col_size());
 
-    for (int r = 0; r < row_size(); r++)
-    {
-        (*this)[r] -= matrix[r];
-    }
+    const T* x = matrix.elements_.data();
+    T* y = elements_.data();
+    kernel::parallel_for(0, int(elements_.size()), kernel::PARALLEL_GRAIN, [=](int begin, int end)
+                         { kernel::sub(end - begin, x + begin, y + begin); });
     return *this;
 }
 
-Matrix& Matrix::operator*=(const Matrix& matrix)
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator*=(const BasicMatrix& matrix)
 {
     utility::check_size(row_size(), matrix.row_size());
     utility::check_size(col_size(), matrix.col_size());
 
-    for (int r = 0; r < row_size(); r++)
-    {
-        (*this)[r] *= matrix[r];
-    }
+    const T* x = matrix.elements_.data();
+    T* y = elements_.data();
+    kernel::parallel_for(0, int(elements_.size()), kernel::PARALLEL_GRAIN, [=](int begin, int end)
+                         { kernel::mul(end - begin, x + begin, y + begin); });
     return *this;
 }
 
-Matrix& Matrix::operator*=(const double c)
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator*=(const T& c)
 {
-    for (int r = 0; r < row_size(); r++)
-    {
-        (*this)[r] *= c;
-    }
+    T* y = elements_.data();
+    kernel::parallel_for(0, int(elements_.size()), kernel::PARALLEL_GRAIN, [=](int begin, int end)
+                         { kernel::scale(end - begin, c, y + begin); });
     return *this;
 }
 
-Matrix& Matrix::E(int i, int j)
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::E(int i, int j)
 {
-    utility::swap(rows_[i], rows_[j]);
+    auto row_i = elements_.begin() + std::ptrdiff_t(i) * cols_;
+    auto row_j = elements_.begin() + std::ptrdiff_t(j) * cols_;
+    std::swap_ranges(row_i, row_i + cols_, row_j);
     return *this;
 }
 
-Matrix& Matrix::E(int i, double k)
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::E(int i, const T& k)
 {
-    rows_[i] *= k;
+    T* row_i = elements_.data() + std::size_t(i) * cols_;
+    for (int c = 0; c < cols_; c++)
+    {
+        row_i[c] *= k;
+    }
     return *this;
 }
 
-Matrix& Matrix::E(int i, int j, double k)
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::E(int i, int j, const T& k)
 {
-    rows_[i] += rows_[j] * k;
+    T* row_i = elements_.data() + std::size_t(i) * cols_;
+    const T* row_j = elements_.data() + std::size_t(j) * cols_;
+    for (int c = 0; c < cols_; c++)
+    {
+        row_i[c] += row_j[c] * k;
+    }
     return *this;
 }
 
-Matrix& Matrix::transform_row_echelon()
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::transform_row_echelon()
 {
     // step 1: Gaussian elimination
-    for (int i = 0; i < row_size(); ++i)
+    for (int i = 0; i < rows_; ++i)
     {
+        const T* row_i = elements_.data() + std::size_t(i) * cols_;
         int j = 0;
-        while (j < col_size() && rows_[i][j] == 0)
+        while (j < cols_ && row_i[j] == T(0))
         {
             ++j;
         }
-        for (int k = i + 1; k < row_size(); ++k)
+        for (int k = i + 1; k < rows_; ++k)
         {
-            if (j < col_size() && rows_[i][j] != 0)
+            if (j < cols_ && row_i[j] != T(0))
             {
-                E(k, i, -(rows_[k][j] / rows_[i][j]));
+                E(k, i, -(elements_[std::size_t(k) * cols_ + j] / row_i[j]));
             }
         }
     }
 
     // step 2: Transform to the row echelon form. It's so elegant, I'm a genius haha.
-    std::sort(rows_.begin(), rows_.end(), [](const Vector& v1, const Vector& v2) -> bool
-              { return v1.count_leading_zeros() < v2.count_leading_zeros(); });
+    // The rows are ordered through a permutation so that each row is moved only once.
+    std::vector<int> leading_zeros(rows_);
+    std::vector<int> order(rows_);
+    for (int r = 0; r < rows_; r++)
+    {
+        const T* row = elements_.data() + std::size_t(r) * cols_;
+        leading_zeros[r] = int(std::find_if(row, row + cols_, [](const T& e)
+                                            { return e != T(0); }) -
+                               row);
+        order[r] = r;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int r1, int r2) -> bool
+                     { return leading_zeros[r1] < leading_zeros[r2]; });
+
+    std::vector<T, Allocator<T>> elements(elements_.size(), T(0), elements_.get_allocator());
+    for (int r = 0; r < rows_; r++)
+    {
+        auto row = elements_.begin() + std::ptrdiff_t(order[r]) * cols_;
+        std::copy(row, row + cols_, elements.begin() + std::ptrdiff_t(r) * cols_);
+    }
+    elements_ = std::move(elements);
 
     return *this;
 }
 
-Matrix& Matrix::map(void (*action)(int row, int col, double& e))
+template <typename T>
+BasicMatrixView<T> BasicMatrix<T>::view()
 {
-    for (int r = 0; r < row_size(); r++)
-    {
-        for (int c = 0; c < col_size(); c++)
-        {
-            action(r, c, rows_[r][c]);
-        }
-    }
-    return *this;
+    return BasicMatrixView<T>(*this);
+}
+
+template <typename T>
+BasicMatrixView<const T> BasicMatrix<T>::view() const
+{
+    return BasicMatrixView<const T>(*this);
+}
+
+template <typename T>
+BasicMatrixView<T> BasicMatrix<T>::block(int row, int col, int rows, int cols)
+{
+    return view().block(row, col, rows, cols);
 }
 
-std::pair<Matrix, Matrix> Matrix::split_row(int n) const
+template <typename T>
+BasicMatrixView<const T> BasicMatrix<T>::block(int row, int col, int rows, int cols) const
+{
+    return view().block(row, col, rows, cols);
+}
+
+template <typename T>
+std::pair<BasicMatrix<T>, BasicMatrix<T>> BasicMatrix<T>::split_row(int n) const
 {
     utility::check_bounds(n, 0, row_size());
 
-    Matrix first, second;
-    first.rows_.assign(rows_.begin(), rows_.begin() + n);
-    second.rows_.assign(rows_.begin() + n, rows_.end());
+    auto middle = elements_.begin() + std::ptrdiff_t(n) * cols_;
+
+    BasicMatrix first, second;
+    first.elements_.assign(elements_.begin(), middle);
+    first.rows_ = n;
+    first.cols_ = n == 0 ? 0 : cols_;
+    second.elements_.assign(middle, elements_.end());
+    second.rows_ = rows_ - n;
+    second.cols_ = cols_;
 
     return std::make_pair(first, second);
 }
 
-std::pair<Matrix, Matrix> Matrix::split_col(int n) const
+template <typename T>
+std::pair<BasicMatrix<T>, BasicMatrix<T>> BasicMatrix<T>::split_col(int n) const
 {
     utility::check_bounds(n, 0, col_size());
 
-    Matrix first, second;
-    first.rows_.resize(row_size());
-    second.rows_.resize(row_size());
-    for (int r = 0; r < row_size(); r++)
+    BasicMatrix first, second;
+    first.elements_.reserve(std::size_t(rows_) * n);
+    second.elements_.reserve(std::size_t(rows_) * (cols_ - n));
+    for (int r = 0; r < rows_; r++)
     {
-        first.rows_[r].elements_.assign(rows_[r].begin(), rows_[r].begin() + n);
-        second.rows_[r].elements_.assign(rows_[r].begin() + n, rows_[r].end());
+        auto row = elements_.begin() + std::ptrdiff_t(r) * cols_;
+        first.elements_.insert(first.elements_.end(), row, row + n);
+        second.elements_.insert(second.elements_.end(), row + n, row + cols_);
     }
+    first.rows_ = second.rows_ = rows_;
+    first.cols_ = n;
+    second.cols_ = cols_ - n;
 
     return std::make_pair(first, second);
 }
 
-Matrix Matrix::transpose() const
+template <typename T>
+BasicMatrix<T> BasicMatrix<T>::transpose() const
 {
-    Matrix result(col_size(), row_size(), 0);
+    return view().transpose();
+}
 
-    for (int i = 0; i < row_size(); i++)
-    {
-        for (int j = 0; j < col_size(); j++)
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::transpose_inplace()
+{
+    utility::check_size(rows_, cols_);
+
+    T* a = elements_.data();
+    const int n = rows_;
+    kernel::parallel_for(0, (n + TILE - 1) / TILE, std::max(1, row_grain(n) / TILE), [=](int begin, int end)
+                         {
+        for (int i = begin * TILE; i < std::min(end * TILE, n); i += TILE)
         {
-            result[j][i] = (*this)[i][j];
-        }
-    }
-    return result;
+            const int mi = std::min(TILE, n - i);
+            // diagonal tile
+            for (int r = 0; r < mi; r++)
+            {
+                for (int c = r + 1; c < mi; c++)
+                {
+                    std::swap(a[std::ptrdiff_t(i + r) * n + i + c], a[std::ptrdiff_t(i + c) * n + i + r]);
+                }
+            }
+            // tiles right of the diagonal swap with their mirror below it
+            for (int j = i + TILE; j < n; j += TILE)
+            {
+                const int mj = std::min(TILE, n - j);
+                for (int r = 0; r < mi; r++)
+                {
+                    for (int c = 0; c < mj; c++)
+                    {
+                        std::swap(a[std::ptrdiff_t(i + r) * n + j + c], a[std::ptrdiff_t(j + c) * n + i + r]);
+                    }
+                }
+            }
+        } });
+    return *this;
 }
 
-Matrix Matrix::eye(int n)
+template <typename T>
+BasicMatrix<T> BasicMatrix<T>::eye(int n)
 {
-    return Matrix(n, n, 0).map([](int r, int c, double& e)
-                               { e = (r == c ? 1 : 0); });
+    BasicMatrix identity(n, n, 0);
+    for (int i = 0; i < n; i++)
+    {
+        identity.elements_[std::size_t(i) * n + i] = 1;
+    }
+    return identity;
 }
 
-Matrix operator+(const Matrix& a, const Matrix& b)
+template <typename T>
+BasicMatrix<T> dot(const BasicMatrix<T>& a, const BasicMatrix<T>& b)
 {
-    return Matrix(a) += b;
+    utility::check_size(a.col_size(), b.row_size());
+
+    BasicMatrix<T> result(a.row_size(), b.col_size(), 0);
+    kernel::gemm(a.row_size(), b.col_size(), a.col_size(), a.data(), a.col_size(), b.data(), b.col_size(), result.data(), result.col_size());
+    return result;
 }
 
-Matrix operator-(const Matrix& a, const Matrix& b)
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const BasicMatrix<T>& matrix)
 {
-    return Matrix(a) -= b;
+    text::Writer writer(os);
+    print(writer, matrix);
+    return os;
 }
 
-Matrix operator*(const Matrix& a, const Matrix& b)
+// Copy the viewed elements into a row-major array, the work space of an elimination.
+template <typename T>
+static std::vector<std::remove_const_t<T>> elements(const BasicMatrixView<T>& view)
 {
-    return Matrix(a) *= b;
+    std::vector<std::remove_const_t<T>> a(std::size_t(view.row_size()) * view.col_size());
+    for (int r = 0; r < view.row_size(); r++)
+    {
+        const T* row = view.data() + std::ptrdiff_t(r) * view.stride();
+        std::copy(row, row + view.col_size(), a.begin() + std::ptrdiff_t(r) * view.col_size());
+    }
+    return a;
 }
 
-Matrix operator*(const Matrix& m, const double c)
+template <typename T>
+int BasicMatrixView<T>::rank() const
 {
-    return Matrix(m) *= c;
+    return pivoted_rank(elements(*this), rows_, cols_, -1);
 }
 
-Matrix operator*(const double c, const Matrix& m)
+template <typename T>
+int BasicMatrixView<T>::rank(double tolerance) const
 {
-    return m * c;
+    return pivoted_rank(elements(*this), rows_, cols_, tolerance);
 }
 
-Matrix dot(const Matrix& a, const Matrix& b)
+template <typename T>
+BasicMatrix<std::remove_const_t<T>> BasicMatrixView<T>::transpose() const
 {
-    utility::check_size(a.col_size(), b.row_size());
+    BasicMatrix<value_type> result(cols_, rows_, 0);
 
-    Matrix result(a.row_size(), b.col_size(), 0);
-    Matrix mt = b.transpose();
-    for (int r = 0; r < a.row_size(); r++)
-    {
-        for (int c = 0; c < b.col_size(); c++)
+    const T* src = data_;
+    value_type* dst = result.data();
+    const int rows = rows_, cols = cols_, stride = stride_;
+    kernel::parallel_for(0, (rows_ + TILE - 1) / TILE, std::max(1, row_grain(cols_) / TILE), [=](int begin, int end)
+                         {
+        for (int i = begin * TILE; i < std::min(end * TILE, rows); i += TILE)
         {
-            result[r][c] = dot(a[r], mt[c]);
-        }
-    }
+            for (int j = 0; j < cols; j += TILE)
+            {
+                transpose_tile(std::min(TILE, rows - i), std::min(TILE, cols - j),
+                               src + std::ptrdiff_t(i) * stride + j, stride,
+                               dst + std::ptrdiff_t(j) * rows + i, rows);
+            }
+        } });
     return result;
 }
 
+Matrix dot(const Matrix& a, const Matrix& b)
+{
+    return dot<double>(a, b);
+}
+
 std::ostream& operator<<(std::ostream& os, const Matrix& matrix)
 {
-    return os << matrix.to_string();
+    return operator<< <double>(os, matrix);
 }
 
+#define MLA_INSTANTIATE_MATRIX(T)                                                      \
+    template class BasicMatrix<T>;                                                     \
+    template BasicMatrix<T> dot<T>(const BasicMatrix<T>& a, const BasicMatrix<T>& b);  \
+    template std::ostream& operator<<(std::ostream& os, const BasicMatrix<T>& matrix); \
+    template int BasicMatrixView<T>::rank() const;                                     \
+    template int BasicMatrixView<const T>::rank() const;                               \
+    template int BasicMatrixView<T>::rank(double tolerance) const;                     \
+    template int BasicMatrixView<const T>::rank(double tolerance) const;               \
+    template BasicMatrix<T> BasicMatrixView<T>::transpose() const;                     \
+    template BasicMatrix<T> BasicMatrixView<const T>::transpose() const;
+
+MLA_INSTANTIATE_MATRIX(float)
+MLA_INSTANTIATE_MATRIX(double)
+MLA_INSTANTIATE_MATRIX(std::complex<double>)
+
+#undef MLA_INSTANTIATE_MATRIX
+
 } // namespace mla
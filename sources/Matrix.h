@@ -1,7 +1,7 @@
 /**
  * @file Matrix.h
  * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
- * @brief Matrix class.
+ * @brief Matrix class template.
  * @version 1.0
  * @date 2023.10.26
  *
@@ -11,21 +11,64 @@
 #ifndef MATRIX_H
 #define MATRIX_H
 
+#include <algorithm>   // std::max
+#include <new>         // placement new
+#include <type_traits> // std::is_invocable_v
+#include <vector>      // std::vector
+
 #include "Vector.h"
+#include "VectorView.h"
+#include "parallel.h"
 
 namespace mla
 {
 
+class Cholesky;
+
+template <typename T>
+class BasicLU;
+
+using LU = BasicLU<double>;
+
+class QR;
+
+template <typename T>
+class BasicMatrixView;
+
+using MatrixView = BasicMatrixView<double>;
+
+using ConstMatrixView = BasicMatrixView<const double>;
+
 /**
- * @brief Matrix class.
+ * @brief Matrix class template.
+ *
+ * Instantiated for float, double and std::complex<double>, see BasicVector. The Cholesky and QR
+ * factorizations are only provided for double.
+ *
+ * The elements are ALIGNMENT aligned and come from the memory resource of the constructing thread, see set_memory_resource().
+ *
+ * @tparam T scalar type of the elements
  */
-class Matrix
+template <typename T>
+class BasicMatrix
 {
 private:
-    // Each element is a row vector.
-    std::vector<Vector> rows_;
+    // Elements stored contiguously in row-major order.
+    std::vector<T, Allocator<T>> elements_;
+
+    // Number of rows.
+    int rows_;
+
+    // Number of columns, which is also the distance between the starts of two adjacent rows.
+    int cols_;
 
 public:
+    // Scalar type of the elements.
+    using value_type = T;
+
+    template <typename U>
+    class RowIterator;
+
     /*
      * Constructor / Destructor
      */
@@ -33,14 +76,14 @@ public:
     /**
      * @brief Construct a new matrix object.
      */
-    Matrix();
+    BasicMatrix();
 
     /**
      * @brief Construct a matrix based on the given initializer list.
      *
      * @param il initializer list
      */
-    Matrix(const std::initializer_list<Vector>& il);
+    BasicMatrix(const std::initializer_list<BasicVector<T>>& il);
 
     /**
      * @brief Construct a matrix with row x col identical elements.
@@ -49,21 +92,36 @@ public:
      * @param col number of columns
      * @param element fill element
      */
-    Matrix(int row, int col, double element);
+    BasicMatrix(int row, int col, const T& element);
 
     /**
      * @brief Copy constructor.
      *
      * @param that another matrix
      */
-    Matrix(const Matrix& that);
+    BasicMatrix(const BasicMatrix& that);
 
     /**
      * @brief Move constructor.
      *
      * @param that another matrix
      */
-    Matrix(Matrix&& that);
+    BasicMatrix(BasicMatrix&& that) noexcept;
+
+    /**
+     * @brief Construct a matrix by evaluating an expression in a single pass.
+     *
+     * @param expression a matrix expression
+     */
+    template <typename Node>
+    BasicMatrix(const MatrixExpression<Node>& expression);
+
+    /**
+     * @brief Construct a matrix by copying the elements of a view.
+     *
+     * @param view a view of a matrix
+     */
+    explicit BasicMatrix(BasicMatrixView<const T> view);
 
     /*
      * Comparison
@@ -75,7 +133,7 @@ public:
      * @param that another matrix
      * @return true if two matrices are equal
      */
-    bool operator==(const Matrix& that) const;
+    bool operator==(const BasicMatrix& that) const;
 
     /**
      * @brief Check whether two matrices are not equal.
@@ -83,7 +141,7 @@ public:
      * @param that another matrix
      * @return true if two matrices are not equal
      */
-    bool operator!=(const Matrix& that) const;
+    bool operator!=(const BasicMatrix& that) const;
 
     /*
      * Assignment
@@ -95,35 +153,98 @@ public:
      * @param that another matrix
      * @return self reference
      */
-    Matrix& operator=(const Matrix& that);
+    BasicMatrix& operator=(const BasicMatrix& that);
 
     /**
      * @brief Move assignment operator.
      *
+     * The elements are copied if that uses another memory resource, so unlike the move constructor it may allocate.
+     *
      * @param that another matrix
      * @return self reference
      */
-    Matrix& operator=(Matrix&& that);
+    BasicMatrix& operator=(BasicMatrix&& that);
+
+    /**
+     * @brief Evaluate an expression in a single pass and assign the result.
+     *
+     * @param expression a matrix expression
+     * @return self reference
+     */
+    template <typename Node>
+    BasicMatrix& operator=(const MatrixExpression<Node>& expression);
 
     /*
      * Access
      */
 
     /**
-     * @brief Return the reference to the row at the specified position.
+     * @brief Return the view of the row at the specified position.
+     *
+     * The index is checked unless MLA_NO_BOUNDS_CHECK is defined for the whole project.
+     *
+     * @param index index of the row to return
+     * @return view of the row at the specified position
+     */
+    BasicVectorView<T> operator[](int index);
+
+    /**
+     * @brief Return the read-only view of the row at the specified position.
+     *
+     * The index is checked unless MLA_NO_BOUNDS_CHECK is defined for the whole project.
      *
      * @param index index of the row to return
-     * @return reference to the row at the specified position
+     * @return read-only view of the row at the specified position
      */
-    Vector& operator[](int index);
+    BasicVectorView<const T> operator[](int index) const;
 
     /**
-     * @brief Return the const reference to row at the specified position.
+     * @brief Return the view of the row at the specified position, the index is always checked.
      *
      * @param index index of the row to return
-     * @return const reference to the row at the specified position
+     * @return view of the row at the specified position
+     */
+    BasicVectorView<T> at(int index);
+
+    /**
+     * @brief Return the read-only view of the row at the specified position, the index is always checked.
+     *
+     * @param index index of the row to return
+     * @return read-only view of the row at the specified position
+     */
+    BasicVectorView<const T> at(int index) const;
+
+    /**
+     * @brief Return the reference to the element at the specified position, the indexes are always checked.
+     *
+     * @param row index of the row
+     * @param col index of the column
+     * @return reference to the element at the specified position
      */
-    const Vector& operator[](int index) const;
+    T& at(int row, int col);
+
+    /**
+     * @brief Return the const reference to the element at the specified position, the indexes are always checked.
+     *
+     * @param row index of the row
+     * @param col index of the column
+     * @return const reference to the element at the specified position
+     */
+    const T& at(int row, int col) const;
+
+    /**
+     * @brief Return the pointer to the first element, the rows are stored contiguously.
+     *
+     * @return pointer to the first element
+     */
+    T* data();
+
+    /**
+     * @brief Return the const pointer to the first element, the rows are stored contiguously.
+     *
+     * @return const pointer to the first element
+     */
+    const T* data() const;
 
     /*
      * Iterator
@@ -134,28 +255,28 @@ public:
      *
      * @return iterator to the first row
      */
-    std::vector<Vector>::iterator begin();
+    RowIterator<T> begin();
 
     /**
      * @brief Return a const iterator to the first row.
      *
      * @return const iterator to the first row
      */
-    std::vector<Vector>::const_iterator begin() const;
+    RowIterator<const T> begin() const;
 
     /**
      * @brief Return an iterator to the row following the last row.
      *
      * @return iterator to the row following the last row
      */
-    std::vector<Vector>::iterator end();
+    RowIterator<T> end();
 
     /**
      * @brief Return a const iterator to the row following the last row.
      *
      * @return const iterator to the row following the last row
      */
-    std::vector<Vector>::const_iterator end() const;
+    RowIterator<const T> end() const;
 
     /*
      * Examination (will not change the object itself)
@@ -183,25 +304,63 @@ public:
     std::string to_string() const;
 
     /**
-     * @brief Calculate the rank of this matrix.
+     * @brief Calculate the rank of this matrix, by elimination with complete pivoting.
+     *
+     * Pivots below max(rows, cols) * epsilon * max|a| are treated as zero.
      *
      * @return the rank of this matrix
      */
     int rank() const;
 
+    /**
+     * @brief Calculate the rank of this matrix, by elimination with complete pivoting.
+     *
+     * The elimination stops at the first pivot whose magnitude is not above the tolerance.
+     *
+     * @param tolerance largest magnitude of a pivot treated as zero
+     * @return the rank of this matrix
+     */
+    int rank(double tolerance) const;
+
     /**
      * @brief Compute the determinant of this matrix.
      *
+     * Eliminates on the diagonal and exchanges rows only for a zero pivot, like elimination by hand,
+     * so small integer matrices give exact results. lu() pivots for stability instead.
+     *
      * @return the determinant of this matrix
      */
-    double det() const;
+    T det() const;
 
     /**
-     * @brief Compute the inverse of this matrix.
+     * @brief Compute the inverse of this matrix, with the elimination of det().
+     *
+     * Only an exactly zero pivot makes the matrix singular.
      *
      * @return the inverse of this matrix
      */
-    Matrix inv() const;
+    BasicMatrix inv() const;
+
+    /**
+     * @brief Compute the LU factorization with partial pivoting of this matrix.
+     *
+     * @return the LU factorization of this matrix
+     */
+    BasicLU<T> lu() const;
+
+    /**
+     * @brief Compute the Cholesky factorization of this symmetric positive definite matrix.
+     *
+     * @return the Cholesky factorization of this matrix
+     */
+    Cholesky cholesky() const;
+
+    /**
+     * @brief Compute the QR factorization of this square or tall matrix.
+     *
+     * @return the QR factorization of this matrix
+     */
+    QR qr() const;
 
     /*
      * Manipulation (will change the object itself)
@@ -213,7 +372,7 @@ public:
      * @param matrix another matrix
      * @return self reference
      */
-    Matrix& append_row(const Matrix& matrix);
+    BasicMatrix& append_row(const BasicMatrix& matrix);
 
     /**
      * @brief Expand this matrix by columns.
@@ -221,7 +380,7 @@ public:
      * @param matrix another matrix
      * @return self reference
      */
-    Matrix& append_col(const Matrix& matrix);
+    BasicMatrix& append_col(const BasicMatrix& matrix);
 
     /**
      * @brief Addition.
@@ -229,7 +388,16 @@ public:
      * @param matrix another matrix
      * @return self reference
      */
-    Matrix& operator+=(const Matrix& matrix);
+    BasicMatrix& operator+=(const BasicMatrix& matrix);
+
+    /**
+     * @brief Addition of an expression, evaluated in the same pass.
+     *
+     * @param expression a matrix expression
+     * @return self reference
+     */
+    template <typename Node>
+    BasicMatrix& operator+=(const MatrixExpression<Node>& expression);
 
     /**
      * @brief Difference.
@@ -237,7 +405,16 @@ public:
      * @param matrix another matrix
      * @return self reference
      */
-    Matrix& operator-=(const Matrix& matrix);
+    BasicMatrix& operator-=(const BasicMatrix& matrix);
+
+    /**
+     * @brief Difference of an expression, evaluated in the same pass.
+     *
+     * @param expression a matrix expression
+     * @return self reference
+     */
+    template <typename Node>
+    BasicMatrix& operator-=(const MatrixExpression<Node>& expression);
 
     /**
      * @brief Hadamard product (entrywise product).
@@ -245,7 +422,7 @@ public:
      * @param matrix another matrix
      * @return self reference
      */
-    Matrix& operator*=(const Matrix& matrix);
+    BasicMatrix& operator*=(const BasicMatrix& matrix);
 
     /**
      * @brief Scalar multiplication.
@@ -253,7 +430,7 @@ public:
      * @param c a number
      * @return self reference
      */
-    Matrix& operator*=(const double c);
+    BasicMatrix& operator*=(const T& c);
 
     /**
      * @brief Elementary Row Operations: Row Swap.
@@ -262,7 +439,7 @@ public:
      * @param j index of the second row
      * @return self reference
      */
-    Matrix& E(int i, int j);
+    BasicMatrix& E(int i, int j);
 
     /**
      * @brief Elementary Row Operations: Scalar Multiplication.
@@ -271,7 +448,7 @@ public:
      * @param k multiplication factor
      * @return self reference
      */
-    Matrix& E(int i, double k);
+    BasicMatrix& E(int i, const T& k);
 
     /**
      * @brief Elementary Row Operations: Row Sum.
@@ -281,49 +458,112 @@ public:
      * @param k multiplication factor
      * @return self reference
      */
-    Matrix& E(int i, int j, double k);
+    BasicMatrix& E(int i, int j, const T& k);
 
     /**
      * @brief Transform this matrix to general row echelon form.
      *
      * @return self reference
      */
-    Matrix& transform_row_echelon();
+    BasicMatrix& transform_row_echelon();
+
+    /**
+     * @brief Transpose this square matrix in place.
+     *
+     * @return self reference
+     */
+    BasicMatrix& transpose_inplace();
 
     /**
      * @brief Traverse matrix elements and perform action.
      *
-     * @param action a function takes 3 args: row, col, element ref
+     * Any callable is accepted and inlined into the loop. One taking only the element runs over the storage
+     * as a flat array, which the compiler can vectorize. By default the elements are visited in row-major order
+     * on the calling thread, so action may update captured state. If parallel is true the rows of a large matrix
+     * are split across threads and action may be called concurrently, so it must not write shared state.
+     *
+     * @param action a callable takes 3 args: row, col, element ref, or 1 arg: element ref
+     * @param parallel whether action may be called from several threads at once, false by default
      * @return self reference
      */
-    Matrix& map(void (*action)(int row, int col, double& e));
+    template <typename F>
+    BasicMatrix& map(F&& action, bool parallel = false);
+
+    /**
+     * @brief Traverse matrix elements in row-major order on the calling thread.
+     *
+     * @param action a callable takes 3 args: row, col, element const ref, or 1 arg: element const ref
+     * @return self const reference
+     */
+    template <typename F>
+    const BasicMatrix& for_each(F&& action) const;
 
     /*
      * Production (will produce new object)
      */
 
+    /**
+     * @brief Return the view of the whole matrix, without copying.
+     *
+     * @return the view of the whole matrix
+     */
+    BasicMatrixView<T> view();
+
+    /**
+     * @brief Return the read-only view of the whole matrix, without copying.
+     *
+     * @return the read-only view of the whole matrix
+     */
+    BasicMatrixView<const T> view() const;
+
+    /**
+     * @brief Return the view of a block of this matrix, without copying.
+     *
+     * @param row index of the first row of the block
+     * @param col index of the first column of the block
+     * @param rows number of rows of the block
+     * @param cols number of columns of the block
+     * @return the view of the block
+     */
+    BasicMatrixView<T> block(int row, int col, int rows, int cols);
+
+    /**
+     * @brief Return the read-only view of a block of this matrix, without copying.
+     *
+     * @param row index of the first row of the block
+     * @param col index of the first column of the block
+     * @param rows number of rows of the block
+     * @param cols number of columns of the block
+     * @return the read-only view of the block
+     */
+    BasicMatrixView<const T> block(int row, int col, int rows, int cols) const;
+
     /**
      * @brief Split this matrix by rows.
      *
+     * Returns copies, use view().split_row(n) to split without copying.
+     *
      * @param n the row index
      * @return split matrix pair
      */
-    std::pair<Matrix, Matrix> split_row(int n) const;
+    std::pair<BasicMatrix, BasicMatrix> split_row(int n) const;
 
     /**
      * @brief Split this matrix by columns.
      *
+     * Returns copies, use view().split_col(n) to split without copying.
+     *
      * @param n the column index
      * @return split matrix pair
      */
-    std::pair<Matrix, Matrix> split_col(int n) const;
+    std::pair<BasicMatrix, BasicMatrix> split_col(int n) const;
 
     /**
      * @brief Returns the transpose of the matrix.
      *
      * @return the transpose of the matrix
      */
-    Matrix transpose() const;
+    BasicMatrix transpose() const;
 
     /**
      * @brief Generate an n-order unit matrix.
@@ -331,57 +571,216 @@ public:
      * @param n number of rows (and columns)
      * @return an n-order unit matrix
      */
-    static Matrix eye(int n);
+    static BasicMatrix eye(int n);
+};
+
+using Matrix = BasicMatrix<double>;
+
+template <>
+Cholesky BasicMatrix<double>::cholesky() const;
+
+template <>
+QR BasicMatrix<double>::qr() const;
+
+/**
+ * @brief Iterator over the rows of a matrix, dereferences to a row view.
+ *
+ * @tparam U scalar type for a mutable iterator, such as `double`, or its const version for a read-only iterator
+ */
+template <typename T>
+template <typename U>
+class BasicMatrix<T>::RowIterator
+{
+private:
+    // Pointer to the first element of the matrix.
+    U* data_;
+
+    // Number of columns of the matrix.
+    int cols_;
+
+    // Distance between the starts of two adjacent rows.
+    int stride_;
+
+    // Index of the current row.
+    int index_;
+
+    // View of the row last dereferenced, so operator*() returns a reference and `for (auto& row : matrix)` works.
+    mutable BasicVectorView<U> row_;
+
+public:
+    RowIterator(U* data, int cols, int stride, int index)
+        : data_(data)
+        , cols_(cols)
+        , stride_(stride)
+        , index_(index)
+        , row_(data, 0)
+    {
+    }
+
+    const BasicVectorView<U>& operator*() const
+    {
+        // assignment through a view copies elements, so construct the current row in place to rebind it
+        new (&row_) BasicVectorView<U>(data_ + std::ptrdiff_t(index_) * stride_, cols_);
+        return row_;
+    }
+
+    const BasicVectorView<U>* operator->() const
+    {
+        return &**this;
+    }
+
+    RowIterator& operator++()
+    {
+        ++index_;
+        return *this;
+    }
+
+    RowIterator operator++(int)
+    {
+        RowIterator it = *this;
+        ++index_;
+        return it;
+    }
+
+    RowIterator& operator--()
+    {
+        --index_;
+        return *this;
+    }
+
+    RowIterator operator--(int)
+    {
+        RowIterator it = *this;
+        --index_;
+        return it;
+    }
+
+    bool operator==(const RowIterator& that) const
+    {
+        return data_ == that.data_ && index_ == that.index_;
+    }
+
+    bool operator!=(const RowIterator& that) const
+    {
+        return !(*this == that);
+    }
 };
 
 /*
  * Arithmetic
  */
 
+// Whether T is a matrix or a matrix expression.
+template <typename T>
+struct is_matrix_operand : std::false_type
+{
+};
+
+template <typename T>
+struct is_matrix_operand<BasicMatrix<T>> : std::true_type
+{
+};
+
+template <typename E>
+struct is_matrix_operand<MatrixExpression<E>> : std::true_type
+{
+};
+
+template <typename T>
+constexpr bool is_matrix_operand_v = is_matrix_operand<std::decay_t<T>>::value;
+
+// Matrices and matrix expressions of the same scalar type, possibly references.
+template <typename T, typename... Ts>
+using enable_if_matrix_operands = std::enable_if_t<is_matrix_operand_v<T> && (is_matrix_operand_v<Ts> && ...) && (std::is_same_v<typename std::decay_t<T>::value_type, typename std::decay_t<Ts>::value_type> && ...), int>;
+
+// Whether an operand forwarded as T is a temporary matrix, whose storage can take the result.
+template <typename T>
+constexpr bool is_temporary_matrix_v = !std::is_reference_v<T> && !std::is_const_v<T> && std::is_same_v<T, BasicMatrix<typename std::decay_t<T>::value_type>>;
+
+// Whether an operand is a matrix expression rather than a matrix, possibly a reference.
+template <typename T>
+constexpr bool is_matrix_expression_v = is_matrix_operand_v<T> && !std::is_same_v<std::decay_t<T>, BasicMatrix<typename std::decay_t<T>::value_type>>;
+
+/**
+ * @brief Return an expression of a matrix, so the operations applied to it are fused into one pass, see lazy(vector).
+ *
+ * The expression refers to the elements of the matrix, which must outlive it (do not store it with `auto`).
+ *
+ * @param matrix a matrix
+ * @return an expression of the matrix
+ */
+template <typename T>
+MatrixExpression<expr::Leaf<T>> lazy(const BasicMatrix<T>& matrix);
+
 /**
  * @brief Return the addition of two matrices.
  *
- * @param a a matrix
- * @param b another matrix of the same size as a
- * @return the addition of two matrices
+ * @param a a matrix or matrix expression
+ * @param b another matrix or matrix expression of the same size as a
+ * @return the addition of two matrices, held by a temporary operand if there is one, or an expression if an operand is an expression
  */
-Matrix operator+(const Matrix& a, const Matrix& b);
+template <typename A, typename B, enable_if_matrix_operands<A, B> = 0>
+auto operator+(A&& a, B&& b);
 
 /**
  * @brief Return the difference of two matrices.
  *
- * @param a a matrix
- * @param b another matrix of the same size as a
- * @return the difference of two matrices
+ * @param a a matrix or matrix expression
+ * @param b another matrix or matrix expression of the same size as a
+ * @return the difference of two matrices, held by a temporary operand if there is one, or an expression if an operand is an expression
  */
-Matrix operator-(const Matrix& a, const Matrix& b);
+template <typename A, typename B, enable_if_matrix_operands<A, B> = 0>
+auto operator-(A&& a, B&& b);
 
 /**
  * @brief Return the Hadamard product (entrywise product) of two matrices.
  *
- * @param a a matrix
- * @param b another matrix of the same size as a
- * @return the Hadamard product (entrywise product) of two matrices
+ * @param a a matrix or matrix expression
+ * @param b another matrix or matrix expression of the same size as a
+ * @return the Hadamard product (entrywise product) of two matrices, held by a temporary operand if there is one, or an expression if an operand is an expression
  */
-Matrix operator*(const Matrix& a, const Matrix& b);
+template <typename A, typename B, enable_if_matrix_operands<A, B> = 0>
+auto operator*(A&& a, B&& b);
 
 /**
  * @brief Return the scalar multiplication of matrix and number.
  *
- * @param m a matrix
+ * @param m a matrix or matrix expression
  * @param c a number
- * @return the scalar multiplication of matrix and number
+ * @return the scalar multiplication of matrix and number, held by m if it is a temporary, or an expression if m is an expression
  */
-Matrix operator*(const Matrix& m, const double c);
+template <typename M, enable_if_matrix_operands<M> = 0>
+auto operator*(M&& m, const typename std::decay_t<M>::value_type& c);
 
 /**
  * @brief Return the scalar multiplication of matrix and number.
  *
  * @param c a number
- * @param m a matrix
- * @return the scalar multiplication of matrix and number
+ * @param m a matrix or matrix expression
+ * @return the scalar multiplication of matrix and number, held by m if it is a temporary, or an expression if m is an expression
  */
-Matrix operator*(const double c, const Matrix& m);
+template <typename M, enable_if_matrix_operands<M> = 0>
+auto operator*(const typename std::decay_t<M>::value_type& c, M&& m);
+
+/**
+ * @brief Check whether the result of an expression equals a matrix.
+ *
+ * @param a a matrix expression
+ * @param b a matrix
+ * @return true if they are equal
+ */
+template <typename E, typename T>
+bool operator==(const MatrixExpression<E>& a, const BasicMatrix<T>& b);
+
+/**
+ * @brief Check whether the result of an expression does not equal a matrix.
+ *
+ * @param a a matrix expression
+ * @param b a matrix
+ * @return true if they are not equal
+ */
+template <typename E, typename T>
+bool operator!=(const MatrixExpression<E>& a, const BasicMatrix<T>& b);
 
 /**
  * @brief Return the product of two matrices.
@@ -390,7 +789,18 @@ Matrix operator*(const double c, const Matrix& m);
  * @param b another matrix (k rows, n cols)
  * @return the product of two matrices (m rows, n cols)
  */
-Matrix dot(const Matrix& a, const Matrix& b);
+template <typename T>
+BasicMatrix<T> dot(const BasicMatrix<T>& a, const BasicMatrix<T>& b);
+
+/**
+ * @brief Return the product of two matrices or matrix expressions.
+ *
+ * @param a a matrix or matrix expression (m rows, k cols)
+ * @param b another matrix or matrix expression (k rows, n cols)
+ * @return the product of two matrices (m rows, n cols)
+ */
+template <typename A, typename B, enable_if_matrix_operands<A, B> = 0>
+BasicMatrix<typename A::value_type> dot(const A& a, const B& b);
 
 /*
  * Print
@@ -403,8 +813,301 @@ Matrix dot(const Matrix& a, const Matrix& b);
  * @param matrix the matrix to be printed to the output stream
  * @return self reference of the output stream
  */
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const BasicMatrix<T>& matrix);
+
+/*
+ * Overloads for Matrix. Unlike the templates they also take arguments that convert to a Matrix,
+ * such as a double expression or a braced list, see the overloads for Vector.
+ */
+
+Matrix dot(const Matrix& a, const Matrix& b);
+
 std::ostream& operator<<(std::ostream& os, const Matrix& matrix);
 
+template <typename T>
+BasicVectorView<T> BasicMatrix<T>::operator[](int index)
+{
+    utility::check_index(index, rows_);
+
+    return BasicVectorView<T>(elements_.data() + std::size_t(index) * cols_, cols_);
+}
+
+template <typename T>
+BasicVectorView<const T> BasicMatrix<T>::operator[](int index) const
+{
+    utility::check_index(index, rows_);
+
+    return BasicVectorView<const T>(elements_.data() + std::size_t(index) * cols_, cols_);
+}
+
+template <typename T>
+BasicVectorView<T> BasicMatrix<T>::at(int index)
+{
+    utility::check_bounds(index, 0, rows_);
+
+    return BasicVectorView<T>(elements_.data() + std::size_t(index) * cols_, cols_);
+}
+
+template <typename T>
+BasicVectorView<const T> BasicMatrix<T>::at(int index) const
+{
+    utility::check_bounds(index, 0, rows_);
+
+    return BasicVectorView<const T>(elements_.data() + std::size_t(index) * cols_, cols_);
+}
+
+template <typename T>
+T& BasicMatrix<T>::at(int row, int col)
+{
+    utility::check_bounds(row, 0, rows_);
+    utility::check_bounds(col, 0, cols_);
+
+    return elements_[std::size_t(row) * cols_ + col];
+}
+
+template <typename T>
+const T& BasicMatrix<T>::at(int row, int col) const
+{
+    utility::check_bounds(row, 0, rows_);
+    utility::check_bounds(col, 0, cols_);
+
+    return elements_[std::size_t(row) * cols_ + col];
+}
+
+template <typename T>
+template <typename F>
+BasicMatrix<T>& BasicMatrix<T>::map(F&& action, bool parallel)
+{
+    T* data = elements_.data();
+    const int cols = cols_;
+    const auto rows = [&](int begin, int end)
+    {
+        T* e = data + std::ptrdiff_t(begin) * cols;
+        if constexpr (std::is_invocable_v<F&, int, int, T&>)
+        {
+            for (int r = begin; r < end; r++)
+            {
+                for (int c = 0; c < cols; c++)
+                {
+                    action(r, c, *e++);
+                }
+            }
+        }
+        else
+        {
+            // consecutive rows are contiguous, so the chunk is one flat loop
+            T* last = data + std::ptrdiff_t(end) * cols;
+            for (; e != last; ++e)
+            {
+                action(*e);
+            }
+        }
+    };
+
+    if (parallel)
+    {
+        kernel::parallel_for(0, rows_, std::max(1, kernel::PARALLEL_GRAIN / std::max(1, cols_)), rows);
+    }
+    else
+    {
+        rows(0, rows_);
+    }
+    return *this;
+}
+
+template <typename T>
+template <typename F>
+const BasicMatrix<T>& BasicMatrix<T>::for_each(F&& action) const
+{
+    const T* e = elements_.data();
+    if constexpr (std::is_invocable_v<F&, int, int, const T&>)
+    {
+        for (int r = 0; r < rows_; r++)
+        {
+            for (int c = 0; c < cols_; c++)
+            {
+                action(r, c, *e++);
+            }
+        }
+    }
+    else
+    {
+        for (const T* last = e + elements_.size(); e != last; ++e)
+        {
+            action(*e);
+        }
+    }
+    return *this;
+}
+
+template <typename T>
+template <typename Node>
+BasicMatrix<T>::BasicMatrix(const MatrixExpression<Node>& expression)
+    : elements_(std::size_t(expression.row_size()) * expression.col_size())
+    , rows_(expression.row_size())
+    , cols_(expression.col_size())
+{
+    expr::evaluate(expression.node(), int(elements_.size()), data(), [](T& e, const T& v)
+                   { e = v; });
+}
+
+template <typename T>
+template <typename Node>
+BasicMatrix<T>& BasicMatrix<T>::operator=(const MatrixExpression<Node>& expression)
+{
+    // an operand viewing other elements of this matrix would be overwritten before it is read
+    if (expression.node().overlaps(data(), data() + elements_.size()))
+    {
+        return *this = BasicMatrix(expression);
+    }
+
+    elements_.resize(std::size_t(expression.row_size()) * expression.col_size());
+    rows_ = expression.row_size();
+    cols_ = expression.col_size();
+    expr::evaluate(expression.node(), int(elements_.size()), data(), [](T& e, const T& v)
+                   { e = v; });
+    return *this;
+}
+
+template <typename T>
+template <typename Node>
+BasicMatrix<T>& BasicMatrix<T>::operator+=(const MatrixExpression<Node>& expression)
+{
+    utility::check_size(row_size(), expression.row_size());
+    utility::check_size(col_size(), expression.col_size());
+
+    if (expression.node().overlaps(data(), data() + elements_.size()))
+    {
+        return *this += BasicMatrix(expression);
+    }
+
+    expr::evaluate(expression.node(), int(elements_.size()), data(), [](T& e, const T& v)
+                   { e += v; });
+    return *this;
+}
+
+template <typename T>
+template <typename Node>
+BasicMatrix<T>& BasicMatrix<T>::operator-=(const MatrixExpression<Node>& expression)
+{
+    utility::check_size(row_size(), expression.row_size());
+    utility::check_size(col_size(), expression.col_size());
+
+    if (expression.node().overlaps(data(), data() + elements_.size()))
+    {
+        return *this -= BasicMatrix(expression);
+    }
+
+    expr::evaluate(expression.node(), int(elements_.size()), data(), [](T& e, const T& v)
+                   { e -= v; });
+    return *this;
+}
+
+template <typename A, typename B, enable_if_matrix_operands<A, B>>
+BasicMatrix<typename A::value_type> dot(const A& a, const B& b)
+{
+    using T = typename A::value_type;
+    return dot<T>(BasicMatrix<T>(a), BasicMatrix<T>(b));
+}
+
+template <typename T>
+MatrixExpression<expr::Leaf<T>> lazy(const BasicMatrix<T>& matrix)
+{
+    return MatrixExpression<expr::Leaf<T>>(expr::node(matrix), matrix.row_size(), matrix.col_size());
+}
+
+/*
+ * Build the expression of an element-wise binary operation after checking the operands, and evaluate it
+ * into a temporary operand, return it, or evaluate it into a new matrix, like make_vector_expression().
+ */
+template <typename Op, typename A, typename B>
+auto make_matrix_expression(A&& a, B&& b)
+{
+    utility::check_size(a.row_size(), b.row_size());
+    utility::check_size(a.col_size(), b.col_size());
+
+    using Node = expr::Binary<expr::node_t<std::decay_t<A>>, expr::node_t<std::decay_t<B>>, Op>;
+    const MatrixExpression<Node> expression(Node(expr::node(a), expr::node(b)), a.row_size(), a.col_size());
+    if constexpr (is_temporary_matrix_v<A>)
+    {
+        a = expression;
+        return std::move(a);
+    }
+    else if constexpr (is_temporary_matrix_v<B>)
+    {
+        b = expression;
+        return std::move(b);
+    }
+    else if constexpr (is_matrix_expression_v<A> || is_matrix_expression_v<B>)
+    {
+        return expression;
+    }
+    else
+    {
+        return BasicMatrix<typename std::decay_t<A>::value_type>(expression);
+    }
+}
+
+template <typename A, typename B, enable_if_matrix_operands<A, B>>
+auto operator+(A&& a, B&& b)
+{
+    return make_matrix_expression<expr::Add>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template <typename A, typename B, enable_if_matrix_operands<A, B>>
+auto operator-(A&& a, B&& b)
+{
+    return make_matrix_expression<expr::Sub>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template <typename A, typename B, enable_if_matrix_operands<A, B>>
+auto operator*(A&& a, B&& b)
+{
+    return make_matrix_expression<expr::Mul>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template <typename M, enable_if_matrix_operands<M>>
+auto operator*(M&& m, const typename std::decay_t<M>::value_type& c)
+{
+    if constexpr (is_temporary_matrix_v<M>)
+    {
+        m *= c;
+        return std::move(m);
+    }
+    else
+    {
+        using Node = expr::Scale<expr::node_t<std::decay_t<M>>, typename std::decay_t<M>::value_type>;
+        const MatrixExpression<Node> expression(Node(expr::node(m), c), m.row_size(), m.col_size());
+        if constexpr (is_matrix_expression_v<M>)
+        {
+            return expression;
+        }
+        else
+        {
+            return BasicMatrix<typename std::decay_t<M>::value_type>(expression);
+        }
+    }
+}
+
+template <typename M, enable_if_matrix_operands<M>>
+auto operator*(const typename std::decay_t<M>::value_type& c, M&& m)
+{
+    return std::forward<M>(m) * c;
+}
+
+template <typename E, typename T>
+bool operator==(const MatrixExpression<E>& a, const BasicMatrix<T>& b)
+{
+    return BasicMatrix<T>(a) == b;
+}
+
+template <typename E, typename T>
+bool operator!=(const MatrixExpression<E>& a, const BasicMatrix<T>& b)
+{
+    return !(a == b);
+}
+
 } // namespace mla
 
 #endif // MATRIX_H
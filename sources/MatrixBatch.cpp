@@ -0,0 +1,431 @@
+#include "MatrixBatch.h"
+
+#include "parallel.h"
+#include "utility.hpp"
+
+#include <algorithm> // std::copy std::equal std::max std::min
+#include <cmath>     // std::abs
+#include <cstring>   // std::memcpy
+
+namespace mla
+{
+
+constexpr int LANES = MatrixBatch::LANES;
+
+// Number of blocks holding about PARALLEL_GRAIN units of work, given the work per matrix.
+static int block_grain(int work)
+{
+    return std::max(1, kernel::PARALLEL_GRAIN / LANES / std::max(1, work));
+}
+
+// Number of blocks of a batch.
+static int blocks(int size)
+{
+    return (size + LANES - 1) / LANES;
+}
+
+/*
+ * Gaussian elimination with partial pivoting of the LANES systems of a block at once.
+ *
+ * a holds n x n matrices and x holds n x m right-hand sides, element e of lane l at e * LANES + l.
+ * Pivoting is done lane by lane with selects instead of branches, so every loop runs over the lanes.
+ * On return x holds the solutions, det the determinants (zero for singular lanes)
+ * and singular is nonzero for the lanes with an exactly zero pivot.
+ * work holds (n + 3) * LANES doubles.
+ */
+static void eliminate(int n, int m, double* a, double* x, double* det, double* singular, double* work)
+{
+    constexpr int L = LANES;
+    double* inverse = work; // reciprocal of the pivot of each row, n x L
+    double* pivot_row = inverse + std::ptrdiff_t(n) * L;
+    double* best = pivot_row + L;
+    double* factor = best + L;
+
+    for (int l = 0; l < L; l++)
+    {
+        det[l] = 1;
+        singular[l] = 0;
+    }
+
+    auto A = [=](int r, int c)
+    {
+        return a + (std::ptrdiff_t(r) * n + c) * L;
+    };
+    auto X = [=](int r, int c)
+    {
+        return x + (std::ptrdiff_t(r) * m + c) * L;
+    };
+
+    for (int k = 0; k < n; k++)
+    {
+        // the row of the largest candidate of column k, for each lane
+        const double* akk = A(k, k);
+        for (int l = 0; l < L; l++)
+        {
+            pivot_row[l] = k;
+            best[l] = std::abs(akk[l]);
+        }
+        for (int i = k + 1; i < n; i++)
+        {
+            const double* aik = A(i, k);
+            for (int l = 0; l < L; l++)
+            {
+                const bool larger = std::abs(aik[l]) > best[l];
+                best[l] = larger ? std::abs(aik[l]) : best[l];
+                pivot_row[l] = larger ? i : pivot_row[l];
+            }
+        }
+
+        // swap row k with the pivot row, in the lanes that pivot
+        auto swap = [=](double* rk, double* ri, double i)
+        {
+            for (int l = 0; l < L; l++)
+            {
+                const bool pick = pivot_row[l] == i;
+                const double t = rk[l];
+                rk[l] = pick ? ri[l] : t;
+                ri[l] = pick ? t : ri[l];
+            }
+        };
+        for (int i = k + 1; i < n; i++)
+        {
+            for (int j = k; j < n; j++)
+            {
+                swap(A(k, j), A(i, j), i);
+            }
+            for (int j = 0; j < m; j++)
+            {
+                swap(X(k, j), X(i, j), i);
+            }
+        }
+
+        // a zero pivot makes the lane singular, its row is left as it is
+        double* inv = inverse + std::ptrdiff_t(k) * L;
+        for (int l = 0; l < L; l++)
+        {
+            const double pivot = akk[l];
+            const bool zero = pivot == 0;
+            singular[l] = zero ? 1 : singular[l];
+            inv[l] = zero ? 0 : 1 / pivot;
+            det[l] *= pivot_row[l] == k ? pivot : -pivot;
+        }
+
+        // eliminate column k below the pivot
+        for (int i = k + 1; i < n; i++)
+        {
+            const double* aik = A(i, k);
+            for (int l = 0; l < L; l++)
+            {
+                factor[l] = aik[l] * inv[l];
+            }
+            for (int j = k + 1; j < n; j++)
+            {
+                double* aij = A(i, j);
+                const double* akj = A(k, j);
+                for (int l = 0; l < L; l++)
+                {
+                    aij[l] -= factor[l] * akj[l];
+                }
+            }
+            for (int j = 0; j < m; j++)
+            {
+                double* xij = X(i, j);
+                const double* xkj = X(k, j);
+                for (int l = 0; l < L; l++)
+                {
+                    xij[l] -= factor[l] * xkj[l];
+                }
+            }
+        }
+    }
+
+    for (int l = 0; l < L; l++)
+    {
+        det[l] = singular[l] != 0 ? 0 : det[l];
+    }
+
+    // back substitution with the upper triangle
+    for (int i = n - 1; i >= 0; i--)
+    {
+        const double* inv = inverse + std::ptrdiff_t(i) * L;
+        for (int j = 0; j < m; j++)
+        {
+            double* xij = X(i, j);
+            for (int t = i + 1; t < n; t++)
+            {
+                const double* ait = A(i, t);
+                const double* xtj = X(t, j);
+                for (int l = 0; l < L; l++)
+                {
+                    xij[l] -= ait[l] * xtj[l];
+                }
+            }
+            for (int l = 0; l < L; l++)
+            {
+                xij[l] *= inv[l];
+            }
+        }
+    }
+}
+
+/*
+ * Run eliminate() on every block of the batch, split across threads.
+ *
+ * b and x may be null for no right-hand side, det may be null.
+ * Return true if any matrix is singular.
+ */
+static bool eliminate(const MatrixBatch& a, const MatrixBatch* b, MatrixBatch* x, double* det)
+{
+    const int size = a.size();
+    const int n = a.row_size();
+    const int m = b == nullptr ? 0 : b->col_size();
+    std::vector<char> singular(std::size_t(blocks(size)) * LANES, 0);
+    char* flags = singular.data();
+    const double* pa = a.data();
+    const double* pb = b == nullptr ? nullptr : b->data();
+    double* px = x == nullptr ? nullptr : x->data();
+
+    kernel::parallel_for(0, blocks(size), block_grain(n * (n + m) * n), [=](int begin, int end)
+                         {
+        std::vector<double> buffer((std::size_t(n) * n + n + 5) * LANES);
+        double* scratch = buffer.data();
+        double* block_det = scratch + std::ptrdiff_t(n) * n * LANES;
+        double* block_singular = block_det + LANES;
+        double* work = block_singular + LANES;
+        for (int block = begin; block < end; block++)
+        {
+            // the factorization overwrites a scratch copy of A, the right-hand side is solved in place in X
+            std::memcpy(scratch, pa + std::ptrdiff_t(block) * n * n * LANES, sizeof(double) * n * n * LANES);
+            double* block_x = px + std::ptrdiff_t(block) * n * m * LANES;
+            if (m != 0)
+            {
+                std::memcpy(block_x, pb + std::ptrdiff_t(block) * n * m * LANES, sizeof(double) * n * m * LANES);
+            }
+
+            eliminate(n, m, scratch, block_x, block_det, block_singular, work);
+
+            const int lanes = std::min(LANES, size - block * LANES);
+            for (int l = 0; l < lanes; l++)
+            {
+                flags[block * LANES + l] = block_singular[l] != 0;
+            }
+            if (det != nullptr)
+            {
+                std::copy(block_det, block_det + lanes, det + block * LANES);
+            }
+        } });
+
+    return std::find(singular.begin(), singular.end(), 1) != singular.end();
+}
+
+MatrixBatch::MatrixBatch()
+    : elements_()
+    , size_(0)
+    , rows_(0)
+    , cols_(0)
+{
+}
+
+MatrixBatch::MatrixBatch(int size, int row, int col, double element)
+    : elements_(std::size_t(blocks(size)) * row * col * LANES, element)
+    , size_(size)
+    , rows_(row)
+    , cols_(col)
+{
+}
+
+MatrixBatch::MatrixBatch(const std::vector<Matrix>& matrices)
+    : MatrixBatch(int(matrices.size()),
+                  matrices.empty() ? 0 : matrices.front().row_size(),
+                  matrices.empty() ? 0 : matrices.front().col_size(), 0)
+{
+    for (int i = 0; i < size_; i++)
+    {
+        set(i, matrices[i]);
+    }
+}
+
+bool MatrixBatch::operator==(const MatrixBatch& that) const
+{
+    if (size_ != that.size_ || rows_ != that.rows_ || cols_ != that.cols_)
+    {
+        return false;
+    }
+
+    // the padding of the last block is not part of the batch
+    for (int block = 0; block < blocks(size_); block++)
+    {
+        const int lanes = std::min(LANES, size_ - block * LANES);
+        for (int e = 0; e < rows_ * cols_; e++)
+        {
+            const std::ptrdiff_t offset = (std::ptrdiff_t(block) * rows_ * cols_ + e) * LANES;
+            if (!std::equal(data() + offset, data() + offset + lanes, that.data() + offset))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool MatrixBatch::operator!=(const MatrixBatch& that) const
+{
+    return !(*this == that);
+}
+
+double& MatrixBatch::at(int index, int row, int col)
+{
+    utility::check_bounds(index, 0, size_);
+    utility::check_bounds(row, 0, rows_);
+    utility::check_bounds(col, 0, cols_);
+
+    return elements_[((std::size_t(index / LANES) * rows_ + row) * cols_ + col) * LANES + index % LANES];
+}
+
+const double& MatrixBatch::at(int index, int row, int col) const
+{
+    utility::check_bounds(index, 0, size_);
+    utility::check_bounds(row, 0, rows_);
+    utility::check_bounds(col, 0, cols_);
+
+    return elements_[((std::size_t(index / LANES) * rows_ + row) * cols_ + col) * LANES + index % LANES];
+}
+
+double* MatrixBatch::data()
+{
+    return elements_.data();
+}
+
+const double* MatrixBatch::data() const
+{
+    return elements_.data();
+}
+
+Matrix MatrixBatch::get(int index) const
+{
+    utility::check_bounds(index, 0, size_);
+
+    Matrix matrix(rows_, cols_, 0);
+    const double* e = elements_.data() + std::size_t(index / LANES) * rows_ * cols_ * LANES + index % LANES;
+    double* m = matrix.data();
+    for (int i = 0; i < rows_ * cols_; i++)
+    {
+        m[i] = e[std::ptrdiff_t(i) * LANES];
+    }
+    return matrix;
+}
+
+MatrixBatch& MatrixBatch::set(int index, ConstMatrixView matrix)
+{
+    utility::check_bounds(index, 0, size_);
+    utility::check_size(matrix.row_size(), rows_);
+    utility::check_size(matrix.col_size(), cols_);
+
+    double* e = elements_.data() + std::size_t(index / LANES) * rows_ * cols_ * LANES + index % LANES;
+    for (int r = 0; r < rows_; r++)
+    {
+        const double* row = matrix.data() + std::ptrdiff_t(r) * matrix.stride();
+        for (int c = 0; c < cols_; c++)
+        {
+            e[(std::ptrdiff_t(r) * cols_ + c) * LANES] = row[c];
+        }
+    }
+    return *this;
+}
+
+int MatrixBatch::size() const
+{
+    return size_;
+}
+
+int MatrixBatch::row_size() const
+{
+    return rows_;
+}
+
+int MatrixBatch::col_size() const
+{
+    return cols_;
+}
+
+Vector MatrixBatch::det() const
+{
+    // check square matrix
+    utility::check_size(rows_, cols_);
+
+    Vector result(size_, 0);
+    eliminate(*this, nullptr, nullptr, result.data());
+    return result;
+}
+
+MatrixBatch MatrixBatch::inv() const
+{
+    return solve(*this, eye(size_, rows_));
+}
+
+MatrixBatch MatrixBatch::eye(int size, int n)
+{
+    MatrixBatch result(size, n, n, 0);
+    for (int block = 0; block < blocks(size); block++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            std::fill_n(result.data() + ((std::ptrdiff_t(block) * n + i) * n + i) * LANES, LANES, 1);
+        }
+    }
+    return result;
+}
+
+MatrixBatch dot(const MatrixBatch& a, const MatrixBatch& b)
+{
+    utility::check_size(a.size(), b.size());
+    utility::check_size(a.col_size(), b.row_size());
+
+    const int m = a.row_size(), k = a.col_size(), n = b.col_size();
+    MatrixBatch result(a.size(), m, n, 0);
+    const double* pa = a.data();
+    const double* pb = b.data();
+    double* pc = result.data();
+    kernel::parallel_for(0, blocks(a.size()), block_grain(m * n * k), [=](int begin, int end)
+                         {
+        for (int block = begin; block < end; block++)
+        {
+            const double* ba = pa + std::ptrdiff_t(block) * m * k * LANES;
+            const double* bb = pb + std::ptrdiff_t(block) * k * n * LANES;
+            double* bc = pc + std::ptrdiff_t(block) * m * n * LANES;
+            for (int i = 0; i < m; i++)
+            {
+                for (int j = 0; j < n; j++)
+                {
+                    double* cij = bc + (std::ptrdiff_t(i) * n + j) * LANES;
+                    for (int t = 0; t < k; t++)
+                    {
+                        const double* ait = ba + (std::ptrdiff_t(i) * k + t) * LANES;
+                        const double* btj = bb + (std::ptrdiff_t(t) * n + j) * LANES;
+                        for (int l = 0; l < LANES; l++)
+                        {
+                            cij[l] += ait[l] * btj[l];
+                        }
+                    }
+                }
+            }
+        } });
+    return result;
+}
+
+MatrixBatch solve(const MatrixBatch& a, const MatrixBatch& b)
+{
+    // check square matrix
+    utility::check_size(a.row_size(), a.col_size());
+    utility::check_size(a.size(), b.size());
+    utility::check_size(a.row_size(), b.row_size());
+
+    MatrixBatch x(b.size(), b.row_size(), b.col_size(), 0);
+    if (eliminate(a, &b, &x, nullptr))
+    {
+        throw std::runtime_error("Error: Singular matrix.");
+    }
+    return x;
+}
+
+} // namespace mla
@@ -0,0 +1,227 @@
+/**
+ * @file MatrixBatch.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief Batch of small matrices class.
+ * @version 1.0
+ * @date 2026.10.16
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef MATRIX_BATCH_H
+#define MATRIX_BATCH_H
+
+#include "Matrix.h"
+#include "MatrixView.h"
+
+namespace mla
+{
+
+/**
+ * @brief Many matrices of the same small shape, such as thousands of 3x3 to 8x8 matrices.
+ *
+ * The elements are stored in structure-of-arrays layout, tiled by blocks of LANES matrices:
+ * within a block, element (row, col) of the LANES matrices is contiguous. Every kernel runs the same
+ * instruction over the matrices of a block, so it vectorizes across the matrices instead of inside
+ * a tiny one, and streams through memory one block at a time.
+ */
+class MatrixBatch
+{
+public:
+    // Number of matrices in a block.
+    static constexpr int LANES = 64;
+
+private:
+    // Element (r, c) of matrix i is at ((i / LANES * rows_ + r) * cols_ + c) * LANES + i % LANES.
+    // The last block is padded to LANES matrices.
+    std::vector<double, Allocator<double>> elements_;
+
+    // Number of matrices.
+    int size_;
+
+    // Number of rows of each matrix.
+    int rows_;
+
+    // Number of columns of each matrix.
+    int cols_;
+
+public:
+    /*
+     * Constructor / Destructor
+     */
+
+    /**
+     * @brief Construct an empty batch.
+     */
+    MatrixBatch();
+
+    /**
+     * @brief Construct a batch of size row x col matrices with identical elements.
+     *
+     * @param size number of matrices
+     * @param row number of rows of each matrix
+     * @param col number of columns of each matrix
+     * @param element fill element
+     */
+    MatrixBatch(int size, int row, int col, double element);
+
+    /**
+     * @brief Construct a batch from matrices of the same shape.
+     *
+     * @param matrices matrices of the same shape
+     */
+    explicit MatrixBatch(const std::vector<Matrix>& matrices);
+
+    /*
+     * Comparison
+     */
+
+    /**
+     * @brief Check whether two batches are equal.
+     *
+     * @param that another batch
+     * @return true if two batches are equal
+     */
+    bool operator==(const MatrixBatch& that) const;
+
+    /**
+     * @brief Check whether two batches are not equal.
+     *
+     * @param that another batch
+     * @return true if two batches are not equal
+     */
+    bool operator!=(const MatrixBatch& that) const;
+
+    /*
+     * Access
+     */
+
+    /**
+     * @brief Return the reference to element (row, col) of the matrix at the specified position.
+     *
+     * @param index index of the matrix
+     * @param row index of the row
+     * @param col index of the column
+     * @return reference to the element
+     */
+    double& at(int index, int row, int col);
+
+    /**
+     * @brief Return the const reference to element (row, col) of the matrix at the specified position.
+     *
+     * @param index index of the matrix
+     * @param row index of the row
+     * @param col index of the column
+     * @return const reference to the element
+     */
+    const double& at(int index, int row, int col) const;
+
+    /**
+     * @brief Return the pointer to the first element: element (0, 0) of the LANES matrices of the first block, then (0, 1) and so on.
+     *
+     * @return pointer to the first block
+     */
+    double* data();
+
+    /**
+     * @brief Return the const pointer to the first element: element (0, 0) of the LANES matrices of the first block, then (0, 1) and so on.
+     *
+     * @return const pointer to the first block
+     */
+    const double* data() const;
+
+    /**
+     * @brief Return a copy of the matrix at the specified position.
+     *
+     * @param index index of the matrix
+     * @return a copy of the matrix at the specified position
+     */
+    Matrix get(int index) const;
+
+    /**
+     * @brief Replace the matrix at the specified position.
+     *
+     * @param index index of the matrix
+     * @param matrix a matrix or view of the same shape
+     * @return self reference
+     */
+    MatrixBatch& set(int index, ConstMatrixView matrix);
+
+    /*
+     * Examination (will not change the object itself)
+     */
+
+    /**
+     * @brief Return the number of matrices.
+     *
+     * @return the number of matrices
+     */
+    int size() const;
+
+    /**
+     * @brief Return the number of rows of each matrix.
+     *
+     * @return the number of rows of each matrix
+     */
+    int row_size() const;
+
+    /**
+     * @brief Return the number of columns of each matrix.
+     *
+     * @return the number of columns of each matrix
+     */
+    int col_size() const;
+
+    /**
+     * @brief Compute the determinant of each square matrix, zero for the singular ones.
+     *
+     * @return the determinants
+     */
+    Vector det() const;
+
+    /*
+     * Production (will produce new object)
+     */
+
+    /**
+     * @brief Compute the inverse of each square matrix.
+     *
+     * @return the inverses
+     */
+    MatrixBatch inv() const;
+
+    /**
+     * @brief Generate a batch of n-order unit matrices.
+     *
+     * @param size number of matrices
+     * @param n number of rows (and columns) of each matrix
+     * @return a batch of n-order unit matrices
+     */
+    static MatrixBatch eye(int size, int n);
+};
+
+/*
+ * Arithmetic
+ */
+
+/**
+ * @brief Return the product of each pair of matrices.
+ *
+ * @param a a batch (m rows, k cols)
+ * @param b another batch of the same size (k rows, n cols)
+ * @return the products (m rows, n cols)
+ */
+MatrixBatch dot(const MatrixBatch& a, const MatrixBatch& b);
+
+/**
+ * @brief Solve the linear systems AX = B of each pair of matrices, by elimination with partial pivoting.
+ *
+ * @param a a batch of square matrices
+ * @param b a batch of the same size, with as many rows as a
+ * @return the solutions X
+ */
+MatrixBatch solve(const MatrixBatch& a, const MatrixBatch& b);
+
+} // namespace mla
+
+#endif // MATRIX_BATCH_H
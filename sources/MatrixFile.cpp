@@ -0,0 +1,307 @@
+#include "MatrixFile.h"
+
+#include <climits>   // INT_MAX
+#include <complex>   // std::complex
+#include <cstdint>   // std::uint32_t std::uint64_t
+#include <cstring>   // std::memcmp std::memcpy
+#include <fstream>   // std::ifstream std::ofstream
+#include <stdexcept> // std::runtime_error
+#include <tuple>     // std::tie
+#include <utility>   // std::pair std::swap
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+#endif
+
+namespace mla
+{
+
+static constexpr char MAGIC[8] = {'M', 'L', 'A', 'M', 'A', 'T', 'R', 'X'};
+
+static constexpr std::uint32_t VERSION = 1;
+
+static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+static constexpr std::uint32_t ROW_MAJOR = 0;
+
+// Header of a matrix file, see MatrixFile.h.
+struct Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t dtype;
+    std::uint32_t layout;
+    std::uint64_t rows;
+    std::uint64_t cols;
+    char reserved[24];
+};
+
+static_assert(sizeof(Header) == ALIGNMENT, "the payload must start ALIGNMENT aligned");
+
+// Code of a scalar type in the header.
+template <typename T>
+static constexpr std::uint32_t dtype()
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        return 1;
+    }
+    else if constexpr (std::is_same_v<T, double>)
+    {
+        return 2;
+    }
+    else
+    {
+        static_assert(std::is_same_v<T, std::complex<double>>, "unsupported scalar type");
+        return 3;
+    }
+}
+
+// Check the header of a file of the specified size holding elements of type T.
+template <typename T>
+static void check_header(const Header& header, std::uint64_t file_size)
+{
+    if (file_size < sizeof(Header) || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION)
+    {
+        throw std::runtime_error("Error: Not a matrix file.");
+    }
+    if (header.byte_order != BYTE_ORDER_MARK)
+    {
+        throw std::runtime_error("Error: The matrix file has another byte order.");
+    }
+    if (header.dtype != dtype<T>())
+    {
+        throw std::runtime_error("Error: The matrix file has another element type.");
+    }
+    if (header.layout != ROW_MAJOR)
+    {
+        throw std::runtime_error("Error: Unsupported matrix file layout.");
+    }
+    if (header.rows > INT_MAX || header.cols > INT_MAX || (header.cols != 0 && (file_size - sizeof(Header)) / sizeof(T) / header.cols < header.rows))
+    {
+        throw std::runtime_error("Error: The matrix file is truncated.");
+    }
+}
+
+template <typename T>
+void save(BasicMatrixView<const T> matrix, const std::string& path)
+{
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.dtype = dtype<T>();
+    header.layout = ROW_MAJOR;
+    header.rows = matrix.row_size();
+    header.cols = matrix.col_size();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (matrix.stride() == matrix.col_size())
+    {
+        file.write(reinterpret_cast<const char*>(matrix.data()), std::streamsize(sizeof(T)) * matrix.row_size() * matrix.col_size());
+    }
+    else
+    {
+        for (int r = 0; r < matrix.row_size(); r++)
+        {
+            file.write(reinterpret_cast<const char*>(matrix.data() + std::ptrdiff_t(r) * matrix.stride()), std::streamsize(sizeof(T)) * matrix.col_size());
+        }
+    }
+
+    file.close();
+    if (!file)
+    {
+        throw std::runtime_error("Error: Failed to write the matrix file.");
+    }
+}
+
+template <typename T>
+BasicMatrix<T> load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        throw std::runtime_error("Error: Failed to open the matrix file.");
+    }
+    const std::uint64_t file_size = file.tellg();
+    file.seekg(0);
+
+    Header header = {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    check_header<T>(header, file_size);
+
+    // the payload is read straight into the elements
+    BasicMatrix<T> matrix(int(header.rows), int(header.cols), T(0));
+    file.read(reinterpret_cast<char*>(matrix.data()), std::streamsize(sizeof(T) * header.rows * header.cols));
+    if (!file)
+    {
+        throw std::runtime_error("Error: Failed to read the matrix file.");
+    }
+    return matrix;
+}
+
+// Map a whole file read-only, return the start of the mapping and its size.
+static std::pair<void*, std::size_t> map_file(const std::string& path)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Error: Failed to open the matrix file.");
+    }
+    LARGE_INTEGER size = {};
+    GetFileSizeEx(file, &size);
+    if (size.QuadPart < LONGLONG(sizeof(Header)))
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Error: Not a matrix file.");
+    }
+
+    // the view keeps the file mapped after both handles are closed
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* data = mapping == nullptr ? nullptr : MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (mapping != nullptr)
+    {
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    if (data == nullptr)
+    {
+        throw std::runtime_error("Error: Failed to map the matrix file.");
+    }
+    return {data, std::size_t(size.QuadPart)};
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Error: Failed to open the matrix file.");
+    }
+    struct stat status = {};
+    if (fstat(fd, &status) != 0 || status.st_size < off_t(sizeof(Header)))
+    {
+        close(fd);
+        throw std::runtime_error("Error: Not a matrix file.");
+    }
+
+    // the mapping keeps the file open after the descriptor is closed
+    void* data = mmap(nullptr, std::size_t(status.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        throw std::runtime_error("Error: Failed to map the matrix file.");
+    }
+    return {data, std::size_t(status.st_size)};
+#endif
+}
+
+static void unmap_file(void* data, std::size_t bytes)
+{
+#ifdef _WIN32
+    (void)bytes;
+    UnmapViewOfFile(data);
+#else
+    munmap(data, bytes);
+#endif
+}
+
+template <typename T>
+BasicMappedMatrix<T>::BasicMappedMatrix()
+    : mapping_(nullptr)
+    , bytes_(0)
+    , rows_(0)
+    , cols_(0)
+{
+}
+
+template <typename T>
+BasicMappedMatrix<T>::BasicMappedMatrix(const std::string& path)
+    : BasicMappedMatrix()
+{
+    // the object is constructed by the delegated constructor, so the destructor unmaps the file if the check throws
+    std::tie(mapping_, bytes_) = map_file(path);
+
+    const Header& header = *static_cast<const Header*>(mapping_);
+    check_header<T>(header, bytes_);
+    rows_ = int(header.rows);
+    cols_ = int(header.cols);
+}
+
+template <typename T>
+BasicMappedMatrix<T>::BasicMappedMatrix(BasicMappedMatrix&& that) noexcept
+    : BasicMappedMatrix()
+{
+    *this = std::move(that);
+}
+
+template <typename T>
+BasicMappedMatrix<T>::~BasicMappedMatrix()
+{
+    if (mapping_ != nullptr)
+    {
+        unmap_file(mapping_, bytes_);
+    }
+}
+
+template <typename T>
+BasicMappedMatrix<T>& BasicMappedMatrix<T>::operator=(BasicMappedMatrix&& that) noexcept
+{
+    std::swap(mapping_, that.mapping_);
+    std::swap(bytes_, that.bytes_);
+    std::swap(rows_, that.rows_);
+    std::swap(cols_, that.cols_);
+    return *this;
+}
+
+template <typename T>
+BasicVectorView<const T> BasicMappedMatrix<T>::operator[](int index) const
+{
+    utility::check_index(index, rows_);
+
+    return BasicVectorView<const T>(data() + std::size_t(index) * cols_, cols_);
+}
+
+template <typename T>
+const T* BasicMappedMatrix<T>::data() const
+{
+    return mapping_ == nullptr ? nullptr : reinterpret_cast<const T*>(static_cast<const char*>(mapping_) + sizeof(Header));
+}
+
+template <typename T>
+BasicMatrixView<const T> BasicMappedMatrix<T>::view() const
+{
+    return BasicMatrixView<const T>(data(), rows_, cols_, cols_);
+}
+
+template <typename T>
+int BasicMappedMatrix<T>::row_size() const
+{
+    return rows_;
+}
+
+template <typename T>
+int BasicMappedMatrix<T>::col_size() const
+{
+    return cols_;
+}
+
+#define MLA_INSTANTIATE_MATRIX_FILE(T)                                               \
+    template void save(BasicMatrixView<const T> matrix, const std::string& path); \
+    template BasicMatrix<T> load(const std::string& path);                        \
+    template class BasicMappedMatrix<T>;
+
+MLA_INSTANTIATE_MATRIX_FILE(float)
+MLA_INSTANTIATE_MATRIX_FILE(double)
+MLA_INSTANTIATE_MATRIX_FILE(std::complex<double>)
+
+#undef MLA_INSTANTIATE_MATRIX_FILE
+
+} // namespace mla
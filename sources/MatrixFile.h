@@ -0,0 +1,197 @@
+/**
+ * @file MatrixFile.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief Binary matrix file format and memory-mapped matrix class.
+ * @version 1.0
+ * @date 2026.10.17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef MATRIX_FILE_H
+#define MATRIX_FILE_H
+
+#include <cstddef> // std::size_t
+#include <string>  // std::string
+
+#include "Matrix.h"
+#include "MatrixView.h"
+
+namespace mla
+{
+
+/*
+ * A matrix file is a 64-byte header followed by the raw elements in row-major order, so the payload
+ * starts ALIGNMENT aligned in the file and in a mapping of it. The header holds, in native byte order:
+ *
+ *   offset  size  field
+ *   0       8     magic "MLAMATRX"
+ *   8       4     format version, 1
+ *   12      4     byte order mark 0x01020304
+ *   16      4     dtype: 1 float, 2 double, 3 std::complex<double>
+ *   20      4     layout: 0 row-major
+ *   24      8     number of rows
+ *   32      8     number of columns
+ *   40      24    reserved, zero
+ */
+
+/**
+ * @brief Write a matrix or view to a binary matrix file, the elements are stored exactly.
+ *
+ * @param matrix a matrix or view
+ * @param path path of the file, replaced if it exists
+ */
+template <typename T>
+void save(BasicMatrixView<const T> matrix, const std::string& path);
+
+/**
+ * @brief Write a matrix to a binary matrix file, the elements are stored exactly.
+ *
+ * @param matrix a matrix
+ * @param path path of the file, replaced if it exists
+ */
+template <typename T>
+void save(const BasicMatrix<T>& matrix, const std::string& path);
+
+/**
+ * @brief Read a matrix from a binary matrix file.
+ *
+ * @tparam T scalar type of the elements, must be the dtype of the file
+ * @param path path of the file
+ * @return the matrix stored in the file
+ */
+template <typename T = double>
+BasicMatrix<T> load(const std::string& path);
+
+/**
+ * @brief Read-only matrix backed by a memory mapping of a binary matrix file.
+ *
+ * Opening maps the file without reading or copying the elements, pages are loaded by the OS when first
+ * touched and shared with other processes mapping the same file. Use view() to pass it to the functions
+ * that take a ConstMatrixView, or construct a Matrix from the view to get a mutable copy.
+ * The file must not be modified while it is mapped.
+ *
+ * @tparam T scalar type of the elements, must be the dtype of the file
+ */
+template <typename T>
+class BasicMappedMatrix
+{
+private:
+    // Start of the mapping, the header of the file.
+    void* mapping_;
+
+    // Size of the mapping in bytes.
+    std::size_t bytes_;
+
+    // Number of rows.
+    int rows_;
+
+    // Number of columns.
+    int cols_;
+
+public:
+    // Scalar type of the elements.
+    using value_type = T;
+
+    /*
+     * Constructor / Destructor
+     */
+
+    /**
+     * @brief Construct an empty matrix that maps nothing.
+     */
+    BasicMappedMatrix();
+
+    /**
+     * @brief Map a binary matrix file.
+     *
+     * @param path path of the file
+     */
+    explicit BasicMappedMatrix(const std::string& path);
+
+    BasicMappedMatrix(const BasicMappedMatrix&) = delete;
+
+    /**
+     * @brief Move constructor, the mapping is transferred.
+     *
+     * @param that another mapped matrix
+     */
+    BasicMappedMatrix(BasicMappedMatrix&& that) noexcept;
+
+    /**
+     * @brief Destroy the object and unmap the file.
+     */
+    ~BasicMappedMatrix();
+
+    /*
+     * Assignment
+     */
+
+    BasicMappedMatrix& operator=(const BasicMappedMatrix&) = delete;
+
+    /**
+     * @brief Move assignment operator, the previous mapping is released.
+     *
+     * @param that another mapped matrix
+     * @return self reference
+     */
+    BasicMappedMatrix& operator=(BasicMappedMatrix&& that) noexcept;
+
+    /*
+     * Access
+     */
+
+    /**
+     * @brief Return the view of the row at the specified position.
+     *
+     * The index is checked unless MLA_NO_BOUNDS_CHECK is defined for the whole project.
+     *
+     * @param index index of the row to return
+     * @return view of the row at the specified position
+     */
+    BasicVectorView<const T> operator[](int index) const;
+
+    /**
+     * @brief Return the pointer to the first element, rows are contiguous.
+     *
+     * @return the pointer to the first element
+     */
+    const T* data() const;
+
+    /**
+     * @brief Return a read-only view of the whole matrix.
+     *
+     * @return a read-only view of the whole matrix
+     */
+    BasicMatrixView<const T> view() const;
+
+    /*
+     * Examination (will not change the object itself)
+     */
+
+    /**
+     * @brief Return the number of rows.
+     *
+     * @return the number of rows
+     */
+    int row_size() const;
+
+    /**
+     * @brief Return the number of columns.
+     *
+     * @return the number of columns
+     */
+    int col_size() const;
+};
+
+using MappedMatrix = BasicMappedMatrix<double>;
+
+template <typename T>
+void save(const BasicMatrix<T>& matrix, const std::string& path)
+{
+    save(BasicMatrixView<const T>(matrix), path);
+}
+
+} // namespace mla
+
+#endif // MATRIX_FILE_H
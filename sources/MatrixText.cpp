@@ -0,0 +1,305 @@
+#include "MatrixText.h"
+
+#include "text.hpp"
+#include "utility.hpp"
+
+#include <algorithm> // std::copy std::transform
+#include <cctype>    // std::tolower
+#include <sstream>   // std::istringstream
+#include <string>    // std::string std::getline
+#include <vector>    // std::vector
+
+namespace mla
+{
+
+template <typename T>
+void write_csv(std::ostream& os, BasicMatrixView<const T> matrix, char delimiter)
+{
+    text::Writer writer(os);
+    for (int r = 0; r < matrix.row_size(); r++)
+    {
+        const T* row = matrix.data() + std::ptrdiff_t(r) * matrix.stride();
+        for (int c = 0; c < matrix.col_size(); c++)
+        {
+            if (c != 0)
+            {
+                writer.put(delimiter);
+            }
+            writer.shortest(row[c]);
+        }
+        writer.put('\n');
+    }
+}
+
+template <typename T>
+BasicMatrix<T> read_csv(std::istream& is, char delimiter)
+{
+    // with a blank delimiter any run of blanks separates two elements
+    const bool blank = delimiter == ' ' || delimiter == '\t';
+
+    std::vector<T> elements;
+    int rows = 0, cols = 0;
+    std::string line;
+    while (std::getline(is, line))
+    {
+        const std::string_view s = text::trim_line(line);
+        const char* p = s.data();
+        const char* end = s.data() + s.size();
+        if (text::skip_blank(p, end) == end)
+        {
+            continue;
+        }
+
+        int count = 0;
+        while (true)
+        {
+            T e;
+            if ((p = text::parse(p, end, e)) == nullptr)
+            {
+                throw std::runtime_error("Error: Invalid CSV data.");
+            }
+            elements.push_back(e);
+            count++;
+
+            p = text::skip_blank(p, end);
+            if (p == end)
+            {
+                break;
+            }
+            if (!blank && *p++ != delimiter)
+            {
+                throw std::runtime_error("Error: Invalid CSV data.");
+            }
+        }
+
+        if (rows++ == 0)
+        {
+            cols = count;
+        }
+        utility::check_size(count, cols);
+    }
+
+    if (rows == 0)
+    {
+        return BasicMatrix<T>();
+    }
+    BasicMatrix<T> matrix(rows, cols, T(0));
+    std::copy(elements.begin(), elements.end(), matrix.data());
+    return matrix;
+}
+
+template <typename T>
+void write_matrix_market(std::ostream& os, BasicMatrixView<const T> matrix)
+{
+    text::Writer writer(os);
+    writer.put("%%MatrixMarket matrix array real general\n");
+    writer.integer(matrix.row_size());
+    writer.put(' ');
+    writer.integer(matrix.col_size());
+    writer.put('\n');
+    for (int c = 0; c < matrix.col_size(); c++)
+    {
+        for (int r = 0; r < matrix.row_size(); r++)
+        {
+            writer.shortest(matrix.data()[std::ptrdiff_t(r) * matrix.stride() + c]);
+            writer.put('\n');
+        }
+    }
+}
+
+void write_matrix_market(std::ostream& os, const SparseMatrix& matrix)
+{
+    text::Writer writer(os);
+    writer.put("%%MatrixMarket matrix coordinate real general\n");
+    writer.integer(matrix.row_size());
+    writer.put(' ');
+    writer.integer(matrix.col_size());
+    writer.put(' ');
+    writer.integer(matrix.nonzero_size());
+    writer.put('\n');
+    for (int r = 0; r < matrix.row_size(); r++)
+    {
+        for (int i = matrix.offsets()[r]; i < matrix.offsets()[r + 1]; i++)
+        {
+            writer.integer(r + 1);
+            writer.put(' ');
+            writer.integer(matrix.indices()[i] + 1);
+            writer.put(' ');
+            writer.shortest(matrix.values()[i]);
+            writer.put('\n');
+        }
+    }
+}
+
+// Symmetry of a Matrix Market matrix, only the lower triangle of a symmetric one is stored.
+enum class Symmetry
+{
+    GENERAL,
+    SYMMETRIC,
+    SKEW_SYMMETRIC,
+};
+
+// Next line that is neither blank nor a comment, false at the end of the stream.
+static bool next_data_line(std::istream& is, std::string& line)
+{
+    while (std::getline(is, line))
+    {
+        const std::string_view s = text::trim_line(line);
+        const char* p = text::skip_blank(s.data(), s.data() + s.size());
+        if (p != s.data() + s.size() && *p != '%')
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Read a Matrix Market stream, call shape(rows, cols) once and then entry(row, col, value) with 0-based indices
+ * for every stored element and for the mirror of the off-diagonal ones of a symmetric matrix.
+ */
+template <typename T, typename Shape, typename Entry>
+static void read_market(std::istream& is, Shape shape, Entry entry)
+{
+    std::string line;
+    std::getline(is, line);
+    std::transform(line.begin(), line.end(), line.begin(), [](unsigned char c)
+                   { return char(std::tolower(c)); });
+
+    std::istringstream banner(line);
+    std::string head, object, format, field, symmetry_name;
+    banner >> head >> object >> format >> field >> symmetry_name;
+    if (head != "%%matrixmarket" || object != "matrix")
+    {
+        throw std::runtime_error("Error: Not a Matrix Market file.");
+    }
+
+    const bool coordinate = format == "coordinate";
+    const bool pattern = field == "pattern";
+    const Symmetry symmetry = symmetry_name == "symmetric"        ? Symmetry::SYMMETRIC
+                              : symmetry_name == "skew-symmetric" ? Symmetry::SKEW_SYMMETRIC
+                                                                  : Symmetry::GENERAL;
+    if ((!coordinate && format != "array") || (field != "real" && field != "double" && field != "integer" && !(pattern && coordinate))
+        || (symmetry == Symmetry::GENERAL && symmetry_name != "general"))
+    {
+        throw std::runtime_error("Error: Unsupported Matrix Market format.");
+    }
+
+    // size line: rows cols, and the number of entries of a coordinate matrix
+    int rows = 0, cols = 0;
+    long long entries = 0;
+    if (!next_data_line(is, line))
+    {
+        throw std::runtime_error("Error: Invalid Matrix Market data.");
+    }
+    const char* p = line.data();
+    const char* end = line.data() + line.size();
+    if ((p = text::parse(p, end, rows)) == nullptr || (p = text::parse(p, end, cols)) == nullptr
+        || (coordinate && text::parse(p, end, entries) == nullptr) || rows < 0 || cols < 0 || entries < 0)
+    {
+        throw std::runtime_error("Error: Invalid Matrix Market data.");
+    }
+    if (!coordinate)
+    {
+        // column-major, the lower triangle of a symmetric matrix, below the diagonal of a skew-symmetric one
+        entries = symmetry == Symmetry::GENERAL          ? (long long)rows * cols
+                  : symmetry == Symmetry::SYMMETRIC      ? (long long)cols * (cols + 1) / 2
+                                                         : (long long)cols * (cols - 1) / 2;
+    }
+    if (symmetry != Symmetry::GENERAL)
+    {
+        utility::check_size(rows, cols);
+    }
+    shape(rows, cols);
+
+    const auto add = [&](int r, int c, T e)
+    {
+        entry(r, c, e);
+        if (symmetry != Symmetry::GENERAL && r != c)
+        {
+            entry(c, r, symmetry == Symmetry::SYMMETRIC ? e : -e);
+        }
+    };
+
+    // position of the next element of an array, in column-major order
+    int r = symmetry == Symmetry::SKEW_SYMMETRIC ? 1 : 0, c = 0;
+    long long count = 0;
+    while (count < entries && next_data_line(is, line))
+    {
+        const std::string_view s = text::trim_line(line);
+        p = s.data();
+        end = s.data() + s.size();
+        if (coordinate)
+        {
+            int i = 0, j = 0;
+            T e = T(1);
+            if ((p = text::parse(p, end, i)) == nullptr || (p = text::parse(p, end, j)) == nullptr || (!pattern && text::parse(p, end, e) == nullptr))
+            {
+                throw std::runtime_error("Error: Invalid Matrix Market data.");
+            }
+            utility::check_bounds(i - 1, 0, rows);
+            utility::check_bounds(j - 1, 0, cols);
+            add(i - 1, j - 1, e);
+            count++;
+            continue;
+        }
+
+        // an array may hold several elements per line
+        while (count < entries && (p = text::skip_blank(p, end)) != end)
+        {
+            T e;
+            if ((p = text::parse(p, end, e)) == nullptr)
+            {
+                throw std::runtime_error("Error: Invalid Matrix Market data.");
+            }
+            add(r, c, e);
+            count++;
+            if (++r == rows)
+            {
+                c++;
+                r = symmetry == Symmetry::GENERAL ? 0 : symmetry == Symmetry::SYMMETRIC ? c : c + 1;
+            }
+        }
+    }
+    if (count < entries)
+    {
+        throw std::runtime_error("Error: The Matrix Market data is truncated.");
+    }
+}
+
+template <typename T>
+BasicMatrix<T> read_matrix_market(std::istream& is)
+{
+    BasicMatrix<T> matrix;
+    read_market<T>(
+        is, [&](int rows, int cols)
+        { matrix = BasicMatrix<T>(rows, cols, T(0)); },
+        [&](int r, int c, T e)
+        { matrix.data()[std::size_t(r) * matrix.col_size() + c] += e; });
+    return matrix;
+}
+
+SparseMatrix read_sparse_matrix_market(std::istream& is)
+{
+    int rows = 0, cols = 0;
+    std::vector<Triplet> triplets;
+    read_market<double>(
+        is, [&](int m, int n)
+        { rows = m, cols = n; },
+        [&](int r, int c, double e)
+        { triplets.push_back({r, c, e}); });
+    return SparseMatrix(rows, cols, triplets);
+}
+
+#define MLA_INSTANTIATE_MATRIX_TEXT(T)                                                                  \
+    template void write_csv(std::ostream& os, BasicMatrixView<const T> matrix, char delimiter);     \
+    template BasicMatrix<T> read_csv(std::istream& is, char delimiter);                             \
+    template void write_matrix_market(std::ostream& os, BasicMatrixView<const T> matrix);           \
+    template BasicMatrix<T> read_matrix_market(std::istream& is);
+
+MLA_INSTANTIATE_MATRIX_TEXT(float)
+MLA_INSTANTIATE_MATRIX_TEXT(double)
+
+#undef MLA_INSTANTIATE_MATRIX_TEXT
+
+} // namespace mla
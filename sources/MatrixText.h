@@ -0,0 +1,123 @@
+/**
+ * @file MatrixText.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief Text matrix formats, CSV and Matrix Market.
+ * @version 1.0
+ * @date 2026.10.17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef MATRIX_TEXT_H
+#define MATRIX_TEXT_H
+
+#include <istream> // std::istream
+#include <ostream> // std::ostream
+
+#include "Matrix.h"
+#include "MatrixView.h"
+#include "SparseMatrix.h"
+
+namespace mla
+{
+
+/*
+ * Numbers are written in the shortest form that reads back to the same value (std::to_chars) and read with
+ * std::from_chars, so a matrix survives a round trip exactly. Writers stream through a small buffer and
+ * readers go line by line, neither holds the whole text in memory. Instantiated for float and double.
+ */
+
+/**
+ * @brief Write a matrix or view as CSV, one line per row.
+ *
+ * @param os an output stream
+ * @param matrix a matrix or view
+ * @param delimiter separator of the elements of a row
+ */
+template <typename T>
+void write_csv(std::ostream& os, BasicMatrixView<const T> matrix, char delimiter = ',');
+
+/**
+ * @brief Write a matrix as CSV, one line per row.
+ *
+ * @param os an output stream
+ * @param matrix a matrix
+ * @param delimiter separator of the elements of a row
+ */
+template <typename T>
+void write_csv(std::ostream& os, const BasicMatrix<T>& matrix, char delimiter = ',');
+
+/**
+ * @brief Read a matrix from CSV, one row per non-empty line, blanks around the elements are ignored.
+ *
+ * @tparam T scalar type of the elements
+ * @param is an input stream
+ * @param delimiter separator of the elements of a row
+ * @return the matrix read
+ */
+template <typename T = double>
+BasicMatrix<T> read_csv(std::istream& is, char delimiter = ',');
+
+/**
+ * @brief Write a matrix or view in the Matrix Market array format, real general, elements in column-major order.
+ *
+ * @param os an output stream
+ * @param matrix a matrix or view
+ */
+template <typename T>
+void write_matrix_market(std::ostream& os, BasicMatrixView<const T> matrix);
+
+/**
+ * @brief Write a matrix in the Matrix Market array format, real general, elements in column-major order.
+ *
+ * @param os an output stream
+ * @param matrix a matrix
+ */
+template <typename T>
+void write_matrix_market(std::ostream& os, const BasicMatrix<T>& matrix);
+
+/**
+ * @brief Write a sparse matrix in the Matrix Market coordinate format, real general.
+ *
+ * @param os an output stream
+ * @param matrix a sparse matrix
+ */
+void write_matrix_market(std::ostream& os, const SparseMatrix& matrix);
+
+/**
+ * @brief Read a dense matrix from the Matrix Market array or coordinate format.
+ *
+ * Real, integer and pattern fields are accepted, with general, symmetric or skew-symmetric symmetry.
+ *
+ * @tparam T scalar type of the elements
+ * @param is an input stream
+ * @return the matrix read
+ */
+template <typename T = double>
+BasicMatrix<T> read_matrix_market(std::istream& is);
+
+/**
+ * @brief Read a sparse matrix from the Matrix Market coordinate or array format.
+ *
+ * Real, integer and pattern fields are accepted, with general, symmetric or skew-symmetric symmetry.
+ *
+ * @param is an input stream
+ * @return the sparse matrix read
+ */
+SparseMatrix read_sparse_matrix_market(std::istream& is);
+
+template <typename T>
+void write_csv(std::ostream& os, const BasicMatrix<T>& matrix, char delimiter)
+{
+    write_csv(os, BasicMatrixView<const T>(matrix), delimiter);
+}
+
+template <typename T>
+void write_matrix_market(std::ostream& os, const BasicMatrix<T>& matrix)
+{
+    write_matrix_market(os, BasicMatrixView<const T>(matrix));
+}
+
+} // namespace mla
+
+#endif // MATRIX_TEXT_H
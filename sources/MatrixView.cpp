@@ -0,0 +1,51 @@
+#include "MatrixView.h"
+
+#include "gemm.h"
+
+#include <algorithm> // std::equal
+#include <complex>   // std::complex
+
+namespace mla
+{
+
+template <typename T>
+BasicMatrix<T> dot(BasicMatrixView<const T> a, BasicMatrixView<const T> b)
+{
+    utility::check_size(a.col_size(), b.row_size());
+
+    BasicMatrix<T> result(a.row_size(), b.col_size(), 0);
+    kernel::gemm(a.row_size(), b.col_size(), a.col_size(), a.data(), a.stride(), b.data(), b.stride(), result.data(), result.col_size());
+    return result;
+}
+
+template <typename T>
+bool operator==(BasicMatrixView<const T> a, BasicMatrixView<const T> b)
+{
+    if (a.row_size() != b.row_size() || a.col_size() != b.col_size())
+    {
+        return false;
+    }
+
+    for (int r = 0; r < a.row_size(); r++)
+    {
+        const T* x = a.data() + std::ptrdiff_t(r) * a.stride();
+        const T* y = b.data() + std::ptrdiff_t(r) * b.stride();
+        if (!std::equal(x, x + a.col_size(), y))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+#define MLA_INSTANTIATE_MATRIX_VIEW(T)                                                   \
+    template BasicMatrix<T> dot(BasicMatrixView<const T> a, BasicMatrixView<const T> b); \
+    template bool operator==(BasicMatrixView<const T> a, BasicMatrixView<const T> b);
+
+MLA_INSTANTIATE_MATRIX_VIEW(float)
+MLA_INSTANTIATE_MATRIX_VIEW(double)
+MLA_INSTANTIATE_MATRIX_VIEW(std::complex<double>)
+
+#undef MLA_INSTANTIATE_MATRIX_VIEW
+
+} // namespace mla
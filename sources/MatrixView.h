@@ -0,0 +1,799 @@
+/**
+ * @file MatrixView.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief Matrix view class.
+ * @version 1.0
+ * @date 2026.10.16
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef MATRIX_VIEW_H
+#define MATRIX_VIEW_H
+
+#include <algorithm>   // std::copy std::max
+#include <type_traits> // std::is_const_v std::is_invocable_v std::remove_const_t
+#include <utility>     // std::pair
+
+#include "Matrix.h"
+#include "VectorView.h"
+#include "parallel.h"
+#include "simd.h"
+#include "utility.hpp"
+
+namespace mla
+{
+
+/**
+ * @brief Non-owning view of a rectangular block of a matrix, such as a range of rows or columns.
+ *
+ * The rows of the block are contiguous and stride elements apart, so taking a block of a view is O(1).
+ * Assignment through a view copies elements into the viewed storage, it never rebinds the view.
+ *
+ * @tparam T scalar type for a mutable view, such as `double`, or its const version for a read-only view
+ */
+template <typename T>
+class BasicMatrixView
+{
+public:
+    // Scalar type of the elements, without const.
+    using value_type = std::remove_const_t<T>;
+
+private:
+    // Pointer to the first element.
+    T* data_;
+
+    // Number of rows.
+    int rows_;
+
+    // Number of columns.
+    int cols_;
+
+    // Distance between the starts of two adjacent rows.
+    int stride_;
+
+public:
+    /*
+     * Constructor / Destructor
+     */
+
+    /**
+     * @brief Construct a view of a rows x cols block starting at data.
+     *
+     * @param data pointer to the first element
+     * @param rows number of rows
+     * @param cols number of columns
+     * @param stride distance between the starts of two adjacent rows
+     */
+    BasicMatrixView(T* data, int rows, int cols, int stride);
+
+    /**
+     * @brief Construct a view of a whole matrix.
+     *
+     * @param matrix the viewed matrix
+     */
+    BasicMatrixView(BasicMatrix<value_type>& matrix);
+
+    /**
+     * @brief Construct a read-only view of a whole matrix.
+     *
+     * @param matrix the viewed matrix
+     */
+    template <typename U = T, std::enable_if_t<std::is_const_v<U>, int> = 0>
+    BasicMatrixView(const BasicMatrix<value_type>& matrix);
+
+    /**
+     * @brief Copy constructor, the new view refers to the same elements.
+     *
+     * @param that another view
+     */
+    BasicMatrixView(const BasicMatrixView& that) = default;
+
+    /**
+     * @brief Construct a read-only view from a mutable view.
+     *
+     * @param that a mutable view
+     */
+    template <typename U = T, std::enable_if_t<std::is_const_v<U>, int> = 0>
+    BasicMatrixView(const BasicMatrixView<value_type>& that);
+
+    /*
+     * Assignment
+     */
+
+    /**
+     * @brief Copy the elements of another view of the same shape into the viewed elements.
+     *
+     * The two views must not overlap.
+     *
+     * @param that another view of the same shape
+     * @return self reference
+     */
+    BasicMatrixView& operator=(const BasicMatrixView& that);
+
+    /**
+     * @brief Copy the elements of another view of the same shape into the viewed elements.
+     *
+     * The two views must not overlap.
+     *
+     * @param that another view of the same shape
+     * @return self reference
+     */
+    template <typename U>
+    BasicMatrixView& operator=(const BasicMatrixView<U>& that);
+
+    /**
+     * @brief Copy the elements of a matrix of the same shape into the viewed elements.
+     *
+     * @param matrix a matrix of the same shape
+     * @return self reference
+     */
+    BasicMatrixView& operator=(const BasicMatrix<value_type>& matrix);
+
+    /*
+     * Access
+     */
+
+    /**
+     * @brief Return the view of the row at the specified position.
+     *
+     * The index is checked unless MLA_NO_BOUNDS_CHECK is defined for the whole project.
+     *
+     * @param index index of the row to return
+     * @return view of the row at the specified position
+     */
+    BasicVectorView<T> operator[](int index) const;
+
+    /**
+     * @brief Return the view of the row at the specified position, the index is always checked.
+     *
+     * @param index index of the row to return
+     * @return view of the row at the specified position
+     */
+    BasicVectorView<T> at(int index) const;
+
+    /**
+     * @brief Return the pointer to the first element, rows are stride() elements apart.
+     *
+     * @return pointer to the first element
+     */
+    T* data() const;
+
+    /*
+     * Iterator
+     */
+
+    /**
+     * @brief Return an iterator to the first row.
+     *
+     * @return iterator to the first row
+     */
+    typename BasicMatrix<value_type>::template RowIterator<T> begin() const;
+
+    /**
+     * @brief Return an iterator to the row following the last row.
+     *
+     * @return iterator to the row following the last row
+     */
+    typename BasicMatrix<value_type>::template RowIterator<T> end() const;
+
+    /*
+     * Examination (will not change the object itself)
+     */
+
+    /**
+     * @brief Return the number of rows.
+     *
+     * @return the number of rows
+     */
+    int row_size() const;
+
+    /**
+     * @brief Return the number of columns.
+     *
+     * @return the number of columns
+     */
+    int col_size() const;
+
+    /**
+     * @brief Return the distance between the starts of two adjacent rows.
+     *
+     * @return the distance between the starts of two adjacent rows
+     */
+    int stride() const;
+
+    /**
+     * @brief Return true if the view contains no elements.
+     *
+     * @return true if the view contains no elements
+     */
+    bool is_empty() const;
+
+    /**
+     * @brief Calculate the rank of the viewed block, see BasicMatrix::rank().
+     *
+     * @return the rank of the viewed block
+     */
+    int rank() const;
+
+    /**
+     * @brief Calculate the rank of the viewed block, see BasicMatrix::rank(double).
+     *
+     * @param tolerance largest magnitude of a pivot treated as zero
+     * @return the rank of the viewed block
+     */
+    int rank(double tolerance) const;
+
+    /**
+     * @brief Traverse the viewed elements in row-major order on the calling thread.
+     *
+     * @param action a callable takes 3 args: row, col, element const ref, or 1 arg: element const ref
+     * @return self const reference
+     */
+    template <typename F>
+    const BasicMatrixView& for_each(F&& action) const;
+
+    /*
+     * Manipulation (will change the viewed elements)
+     */
+
+    /**
+     * @brief Addition.
+     *
+     * @param that a matrix or view of the same shape, not overlapping this view
+     * @return self reference
+     */
+    const BasicMatrixView& operator+=(const BasicMatrixView<const value_type>& that) const;
+
+    /**
+     * @brief Difference.
+     *
+     * @param that a matrix or view of the same shape, not overlapping this view
+     * @return self reference
+     */
+    const BasicMatrixView& operator-=(const BasicMatrixView<const value_type>& that) const;
+
+    /**
+     * @brief Scalar multiplication.
+     *
+     * @param c a number
+     * @return self reference
+     */
+    const BasicMatrixView& operator*=(const value_type& c) const;
+
+    /**
+     * @brief Traverse the viewed elements and perform action, see BasicMatrix::map().
+     *
+     * @param action a callable takes 3 args: row, col, element ref, or 1 arg: element ref
+     * @param parallel whether action may be called from several threads at once, false by default
+     * @return self reference
+     */
+    template <typename F>
+    const BasicMatrixView& map(F&& action, bool parallel = false) const;
+
+    /*
+     * Production (will produce new object)
+     */
+
+    /**
+     * @brief Return the view of a block of this view.
+     *
+     * @param row index of the first row of the block
+     * @param col index of the first column of the block
+     * @param rows number of rows of the block
+     * @param cols number of columns of the block
+     * @return the view of the block
+     */
+    BasicMatrixView block(int row, int col, int rows, int cols) const;
+
+    /**
+     * @brief Split this view by rows, without copying.
+     *
+     * @param n the row index
+     * @return the views of the rows before n and of the rest
+     */
+    std::pair<BasicMatrixView, BasicMatrixView> split_row(int n) const;
+
+    /**
+     * @brief Split this view by columns, without copying.
+     *
+     * @param n the column index
+     * @return the views of the columns before n and of the rest
+     */
+    std::pair<BasicMatrixView, BasicMatrixView> split_col(int n) const;
+
+    /**
+     * @brief Return the transpose of the viewed block.
+     *
+     * @return the transpose of the viewed block
+     */
+    BasicMatrix<value_type> transpose() const;
+};
+
+// Mutable view.
+using MatrixView = BasicMatrixView<double>;
+
+// Read-only view.
+using ConstMatrixView = BasicMatrixView<const double>;
+
+/*
+ * Arithmetic
+ */
+
+// Whether T is a view of a matrix.
+template <typename T>
+struct is_matrix_view : std::false_type
+{
+};
+
+template <typename T>
+struct is_matrix_view<BasicMatrixView<T>> : std::true_type
+{
+};
+
+// Scalar type of a matrix or a view, void for other types.
+template <typename T>
+struct matrix_scalar
+{
+    using type = void;
+};
+
+template <typename T>
+struct matrix_scalar<BasicMatrix<T>>
+{
+    using type = T;
+};
+
+template <typename T>
+struct matrix_scalar<BasicMatrixView<T>>
+{
+    using type = std::remove_const_t<T>;
+};
+
+template <typename T>
+using matrix_scalar_t = typename matrix_scalar<T>::type;
+
+// A view and a matrix or another view of the same scalar type, both converted to read-only views.
+template <typename A, typename B>
+using enable_if_view_operands = std::enable_if_t<(is_matrix_view<A>::value || is_matrix_view<B>::value) && std::is_same_v<matrix_scalar_t<A>, matrix_scalar_t<B>>, int>;
+
+/**
+ * @brief Return an expression of a view, so the operations applied to it are fused into one pass, see lazy(vector).
+ *
+ * The expression refers to the viewed elements, which must outlive it (do not store it with `auto`).
+ *
+ * @param view a view
+ * @return an expression of the view
+ */
+template <typename T>
+MatrixExpression<expr::Strided<std::remove_const_t<T>>> lazy(const BasicMatrixView<T>& view);
+
+/**
+ * @brief Return the addition of two matrices or views, at least one of them a view.
+ *
+ * @param a a matrix or view
+ * @param b another matrix or view of the same size as a
+ * @return the addition of two matrices
+ */
+template <typename A, typename B, enable_if_view_operands<A, B> = 0>
+BasicMatrix<matrix_scalar_t<A>> operator+(const A& a, const B& b);
+
+/**
+ * @brief Return the difference of two matrices or views, at least one of them a view.
+ *
+ * @param a a matrix or view
+ * @param b another matrix or view of the same size as a
+ * @return the difference of two matrices
+ */
+template <typename A, typename B, enable_if_view_operands<A, B> = 0>
+BasicMatrix<matrix_scalar_t<A>> operator-(const A& a, const B& b);
+
+/**
+ * @brief Return the Hadamard product (entrywise product) of two matrices or views, at least one of them a view.
+ *
+ * @param a a matrix or view
+ * @param b another matrix or view of the same size as a
+ * @return the Hadamard product (entrywise product) of two matrices
+ */
+template <typename A, typename B, enable_if_view_operands<A, B> = 0>
+BasicMatrix<matrix_scalar_t<A>> operator*(const A& a, const B& b);
+
+/**
+ * @brief Return the scalar multiplication of view and number.
+ *
+ * @param view a view
+ * @param c a number
+ * @return the scalar multiplication of view and number
+ */
+template <typename T>
+BasicMatrix<std::remove_const_t<T>> operator*(const BasicMatrixView<T>& view, const std::remove_const_t<T>& c);
+
+/**
+ * @brief Return the scalar multiplication of view and number.
+ *
+ * @param c a number
+ * @param view a view
+ * @return the scalar multiplication of view and number
+ */
+template <typename T>
+BasicMatrix<std::remove_const_t<T>> operator*(const std::remove_const_t<T>& c, const BasicMatrixView<T>& view);
+
+/**
+ * @brief Return the product of two read-only views.
+ *
+ * @param a a view (m rows, k cols)
+ * @param b another view (k rows, n cols)
+ * @return the product of two matrices (m rows, n cols)
+ */
+template <typename T>
+BasicMatrix<T> dot(BasicMatrixView<const T> a, BasicMatrixView<const T> b);
+
+/**
+ * @brief Return the product of two matrices or views, at least one of them a view.
+ *
+ * @param a a matrix or view (m rows, k cols)
+ * @param b another matrix or view (k rows, n cols)
+ * @return the product of two matrices (m rows, n cols)
+ */
+template <typename A, typename B, enable_if_view_operands<A, B> = 0>
+BasicMatrix<matrix_scalar_t<A>> dot(const A& a, const B& b);
+
+/**
+ * @brief Check whether two read-only views have the same shape and elements.
+ *
+ * @param a a view
+ * @param b another view
+ * @return true if they are equal
+ */
+template <typename T>
+bool operator==(BasicMatrixView<const T> a, BasicMatrixView<const T> b);
+
+/**
+ * @brief Check whether two matrices or views have the same shape and elements, at least one of them a view.
+ *
+ * @param a a matrix or view
+ * @param b another matrix or view
+ * @return true if they are equal
+ */
+template <typename A, typename B, enable_if_view_operands<A, B> = 0>
+bool operator==(const A& a, const B& b);
+
+/**
+ * @brief Check whether two matrices or views differ in shape or elements, at least one of them a view.
+ *
+ * @param a a matrix or view
+ * @param b another matrix or view
+ * @return true if they are not equal
+ */
+template <typename A, typename B, enable_if_view_operands<A, B> = 0>
+bool operator!=(const A& a, const B& b);
+
+/*
+ * Print
+ */
+
+/**
+ * @brief Output the viewed elements to the specified output stream.
+ *
+ * @param os an output stream
+ * @param view the view to be printed to the output stream
+ * @return self reference of the output stream
+ */
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const BasicMatrixView<T>& view);
+
+template <typename T>
+BasicMatrixView<T>::BasicMatrixView(T* data, int rows, int cols, int stride)
+    : data_(data)
+    , rows_(rows)
+    , cols_(cols)
+    , stride_(stride)
+{
+}
+
+template <typename T>
+BasicMatrixView<T>::BasicMatrixView(BasicMatrix<value_type>& matrix)
+    : BasicMatrixView(matrix.data(), matrix.row_size(), matrix.col_size(), matrix.col_size())
+{
+}
+
+template <typename T>
+template <typename U, std::enable_if_t<std::is_const_v<U>, int>>
+BasicMatrixView<T>::BasicMatrixView(const BasicMatrix<value_type>& matrix)
+    : BasicMatrixView(matrix.data(), matrix.row_size(), matrix.col_size(), matrix.col_size())
+{
+}
+
+template <typename T>
+template <typename U, std::enable_if_t<std::is_const_v<U>, int>>
+BasicMatrixView<T>::BasicMatrixView(const BasicMatrixView<value_type>& that)
+    : BasicMatrixView(that.data(), that.row_size(), that.col_size(), that.stride())
+{
+}
+
+template <typename T>
+BasicMatrixView<T>& BasicMatrixView<T>::operator=(const BasicMatrixView& that)
+{
+    return operator= <T>(that);
+}
+
+template <typename T>
+template <typename U>
+BasicMatrixView<T>& BasicMatrixView<T>::operator=(const BasicMatrixView<U>& that)
+{
+    utility::check_size(rows_, that.row_size());
+    utility::check_size(cols_, that.col_size());
+
+    if (data_ != that.data())
+    {
+        for (int r = 0; r < rows_; r++)
+        {
+            const U* row = that.data() + std::ptrdiff_t(r) * that.stride();
+            std::copy(row, row + cols_, data_ + std::ptrdiff_t(r) * stride_);
+        }
+    }
+
+    return *this;
+}
+
+template <typename T>
+BasicMatrixView<T>& BasicMatrixView<T>::operator=(const BasicMatrix<value_type>& matrix)
+{
+    return *this = BasicMatrixView<const value_type>(matrix);
+}
+
+template <typename T>
+BasicVectorView<T> BasicMatrixView<T>::operator[](int index) const
+{
+    utility::check_index(index, rows_);
+
+    return BasicVectorView<T>(data_ + std::ptrdiff_t(index) * stride_, cols_);
+}
+
+template <typename T>
+BasicVectorView<T> BasicMatrixView<T>::at(int index) const
+{
+    utility::check_bounds(index, 0, rows_);
+
+    return BasicVectorView<T>(data_ + std::ptrdiff_t(index) * stride_, cols_);
+}
+
+template <typename T>
+T* BasicMatrixView<T>::data() const
+{
+    return data_;
+}
+
+template <typename T>
+typename BasicMatrix<std::remove_const_t<T>>::template RowIterator<T> BasicMatrixView<T>::begin() const
+{
+    return typename BasicMatrix<value_type>::template RowIterator<T>(data_, cols_, stride_, 0);
+}
+
+template <typename T>
+typename BasicMatrix<std::remove_const_t<T>>::template RowIterator<T> BasicMatrixView<T>::end() const
+{
+    return typename BasicMatrix<value_type>::template RowIterator<T>(data_, cols_, stride_, rows_);
+}
+
+template <typename T>
+int BasicMatrixView<T>::row_size() const
+{
+    return rows_;
+}
+
+template <typename T>
+int BasicMatrixView<T>::col_size() const
+{
+    return cols_;
+}
+
+template <typename T>
+int BasicMatrixView<T>::stride() const
+{
+    return stride_;
+}
+
+template <typename T>
+bool BasicMatrixView<T>::is_empty() const
+{
+    return rows_ == 0 || cols_ == 0;
+}
+
+template <typename T>
+const BasicMatrixView<T>& BasicMatrixView<T>::operator+=(const BasicMatrixView<const value_type>& that) const
+{
+    utility::check_size(rows_, that.row_size());
+    utility::check_size(cols_, that.col_size());
+
+    const BasicMatrixView<T> self = *this;
+    kernel::parallel_for(0, rows_, std::max(1, kernel::PARALLEL_GRAIN / std::max(1, cols_)), [=](int begin, int end)
+                         {
+        for (int r = begin; r < end; r++)
+        {
+            kernel::add(self.cols_, that.data() + std::ptrdiff_t(r) * that.stride(), self.data_ + std::ptrdiff_t(r) * self.stride_);
+        } });
+    return *this;
+}
+
+template <typename T>
+const BasicMatrixView<T>& BasicMatrixView<T>::operator-=(const BasicMatrixView<const value_type>& that) const
+{
+    utility::check_size(rows_, that.row_size());
+    utility::check_size(cols_, that.col_size());
+
+    const BasicMatrixView<T> self = *this;
+    kernel::parallel_for(0, rows_, std::max(1, kernel::PARALLEL_GRAIN / std::max(1, cols_)), [=](int begin, int end)
+                         {
+        for (int r = begin; r < end; r++)
+        {
+            kernel::sub(self.cols_, that.data() + std::ptrdiff_t(r) * that.stride(), self.data_ + std::ptrdiff_t(r) * self.stride_);
+        } });
+    return *this;
+}
+
+template <typename T>
+const BasicMatrixView<T>& BasicMatrixView<T>::operator*=(const value_type& c) const
+{
+    const BasicMatrixView<T> self = *this;
+    kernel::parallel_for(0, rows_, std::max(1, kernel::PARALLEL_GRAIN / std::max(1, cols_)), [=](int begin, int end)
+                         {
+        for (int r = begin; r < end; r++)
+        {
+            kernel::scale(self.cols_, c, self.data_ + std::ptrdiff_t(r) * self.stride_);
+        } });
+    return *this;
+}
+
+template <typename T>
+template <typename F>
+const BasicMatrixView<T>& BasicMatrixView<T>::for_each(F&& action) const
+{
+    for (int r = 0; r < rows_; r++)
+    {
+        const T* e = data_ + std::ptrdiff_t(r) * stride_;
+        for (int c = 0; c < cols_; c++)
+        {
+            if constexpr (std::is_invocable_v<F&, int, int, const value_type&>)
+            {
+                action(r, c, e[c]);
+            }
+            else
+            {
+                action(e[c]);
+            }
+        }
+    }
+    return *this;
+}
+
+template <typename T>
+template <typename F>
+const BasicMatrixView<T>& BasicMatrixView<T>::map(F&& action, bool parallel) const
+{
+    const auto rows = [&](int begin, int end)
+    {
+        for (int r = begin; r < end; r++)
+        {
+            T* e = data_ + std::ptrdiff_t(r) * stride_;
+            for (int c = 0; c < cols_; c++)
+            {
+                if constexpr (std::is_invocable_v<F&, int, int, T&>)
+                {
+                    action(r, c, e[c]);
+                }
+                else
+                {
+                    action(e[c]);
+                }
+            }
+        }
+    };
+
+    if (parallel)
+    {
+        kernel::parallel_for(0, rows_, std::max(1, kernel::PARALLEL_GRAIN / std::max(1, cols_)), rows);
+    }
+    else
+    {
+        rows(0, rows_);
+    }
+    return *this;
+}
+
+template <typename T>
+BasicMatrixView<T> BasicMatrixView<T>::block(int row, int col, int rows, int cols) const
+{
+    utility::check_bounds(row, 0, rows_ + 1);
+    utility::check_bounds(col, 0, cols_ + 1);
+    utility::check_bounds(rows, 0, rows_ - row + 1);
+    utility::check_bounds(cols, 0, cols_ - col + 1);
+
+    return BasicMatrixView(data_ + std::ptrdiff_t(row) * stride_ + col, rows, cols, stride_);
+}
+
+template <typename T>
+std::pair<BasicMatrixView<T>, BasicMatrixView<T>> BasicMatrixView<T>::split_row(int n) const
+{
+    utility::check_bounds(n, 0, rows_);
+
+    return std::make_pair(block(0, 0, n, cols_), block(n, 0, rows_ - n, cols_));
+}
+
+template <typename T>
+std::pair<BasicMatrixView<T>, BasicMatrixView<T>> BasicMatrixView<T>::split_col(int n) const
+{
+    utility::check_bounds(n, 0, cols_);
+
+    return std::make_pair(block(0, 0, rows_, n), block(0, n, rows_, cols_ - n));
+}
+
+template <typename A, typename B, enable_if_view_operands<A, B>>
+BasicMatrix<matrix_scalar_t<A>> dot(const A& a, const B& b)
+{
+    using T = matrix_scalar_t<A>;
+    return dot<T>(BasicMatrixView<const T>(a), BasicMatrixView<const T>(b));
+}
+
+template <typename A, typename B, enable_if_view_operands<A, B>>
+bool operator==(const A& a, const B& b)
+{
+    using T = matrix_scalar_t<A>;
+    return operator==<T>(BasicMatrixView<const T>(a), BasicMatrixView<const T>(b));
+}
+
+template <typename A, typename B, enable_if_view_operands<A, B>>
+bool operator!=(const A& a, const B& b)
+{
+    return !(a == b);
+}
+
+template <typename T>
+MatrixExpression<expr::Strided<std::remove_const_t<T>>> lazy(const BasicMatrixView<T>& view)
+{
+    return MatrixExpression<expr::Strided<std::remove_const_t<T>>>(expr::node(view), view.row_size(), view.col_size());
+}
+
+template <typename A, typename B, enable_if_view_operands<A, B>>
+BasicMatrix<matrix_scalar_t<A>> operator+(const A& a, const B& b)
+{
+    using T = matrix_scalar_t<A>;
+    return BasicMatrix<T>(lazy(BasicMatrixView<const T>(a)) + lazy(BasicMatrixView<const T>(b)));
+}
+
+template <typename A, typename B, enable_if_view_operands<A, B>>
+BasicMatrix<matrix_scalar_t<A>> operator-(const A& a, const B& b)
+{
+    using T = matrix_scalar_t<A>;
+    return BasicMatrix<T>(lazy(BasicMatrixView<const T>(a)) - lazy(BasicMatrixView<const T>(b)));
+}
+
+template <typename A, typename B, enable_if_view_operands<A, B>>
+BasicMatrix<matrix_scalar_t<A>> operator*(const A& a, const B& b)
+{
+    using T = matrix_scalar_t<A>;
+    return BasicMatrix<T>(lazy(BasicMatrixView<const T>(a)) * lazy(BasicMatrixView<const T>(b)));
+}
+
+template <typename T>
+BasicMatrix<std::remove_const_t<T>> operator*(const BasicMatrixView<T>& view, const std::remove_const_t<T>& c)
+{
+    return BasicMatrix<std::remove_const_t<T>>(lazy(view) * c);
+}
+
+template <typename T>
+BasicMatrix<std::remove_const_t<T>> operator*(const std::remove_const_t<T>& c, const BasicMatrixView<T>& view)
+{
+    return view * c;
+}
+
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const BasicMatrixView<T>& view)
+{
+    using U = std::remove_const_t<T>;
+    return os << BasicMatrix<U>(BasicMatrixView<const U>(view));
+}
+
+} // namespace mla
+
+#endif // MATRIX_VIEW_H
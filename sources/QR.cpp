@@ -0,0 +1,319 @@
+#include "QR.h"
+
+#include "gemm.h"
+#include "simd.h"
+#include "utility.hpp"
+
+#include <algorithm> // std::copy std::max std::min
+#include <cmath>     // std::abs std::sqrt
+#include <limits>    // std::numeric_limits
+
+namespace mla
+{
+
+// Number of reflectors of a block, applied to the trailing columns together in compact WY form.
+static constexpr int NB = 32;
+
+/*
+ * Householder QR of an mk x nb panel stored column by column (column j at p + j * mk).
+ *
+ * On return the panel holds R on and above the diagonal and the reflectors below it, tau their scales.
+ */
+static void factorize_panel(int mk, int nb, double* p, double* tau)
+{
+    for (int j = 0; j < nb; j++)
+    {
+        double* x = p + std::ptrdiff_t(j) * mk + j;
+        const int len = mk - j;
+
+        // reflector that maps x to (beta, 0, ..., 0), v = (1, x[1:] / (alpha - beta))
+        const double alpha = x[0];
+        const double sigma = kernel::dot(len - 1, x + 1, x + 1);
+        if (sigma == 0)
+        {
+            tau[j] = 0;
+            continue;
+        }
+        const double norm = std::sqrt(alpha * alpha + sigma);
+        const double beta = alpha <= 0 ? norm : -norm;
+        tau[j] = (beta - alpha) / beta;
+        kernel::scale(len - 1, 1 / (alpha - beta), x + 1);
+        x[0] = beta;
+
+        // apply H = I - tau v v^T to the rest of the panel
+        for (int c = j + 1; c < nb; c++)
+        {
+            double* y = p + std::ptrdiff_t(c) * mk + j;
+            const double w = tau[j] * (y[0] + kernel::dot(len - 1, x + 1, y + 1));
+            y[0] -= w;
+            for (int i = 1; i < len; i++)
+            {
+                y[i] -= w * x[i];
+            }
+        }
+    }
+}
+
+/*
+ * Apply H_k = I - tau_k v_k v_k^T for k = first, first + step, ... until last (excluded)
+ * to the m x p row-major matrix b (leading dimension ldb), with the reflectors stored below the diagonal of a (m x n).
+ */
+static void apply_reflectors(const double* a, int m, int n, const double* tau, int first, int last, int step, double* b, int p, int ldb)
+{
+    std::vector<double> w(std::size_t(std::max(p, 0)));
+    for (int k = first; k != last; k += step)
+    {
+        if (tau[k] == 0)
+        {
+            continue;
+        }
+
+        // w = v^T B, row by row so that B is read contiguously
+        std::copy(b + std::ptrdiff_t(k) * ldb, b + std::ptrdiff_t(k) * ldb + p, w.begin());
+        for (int i = k + 1; i < m; i++)
+        {
+            const double v = a[std::ptrdiff_t(i) * n + k];
+            const double* row = b + std::ptrdiff_t(i) * ldb;
+            for (int c = 0; c < p; c++)
+            {
+                w[c] += v * row[c];
+            }
+        }
+
+        // B -= tau v w
+        kernel::scale(p, tau[k], w.data());
+        kernel::sub(p, w.data(), b + std::ptrdiff_t(k) * ldb);
+        for (int i = k + 1; i < m; i++)
+        {
+            const double v = a[std::ptrdiff_t(i) * n + k];
+            double* row = b + std::ptrdiff_t(i) * ldb;
+            for (int c = 0; c < p; c++)
+            {
+                row[c] -= v * w[c];
+            }
+        }
+    }
+}
+
+QR::QR(ConstMatrixView matrix)
+    : factors_(matrix)
+    , tau_(matrix.col_size())
+    , rank_deficient_(false)
+{
+    if (matrix.row_size() < matrix.col_size())
+    {
+        throw std::runtime_error("Error: The dimensions mismatch.");
+    }
+
+    const int m = row_size();
+    const int n = col_size();
+    double* a = factors_.data();
+
+    double max = 0;
+    for (std::ptrdiff_t i = 0; i < std::ptrdiff_t(m) * n; i++)
+    {
+        max = std::max(max, std::abs(a[i]));
+    }
+
+    std::vector<double> panel, vt, v, w;
+    for (int k = 0; k < n; k += NB)
+    {
+        const int nb = std::min(NB, n - k);
+        const int mk = m - k;
+
+        // factorize the panel in a column-major copy so that the reflectors are contiguous
+        panel.resize(std::size_t(mk) * nb);
+        for (int i = 0; i < mk; i++)
+        {
+            for (int j = 0; j < nb; j++)
+            {
+                panel[std::size_t(j) * mk + i] = a[std::ptrdiff_t(k + i) * n + k + j];
+            }
+        }
+        factorize_panel(mk, nb, panel.data(), tau_.data() + k);
+        for (int i = 0; i < mk; i++)
+        {
+            for (int j = 0; j < nb; j++)
+            {
+                a[std::ptrdiff_t(k + i) * n + k + j] = panel[std::size_t(j) * mk + i];
+            }
+        }
+
+        const int n2 = n - k - nb;
+        if (n2 == 0)
+        {
+            continue;
+        }
+
+        // V with its unit diagonal and zeros above, as mk x nb and as its transpose
+        v.assign(std::size_t(mk) * nb, 0);
+        vt.assign(std::size_t(nb) * mk, 0);
+        for (int j = 0; j < nb; j++)
+        {
+            v[std::size_t(j) * nb + j] = vt[std::size_t(j) * mk + j] = 1;
+            for (int i = j + 1; i < mk; i++)
+            {
+                v[std::size_t(i) * nb + j] = vt[std::size_t(j) * mk + i] = panel[std::size_t(j) * mk + i];
+            }
+        }
+
+        // T upper triangular with H_1 ... H_nb = I - V T V^T
+        std::vector<double> t(std::size_t(nb) * nb, 0);
+        std::vector<double> z(nb);
+        for (int j = 0; j < nb; j++)
+        {
+            const double* vj = vt.data() + std::size_t(j) * mk;
+            for (int i = 0; i < j; i++)
+            {
+                z[i] = kernel::dot(mk - j, vt.data() + std::size_t(i) * mk + j, vj + j);
+            }
+            for (int i = 0; i < j; i++)
+            {
+                double sum = 0;
+                for (int l = i; l < j; l++)
+                {
+                    sum += t[std::size_t(i) * nb + l] * z[l];
+                }
+                t[std::size_t(i) * nb + j] = -tau_[k + j] * sum;
+            }
+            t[std::size_t(j) * nb + j] = tau_[k + j];
+        }
+
+        // A2 -= V T^T V^T A2, the two large products run in gemm
+        double* a2 = a + std::ptrdiff_t(k) * n + k + nb;
+        w.assign(std::size_t(nb) * n2, 0);
+        kernel::gemm(nb, n2, mk, vt.data(), mk, a2, n, w.data(), n2);
+        for (int i = nb - 1; i >= 0; i--)
+        {
+            // row i of T^T W only needs rows up to i, so it is computed in place from the bottom
+            double* wi = w.data() + std::size_t(i) * n2;
+            kernel::scale(n2, -t[std::size_t(i) * nb + i], wi);
+            for (int l = 0; l < i; l++)
+            {
+                const double c = -t[std::size_t(l) * nb + i];
+                const double* wl = w.data() + std::size_t(l) * n2;
+                for (int c2 = 0; c2 < n2; c2++)
+                {
+                    wi[c2] += c * wl[c2];
+                }
+            }
+        }
+        kernel::gemm(mk, n2, nb, v.data(), nb, w.data(), n2, a2, n);
+    }
+
+    const double tolerance = m * std::numeric_limits<double>::epsilon() * max;
+    for (int i = 0; i < n; i++)
+    {
+        if (std::abs(a[std::ptrdiff_t(i) * n + i]) <= tolerance)
+        {
+            rank_deficient_ = true;
+        }
+    }
+}
+
+int QR::row_size() const
+{
+    return factors_.row_size();
+}
+
+int QR::col_size() const
+{
+    return factors_.col_size();
+}
+
+bool QR::is_rank_deficient() const
+{
+    return rank_deficient_;
+}
+
+const Matrix& QR::factors() const
+{
+    return factors_;
+}
+
+Matrix QR::r() const
+{
+    const int n = col_size();
+    Matrix result(n, n, 0);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = i; j < n; j++)
+        {
+            result[i][j] = factors_[i][j];
+        }
+    }
+    return result;
+}
+
+Matrix QR::q() const
+{
+    const int m = row_size();
+    const int n = col_size();
+
+    // Q = H_1 ... H_n applied to the first n columns of the identity, last reflector first
+    Matrix result(m, n, 0);
+    for (int i = 0; i < n; i++)
+    {
+        result[i][i] = 1;
+    }
+    apply_reflectors(factors_.data(), m, n, tau_.data(), n - 1, -1, -1, result.data(), n, n);
+    return result;
+}
+
+Vector QR::solve(const Vector& b) const
+{
+    Matrix x = solve(Matrix({b}).transpose());
+    return Vector(x.transpose()[0]);
+}
+
+Matrix QR::solve(const Matrix& b) const
+{
+    utility::check_size(row_size(), b.row_size());
+
+    if (rank_deficient_)
+    {
+        throw std::runtime_error("Error: Rank deficient matrix.");
+    }
+
+    const int m = row_size();
+    const int n = col_size();
+    const int p = b.col_size();
+    const double* a = factors_.data();
+
+    // Q^T B
+    Matrix y = b;
+    apply_reflectors(a, m, n, tau_.data(), 0, n, 1, y.data(), p, p);
+
+    // back substitution with R on the first n rows
+    Matrix x(n, p, 0);
+    double* xd = x.data();
+    std::copy(y.data(), y.data() + std::ptrdiff_t(n) * p, xd);
+    for (int i = n - 1; i >= 0; i--)
+    {
+        double* row_i = xd + std::ptrdiff_t(i) * p;
+        for (int j = i + 1; j < n; j++)
+        {
+            const double r = a[std::ptrdiff_t(i) * n + j];
+            const double* row_j = xd + std::ptrdiff_t(j) * p;
+            for (int c = 0; c < p; c++)
+            {
+                row_i[c] -= r * row_j[c];
+            }
+        }
+        kernel::scale(p, 1 / a[std::ptrdiff_t(i) * n + i], row_i);
+    }
+
+    return x;
+}
+
+Vector lstsq(ConstMatrixView a, const Vector& b)
+{
+    return QR(a).solve(b);
+}
+
+Matrix lstsq(ConstMatrixView a, const Matrix& b)
+{
+    return QR(a).solve(b);
+}
+
+} // namespace mla
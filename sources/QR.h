@@ -0,0 +1,138 @@
+/**
+ * @file QR.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief QR factorization class.
+ * @version 1.0
+ * @date 2026.10.16
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef QR_H
+#define QR_H
+
+#include "Matrix.h"
+#include "MatrixView.h"
+
+namespace mla
+{
+
+/**
+ * @brief QR factorization by Householder reflections, A = QR, of an m x n matrix with m >= n.
+ *
+ * Q is kept as the m x n reflectors, so applying Q^T costs O(mn) per column and no m x m matrix is formed.
+ * Reflectors are applied to the rest of the matrix a block at a time in compact WY form, I - VTV^T,
+ * so the bulk of the factorization runs in the matrix product.
+ */
+class QR
+{
+private:
+    // R (upper triangle) and the reflectors (below the diagonal, unit leading element implied) packed in one matrix.
+    Matrix factors_;
+
+    // Scale of each reflector, H_k = I - tau_k v_k v_k^T.
+    std::vector<double> tau_;
+
+    // Whether a diagonal element of R is zero within the rounding error of the factorization.
+    bool rank_deficient_;
+
+public:
+    /*
+     * Constructor / Destructor
+     */
+
+    /**
+     * @brief Factorize a matrix with at least as many rows as columns.
+     *
+     * @param matrix a square or tall matrix or view
+     */
+    explicit QR(ConstMatrixView matrix);
+
+    /*
+     * Examination (will not change the object itself)
+     */
+
+    /**
+     * @brief Return the number of rows of the factorized matrix.
+     *
+     * @return the number of rows of the factorized matrix
+     */
+    int row_size() const;
+
+    /**
+     * @brief Return the number of columns of the factorized matrix.
+     *
+     * @return the number of columns of the factorized matrix
+     */
+    int col_size() const;
+
+    /**
+     * @brief Determine whether the columns of the factorized matrix are linearly dependent.
+     *
+     * @return true if the factorized matrix does not have full column rank
+     */
+    bool is_rank_deficient() const;
+
+    /**
+     * @brief Return the packed factors, R on and above the diagonal and the reflectors below it.
+     *
+     * @return the packed factors
+     */
+    const Matrix& factors() const;
+
+    /*
+     * Production (will produce new object)
+     */
+
+    /**
+     * @brief Return the n x n upper triangular factor R.
+     *
+     * @return the factor R
+     */
+    Matrix r() const;
+
+    /**
+     * @brief Return the m x n factor Q with orthonormal columns (thin Q).
+     *
+     * @return the factor Q
+     */
+    Matrix q() const;
+
+    /**
+     * @brief Solve the least squares problem min ||Ax - b||.
+     *
+     * @param b a vector of m elements
+     * @return the solution x of n elements
+     */
+    Vector solve(const Vector& b) const;
+
+    /**
+     * @brief Solve the least squares problems min ||AX - B||, one for each column of B.
+     *
+     * @param b a matrix with m rows
+     * @return the solution X with n rows
+     */
+    Matrix solve(const Matrix& b) const;
+};
+
+/**
+ * @brief Solve the least squares problem min ||Ax - b|| by QR factorization, without forming A^T A.
+ *
+ * @param a a square or tall matrix or view with full column rank
+ * @param b a vector with as many elements as a has rows
+ * @return the solution x
+ */
+Vector lstsq(ConstMatrixView a, const Vector& b);
+
+/**
+ * @brief Solve the least squares problems min ||AX - B|| by QR factorization, without forming A^T A.
+ *
+ * @param a a square or tall matrix or view with full column rank
+ * @param b a matrix with as many rows as a
+ * @return the solution X
+ */
+Matrix lstsq(ConstMatrixView a, const Matrix& b);
+
+} // namespace mla
+
+#endif // QR_H
@@ -0,0 +1,306 @@
+/**
+ * @file SmallVector.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief Contiguous container with inline storage for a few elements.
+ * @version 1.0
+ * @date 2026.10.17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <algorithm>        // std::copy std::equal std::max
+#include <cstddef>          // std::size_t
+#include <initializer_list> // std::initializer_list
+#include <memory>           // std::uninitialized_copy std::uninitialized_fill_n
+#include <type_traits>      // std::is_trivially_copyable_v
+
+#include "Allocator.h"
+
+namespace mla
+{
+
+// Bytes of elements a SmallVector keeps inside the object, 4 doubles, 8 floats or 2 complex numbers.
+constexpr std::size_t SMALL_BYTES = 32;
+
+/**
+ * @brief Contiguous container of trivially copyable elements that keeps up to SMALL_BYTES of them inline.
+ *
+ * Short sequences live in a buffer inside the object and never allocate, longer ones spill to storage
+ * from an Allocator. The allocator follows the rules of std::vector with Allocator: a copy takes the
+ * resource of the thread that makes it, and moving between different resources copies the elements.
+ *
+ * @tparam T element type
+ */
+template <typename T>
+class SmallVector
+{
+    static_assert(std::is_trivially_copyable_v<T>, "elements are copied as raw bytes");
+
+public:
+    // Number of elements kept inline.
+    static constexpr int INLINE = std::max<int>(1, int(SMALL_BYTES / sizeof(T)));
+
+private:
+    // Inline storage, or storage from allocator_ when capacity_ > INLINE.
+    T* data_;
+
+    // Number of elements.
+    int size_;
+
+    // Number of elements data_ can hold.
+    int capacity_;
+
+    // Source of the storage of long sequences.
+    Allocator<T> allocator_;
+
+    alignas(SMALL_BYTES) unsigned char buffer_[INLINE * sizeof(T)];
+
+    T* buffer()
+    {
+        return reinterpret_cast<T*>(buffer_);
+    }
+
+    // Make room for at least n elements, keeping the current ones.
+    void reserve(int n)
+    {
+        if (n <= capacity_)
+        {
+            return;
+        }
+
+        const int capacity = std::max(n, 2 * capacity_);
+        T* data = allocator_.allocate(capacity);
+        std::uninitialized_copy(data_, data_ + size_, data);
+        release();
+        data_ = data;
+        capacity_ = capacity;
+    }
+
+    // Free the spilled storage, if any.
+    void release()
+    {
+        if (!is_small())
+        {
+            allocator_.deallocate(data_, capacity_);
+        }
+        data_ = buffer();
+        capacity_ = INLINE;
+    }
+
+    // Replace the elements with copies of [first, last).
+    void assign(const T* first, const T* last)
+    {
+        const int n = int(last - first);
+        if (n > capacity_)
+        {
+            release();
+            reserve(n);
+        }
+        std::uninitialized_copy(first, last, data_);
+        size_ = n;
+    }
+
+public:
+    SmallVector()
+        : data_(buffer())
+        , size_(0)
+        , capacity_(INLINE)
+        , allocator_()
+    {
+    }
+
+    // n value-initialized elements.
+    explicit SmallVector(int n)
+        : SmallVector(n, T())
+    {
+    }
+
+    SmallVector(int n, const T& element)
+        : SmallVector()
+    {
+        reserve(n);
+        std::uninitialized_fill_n(data_, n, element);
+        size_ = n;
+    }
+
+    SmallVector(std::initializer_list<T> il)
+        : SmallVector()
+    {
+        assign(il.begin(), il.end());
+    }
+
+    SmallVector(const SmallVector& that)
+        : data_(buffer())
+        , size_(0)
+        , capacity_(INLINE)
+        , allocator_(that.allocator_.select_on_container_copy_construction())
+    {
+        assign(that.data_, that.data_ + that.size_);
+    }
+
+    SmallVector(SmallVector&& that) noexcept
+        : data_(buffer())
+        , size_(0)
+        , capacity_(INLINE)
+        , allocator_(that.allocator_)
+    {
+        if (that.is_small())
+        {
+            std::uninitialized_copy(that.data_, that.data_ + that.size_, data_);
+        }
+        else
+        {
+            data_ = that.data_;
+            capacity_ = that.capacity_;
+            that.data_ = that.buffer();
+            that.capacity_ = INLINE;
+        }
+        size_ = that.size_;
+        that.size_ = 0;
+    }
+
+    ~SmallVector()
+    {
+        release();
+    }
+
+    SmallVector& operator=(const SmallVector& that)
+    {
+        if (this != &that)
+        {
+            assign(that.data_, that.data_ + that.size_);
+        }
+        return *this;
+    }
+
+    // The allocator is not propagated, spilled storage is taken over only if it comes from the same resource.
+    SmallVector& operator=(SmallVector&& that)
+    {
+        if (this == &that)
+        {
+            return *this;
+        }
+
+        if (that.is_small() || allocator_ != that.allocator_)
+        {
+            assign(that.data_, that.data_ + that.size_);
+        }
+        else
+        {
+            release();
+            data_ = that.data_;
+            capacity_ = that.capacity_;
+            that.data_ = that.buffer();
+            that.capacity_ = INLINE;
+        }
+        size_ = that.size_;
+        that.size_ = 0;
+        return *this;
+    }
+
+    bool operator==(const SmallVector& that) const
+    {
+        return size_ == that.size_ && std::equal(data_, data_ + size_, that.data_);
+    }
+
+    T& operator[](int index)
+    {
+        return data_[index];
+    }
+
+    const T& operator[](int index) const
+    {
+        return data_[index];
+    }
+
+    T* data()
+    {
+        return data_;
+    }
+
+    const T* data() const
+    {
+        return data_;
+    }
+
+    T* begin()
+    {
+        return data_;
+    }
+
+    const T* begin() const
+    {
+        return data_;
+    }
+
+    T* end()
+    {
+        return data_ + size_;
+    }
+
+    const T* end() const
+    {
+        return data_ + size_;
+    }
+
+    int size() const
+    {
+        return size_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    // Whether the elements are stored inside the object.
+    bool is_small() const
+    {
+        return capacity_ == INLINE;
+    }
+
+    Allocator<T> get_allocator() const
+    {
+        return allocator_;
+    }
+
+    // Resize to n elements, new ones are value-initialized.
+    void resize(int n)
+    {
+        reserve(n);
+        if (n > size_)
+        {
+            std::uninitialized_fill_n(data_ + size_, n - size_, T());
+        }
+        size_ = n;
+    }
+
+    void push_back(const T& element)
+    {
+        if (size_ == capacity_)
+        {
+            // element may refer into this vector
+            const T copy = element;
+            reserve(size_ + 1);
+            data_[size_++] = copy;
+            return;
+        }
+        data_[size_++] = element;
+    }
+
+    // Append copies of [first, last), which must not be in this vector.
+    void append(const T* first, const T* last)
+    {
+        const int n = int(last - first);
+        reserve(size_ + n);
+        std::uninitialized_copy(first, last, data_ + size_);
+        size_ += n;
+    }
+};
+
+} // namespace mla
+
+#endif // SMALL_VECTOR_H
@@ -0,0 +1,324 @@
+#include "SparseMatrix.h"
+
+#include "parallel.h"
+#include "text.hpp"
+#include "utility.hpp"
+
+#include <algorithm> // std::lower_bound std::sort
+#include <cstdint>   // std::int64_t
+
+namespace mla
+{
+
+// Number of rows holding about PARALLEL_GRAIN units of work, given the total work of all rows.
+static int row_grain(int rows, std::int64_t work)
+{
+    return int(std::max<std::int64_t>(1, std::int64_t(kernel::PARALLEL_GRAIN) * rows / std::max<std::int64_t>(1, work)));
+}
+
+SparseMatrix::SparseMatrix()
+    : rows_(0)
+    , cols_(0)
+    , offsets_(1, 0)
+    , indices_()
+    , values_()
+{
+}
+
+SparseMatrix::SparseMatrix(int rows, int cols)
+    : rows_(rows)
+    , cols_(cols)
+    , offsets_(std::size_t(rows) + 1, 0)
+    , indices_()
+    , values_()
+{
+}
+
+SparseMatrix::SparseMatrix(int rows, int cols, const std::vector<Triplet>& triplets)
+    : SparseMatrix(rows, cols)
+{
+    // bucket the triplets by row
+    for (const auto& t : triplets)
+    {
+        utility::check_bounds(t.row, 0, rows_);
+        utility::check_bounds(t.col, 0, cols_);
+
+        ++offsets_[t.row + 1];
+    }
+    for (int r = 0; r < rows_; r++)
+    {
+        offsets_[r + 1] += offsets_[r];
+    }
+
+    std::vector<int> next(offsets_.begin(), offsets_.end() - 1);
+    std::vector<std::pair<int, double>> entries(triplets.size());
+    for (const auto& t : triplets)
+    {
+        entries[next[t.row]++] = {t.col, t.value};
+    }
+
+    // sort each row by column, then sum duplicates and drop zeros, compacting in place
+    indices_.reserve(entries.size());
+    values_.reserve(entries.size());
+    int begin = 0;
+    for (int r = 0; r < rows_; r++)
+    {
+        const int end = offsets_[r + 1];
+        std::sort(entries.begin() + begin, entries.begin() + end, [](const auto& a, const auto& b)
+                  { return a.first < b.first; });
+        for (int i = begin; i < end;)
+        {
+            const int col = entries[i].first;
+            double sum = 0;
+            for (; i < end && entries[i].first == col; i++)
+            {
+                sum += entries[i].second;
+            }
+            if (sum != 0)
+            {
+                indices_.push_back(col);
+                values_.push_back(sum);
+            }
+        }
+        begin = end;
+        offsets_[r + 1] = int(indices_.size());
+    }
+}
+
+SparseMatrix::SparseMatrix(const Matrix& matrix)
+    : SparseMatrix(matrix.row_size(), matrix.col_size())
+{
+    const double* a = matrix.data();
+    for (int r = 0; r < rows_; r++)
+    {
+        for (int c = 0; c < cols_; c++)
+        {
+            const double e = a[std::ptrdiff_t(r) * cols_ + c];
+            if (e != 0)
+            {
+                indices_.push_back(c);
+                values_.push_back(e);
+            }
+        }
+        offsets_[r + 1] = int(indices_.size());
+    }
+}
+
+bool SparseMatrix::operator==(const SparseMatrix& that) const
+{
+    return rows_ == that.rows_ && cols_ == that.cols_ && offsets_ == that.offsets_ && indices_ == that.indices_ && values_ == that.values_;
+}
+
+bool SparseMatrix::operator!=(const SparseMatrix& that) const
+{
+    return !(*this == that);
+}
+
+double SparseMatrix::at(int row, int col) const
+{
+    utility::check_bounds(row, 0, rows_);
+    utility::check_bounds(col, 0, cols_);
+
+    auto begin = indices_.begin() + offsets_[row];
+    auto end = indices_.begin() + offsets_[row + 1];
+    auto it = std::lower_bound(begin, end, col);
+    return it != end && *it == col ? values_[it - indices_.begin()] : 0;
+}
+
+const std::vector<int>& SparseMatrix::offsets() const
+{
+    return offsets_;
+}
+
+const std::vector<int>& SparseMatrix::indices() const
+{
+    return indices_;
+}
+
+const std::vector<double>& SparseMatrix::values() const
+{
+    return values_;
+}
+
+int SparseMatrix::row_size() const
+{
+    return rows_;
+}
+
+int SparseMatrix::col_size() const
+{
+    return cols_;
+}
+
+int SparseMatrix::nonzero_size() const
+{
+    return int(values_.size());
+}
+
+// Print the nonzeros as [(r, c) value;\n ...] with six decimals, like std::to_string.
+static void print(text::Writer& writer, const SparseMatrix& matrix)
+{
+    writer.put('[');
+    for (int r = 0; r < matrix.row_size(); r++)
+    {
+        for (int i = matrix.offsets()[r]; i < matrix.offsets()[r + 1]; i++)
+        {
+            if (i != 0)
+            {
+                writer.put(";\n ");
+            }
+            writer.put('(');
+            writer.integer(r);
+            writer.put(", ");
+            writer.integer(matrix.indices()[i]);
+            writer.put(") ");
+            writer.fixed(matrix.values()[i]);
+        }
+    }
+    writer.put(']');
+}
+
+std::string SparseMatrix::to_string() const
+{
+    std::string s;
+    text::Writer writer(s);
+    print(writer, *this);
+    writer.flush();
+    return s;
+}
+
+SparseMatrix& SparseMatrix::operator*=(const double c)
+{
+    // scale and drop the products that become zero (c == 0 or underflow), compacting in place
+    int n = 0;
+    int begin = 0;
+    for (int r = 0; r < rows_; r++)
+    {
+        const int end = offsets_[r + 1];
+        for (int i = begin; i < end; i++)
+        {
+            const double e = values_[i] * c;
+            if (e != 0)
+            {
+                indices_[n] = indices_[i];
+                values_[n] = e;
+                n++;
+            }
+        }
+        begin = end;
+        offsets_[r + 1] = n;
+    }
+    indices_.resize(n);
+    values_.resize(n);
+    return *this;
+}
+
+SparseMatrix SparseMatrix::transpose() const
+{
+    SparseMatrix result(cols_, rows_);
+
+    // count the nonzeros of each column
+    for (int col : indices_)
+    {
+        ++result.offsets_[col + 1];
+    }
+    for (int c = 0; c < cols_; c++)
+    {
+        result.offsets_[c + 1] += result.offsets_[c];
+    }
+
+    // scatter row by row, so the row indices come out sorted within each column
+    result.indices_.resize(indices_.size());
+    result.values_.resize(values_.size());
+    std::vector<int> next(result.offsets_.begin(), result.offsets_.end() - 1);
+    for (int r = 0; r < rows_; r++)
+    {
+        for (int i = offsets_[r]; i < offsets_[r + 1]; i++)
+        {
+            const int j = next[indices_[i]]++;
+            result.indices_[j] = r;
+            result.values_[j] = values_[i];
+        }
+    }
+
+    return result;
+}
+
+Matrix SparseMatrix::to_dense() const
+{
+    Matrix result(rows_, cols_, 0);
+    double* a = result.data();
+    for (int r = 0; r < rows_; r++)
+    {
+        for (int i = offsets_[r]; i < offsets_[r + 1]; i++)
+        {
+            a[std::ptrdiff_t(r) * cols_ + indices_[i]] = values_[i];
+        }
+    }
+    return result;
+}
+
+Vector dot(const SparseMatrix& a, const Vector& x)
+{
+    utility::check_size(a.col_size(), x.size());
+
+    Vector result(a.row_size(), 0);
+
+    const int* offsets = a.offsets().data();
+    const int* indices = a.indices().data();
+    const double* values = a.values().data();
+    const double* px = x.data();
+    double* y = result.data();
+    kernel::parallel_for(0, a.row_size(), row_grain(a.row_size(), a.nonzero_size()), [=](int begin, int end)
+                         {
+        for (int r = begin; r < end; r++)
+        {
+            double sum = 0;
+            for (int i = offsets[r]; i < offsets[r + 1]; i++)
+            {
+                sum += values[i] * px[indices[i]];
+            }
+            y[r] = sum;
+        } });
+    return result;
+}
+
+Matrix dot(const SparseMatrix& a, ConstMatrixView b)
+{
+    utility::check_size(a.col_size(), b.row_size());
+
+    Matrix result(a.row_size(), b.col_size(), 0);
+
+    const int* offsets = a.offsets().data();
+    const int* indices = a.indices().data();
+    const double* values = a.values().data();
+    const double* pb = b.data();
+    const int n = b.col_size(), ldb = b.stride();
+    double* c = result.data();
+    kernel::parallel_for(0, a.row_size(), row_grain(a.row_size(), std::int64_t(a.nonzero_size()) * n), [=](int begin, int end)
+                         {
+        for (int r = begin; r < end; r++)
+        {
+            // row r of C accumulates the rows of B picked by the nonzeros of row r of A
+            double* row_c = c + std::ptrdiff_t(r) * n;
+            for (int i = offsets[r]; i < offsets[r + 1]; i++)
+            {
+                const double v = values[i];
+                const double* row_b = pb + std::ptrdiff_t(indices[i]) * ldb;
+                for (int j = 0; j < n; j++)
+                {
+                    row_c[j] += v * row_b[j];
+                }
+            }
+        } });
+    return result;
+}
+
+std::ostream& operator<<(std::ostream& os, const SparseMatrix& matrix)
+{
+    text::Writer writer(os);
+    print(writer, matrix);
+    return os;
+}
+
+} // namespace mla
@@ -0,0 +1,245 @@
+/**
+ * @file SparseMatrix.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief Sparse matrix class.
+ * @version 1.0
+ * @date 2026.10.16
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include "Matrix.h"
+#include "MatrixView.h"
+
+namespace mla
+{
+
+/**
+ * @brief A nonzero element of a sparse matrix, as (row, col, value).
+ */
+struct Triplet
+{
+    int row;
+    int col;
+    double value;
+};
+
+/**
+ * @brief Sparse matrix in compressed sparse row (CSR) format.
+ *
+ * Only the nonzero elements are stored, row by row and sorted by column within a row,
+ * so memory and the cost of the products grow with the number of nonzeros instead of rows x cols.
+ * The transpose of a CSR matrix is its compressed sparse column (CSC) form.
+ */
+class SparseMatrix
+{
+private:
+    // Number of rows.
+    int rows_;
+
+    // Number of columns.
+    int cols_;
+
+    // The nonzeros of row r are at [offsets_[r], offsets_[r + 1]), rows_ + 1 entries.
+    std::vector<int> offsets_;
+
+    // Column index of each nonzero.
+    std::vector<int> indices_;
+
+    // Value of each nonzero.
+    std::vector<double> values_;
+
+public:
+    /*
+     * Constructor / Destructor
+     */
+
+    /**
+     * @brief Construct an empty sparse matrix.
+     */
+    SparseMatrix();
+
+    /**
+     * @brief Construct a rows x cols sparse matrix with no nonzeros.
+     *
+     * @param rows number of rows
+     * @param cols number of columns
+     */
+    SparseMatrix(int rows, int cols);
+
+    /**
+     * @brief Construct a rows x cols sparse matrix from its nonzeros, in any order.
+     *
+     * Values of duplicate positions are summed, and the positions that sum to zero are dropped.
+     *
+     * @param rows number of rows
+     * @param cols number of columns
+     * @param triplets the nonzeros
+     */
+    SparseMatrix(int rows, int cols, const std::vector<Triplet>& triplets);
+
+    /**
+     * @brief Construct a sparse matrix from the nonzeros of a dense matrix.
+     *
+     * @param matrix a dense matrix
+     */
+    explicit SparseMatrix(const Matrix& matrix);
+
+    /*
+     * Comparison
+     */
+
+    /**
+     * @brief Check whether two sparse matrices are equal.
+     *
+     * @param that another sparse matrix
+     * @return true if two sparse matrices are equal
+     */
+    bool operator==(const SparseMatrix& that) const;
+
+    /**
+     * @brief Check whether two sparse matrices are not equal.
+     *
+     * @param that another sparse matrix
+     * @return true if two sparse matrices are not equal
+     */
+    bool operator!=(const SparseMatrix& that) const;
+
+    /*
+     * Access
+     */
+
+    /**
+     * @brief Return the element at the specified position, zero if it is not stored.
+     *
+     * @param row index of the row
+     * @param col index of the column
+     * @return the element at the specified position
+     */
+    double at(int row, int col) const;
+
+    /**
+     * @brief Return the row offsets, the nonzeros of row r are at [offsets()[r], offsets()[r + 1]).
+     *
+     * @return the row offsets
+     */
+    const std::vector<int>& offsets() const;
+
+    /**
+     * @brief Return the column index of each nonzero.
+     *
+     * @return the column index of each nonzero
+     */
+    const std::vector<int>& indices() const;
+
+    /**
+     * @brief Return the value of each nonzero.
+     *
+     * @return the value of each nonzero
+     */
+    const std::vector<double>& values() const;
+
+    /*
+     * Examination (will not change the object itself)
+     */
+
+    /**
+     * @brief Return the number of rows in the matrix.
+     *
+     * @return the number of rows in the matrix
+     */
+    int row_size() const;
+
+    /**
+     * @brief Return the number of columns in the matrix.
+     *
+     * @return the number of columns in the matrix
+     */
+    int col_size() const;
+
+    /**
+     * @brief Return the number of stored nonzeros.
+     *
+     * @return the number of stored nonzeros
+     */
+    int nonzero_size() const;
+
+    /**
+     * @brief Return a string representing the nonzeros of the matrix.
+     *
+     * @return a string representing the nonzeros of the matrix
+     */
+    std::string to_string() const;
+
+    /*
+     * Manipulation (will change the object itself)
+     */
+
+    /**
+     * @brief Scalar multiplication, the elements that become zero are no longer stored.
+     *
+     * @param c a number
+     * @return self reference
+     */
+    SparseMatrix& operator*=(const double c);
+
+    /*
+     * Production (will produce new object)
+     */
+
+    /**
+     * @brief Return the transpose of the matrix, which is also the CSC form of this matrix.
+     *
+     * @return the transpose of the matrix
+     */
+    SparseMatrix transpose() const;
+
+    /**
+     * @brief Return the dense form of the matrix.
+     *
+     * @return the dense form of the matrix
+     */
+    Matrix to_dense() const;
+};
+
+/*
+ * Arithmetic
+ */
+
+/**
+ * @brief Return the product of a sparse matrix and a dense vector.
+ *
+ * @param a a sparse matrix (m rows, n cols)
+ * @param x a vector of n elements
+ * @return the product, a vector of m elements
+ */
+Vector dot(const SparseMatrix& a, const Vector& x);
+
+/**
+ * @brief Return the product of a sparse matrix and a dense matrix.
+ *
+ * @param a a sparse matrix (m rows, k cols)
+ * @param b a matrix or view (k rows, n cols)
+ * @return the product (m rows, n cols)
+ */
+Matrix dot(const SparseMatrix& a, ConstMatrixView b);
+
+/*
+ * Print
+ */
+
+/**
+ * @brief Output the nonzeros of a sparse matrix to the specified output stream.
+ *
+ * @param os an output stream
+ * @param matrix the sparse matrix to be printed to the output stream
+ * @return self reference of the output stream
+ */
+std::ostream& operator<<(std::ostream& os, const SparseMatrix& matrix);
+
+} // namespace mla
+
+#endif // SPARSE_MATRIX_H
@@ -0,0 +1,560 @@
+/**
+ * @file Vec.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief Fixed-size vector class template.
+ * @version 1.0
+ * @date 2026.10.16
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef VEC_H
+#define VEC_H
+
+#include <cmath>       // std::sqrt
+#include <cstddef>     // std::size_t
+#include <type_traits> // std::enable_if_t
+
+#include "Vector.h"
+#include "utility.hpp"
+
+namespace mla
+{
+
+/**
+ * @brief Vector of N elements stored inline, for small vectors such as 2D/3D/4D coordinates.
+ *
+ * The size is part of the type, so operands of different sizes are rejected at compile time.
+ * Everything except length() and the conversions from and to Vector is constexpr.
+ *
+ * @tparam N number of elements
+ */
+template <int N>
+class Vec
+{
+    static_assert(N > 0, "Vec must have at least one element.");
+
+private:
+    // Elements.
+    double elements_[N];
+
+public:
+    /*
+     * Constructor / Destructor
+     */
+
+    /**
+     * @brief Construct a zero vector.
+     */
+    constexpr Vec();
+
+    /**
+     * @brief Construct a vector from exactly N numbers.
+     *
+     * @param elements the elements
+     */
+    template <typename... Ts, std::enable_if_t<sizeof...(Ts) == N && (std::is_arithmetic_v<Ts> && ...), int> = 0>
+    constexpr Vec(Ts... elements);
+
+    /**
+     * @brief Copy a dynamic vector of N elements.
+     *
+     * @param vector a vector of N elements
+     */
+    explicit Vec(const Vector& vector);
+
+    /**
+     * @brief Convert to a dynamic vector.
+     */
+    operator Vector() const;
+
+    /*
+     * Comparison
+     */
+
+    /**
+     * @brief Check whether two vectors are equal.
+     *
+     * @param that another vector
+     * @return true if two vectors are equal
+     */
+    constexpr bool operator==(const Vec& that) const;
+
+    /**
+     * @brief Check whether two vectors are not equal.
+     *
+     * @param that another vector
+     * @return true if two vectors are not equal
+     */
+    constexpr bool operator!=(const Vec& that) const;
+
+    /*
+     * Access
+     */
+
+    /**
+     * @brief Return the reference to the element at the specified position.
+     *
+     * The index is checked unless MLA_NO_BOUNDS_CHECK is defined for the whole project.
+     *
+     * @param index index of the element to return
+     * @return reference to the element at the specified position
+     */
+    constexpr double& operator[](int index);
+
+    /**
+     * @brief Return the const reference to element at the specified position.
+     *
+     * The index is checked unless MLA_NO_BOUNDS_CHECK is defined for the whole project.
+     *
+     * @param index index of the element to return
+     * @return const reference to the element at the specified position
+     */
+    constexpr const double& operator[](int index) const;
+
+    /**
+     * @brief Return the pointer to the first element.
+     *
+     * @return pointer to the first element
+     */
+    constexpr double* data();
+
+    /**
+     * @brief Return the const pointer to the first element.
+     *
+     * @return const pointer to the first element
+     */
+    constexpr const double* data() const;
+
+    /*
+     * Iterator
+     */
+
+    constexpr double* begin();
+
+    constexpr const double* begin() const;
+
+    constexpr double* end();
+
+    constexpr const double* end() const;
+
+    /*
+     * Examination (will not change the object itself)
+     */
+
+    /**
+     * @brief Return the number of elements.
+     *
+     * @return the number of elements
+     */
+    static constexpr int size();
+
+    /**
+     * @brief Return the length of the vector.
+     *
+     * @return the length of the vector
+     */
+    double length() const;
+
+    /**
+     * @brief Determine whether it is a zero vector.
+     *
+     * @return true if it is a zero vector
+     */
+    constexpr bool is_zero() const;
+
+    /*
+     * Manipulation (will change the object itself)
+     */
+
+    /**
+     * @brief Addition.
+     *
+     * @param that another vector
+     * @return self reference
+     */
+    constexpr Vec& operator+=(const Vec& that);
+
+    /**
+     * @brief Difference.
+     *
+     * @param that another vector
+     * @return self reference
+     */
+    constexpr Vec& operator-=(const Vec& that);
+
+    /**
+     * @brief Hadamard product (entrywise product).
+     *
+     * @param that another vector
+     * @return self reference
+     */
+    constexpr Vec& operator*=(const Vec& that);
+
+    /**
+     * @brief Scalar multiplication.
+     *
+     * @param c a number
+     * @return self reference
+     */
+    constexpr Vec& operator*=(const double c);
+};
+
+using Vec2 = Vec<2>;
+using Vec3 = Vec<3>;
+using Vec4 = Vec<4>;
+
+/*
+ * Arithmetic
+ */
+
+/**
+ * @brief Return the addition of two vectors.
+ *
+ * @param a a vector
+ * @param b another vector of the same size
+ * @return the addition of two vectors
+ */
+template <int N>
+constexpr Vec<N> operator+(const Vec<N>& a, const Vec<N>& b);
+
+/**
+ * @brief Return the difference of two vectors.
+ *
+ * @param a a vector
+ * @param b another vector of the same size
+ * @return the difference of two vectors
+ */
+template <int N>
+constexpr Vec<N> operator-(const Vec<N>& a, const Vec<N>& b);
+
+/**
+ * @brief Return the opposite of a vector.
+ *
+ * @param v a vector
+ * @return the opposite of the vector
+ */
+template <int N>
+constexpr Vec<N> operator-(const Vec<N>& v);
+
+/**
+ * @brief Return the Hadamard product (entrywise product) of two vectors.
+ *
+ * @param a a vector
+ * @param b another vector of the same size
+ * @return the Hadamard product (entrywise product) of two vectors
+ */
+template <int N>
+constexpr Vec<N> operator*(const Vec<N>& a, const Vec<N>& b);
+
+/**
+ * @brief Return the scalar multiplication of vector and number.
+ *
+ * @param v a vector
+ * @param c a number
+ * @return the scalar multiplication of vector and number
+ */
+template <int N>
+constexpr Vec<N> operator*(const Vec<N>& v, const double c);
+
+/**
+ * @brief Return the scalar multiplication of vector and number.
+ *
+ * @param c a number
+ * @param v a vector
+ * @return the scalar multiplication of vector and number
+ */
+template <int N>
+constexpr Vec<N> operator*(const double c, const Vec<N>& v);
+
+/**
+ * @brief Return the dot product (scalar product, inner product) of two vectors.
+ *
+ * @param a a vector
+ * @param b another vector of the same size
+ * @return the dot product of two vectors
+ */
+template <int N>
+constexpr double dot(const Vec<N>& a, const Vec<N>& b);
+
+/**
+ * @brief Return the cross product of two 2D vectors, as a one element vector.
+ *
+ * @param a a two dimensional vector
+ * @param b a two dimensional vector
+ * @return the cross product of two vectors
+ */
+constexpr Vec<1> cross(const Vec<2>& a, const Vec<2>& b);
+
+/**
+ * @brief Return the cross product of two 3D vectors.
+ *
+ * @param a a three dimensional vector
+ * @param b a three dimensional vector
+ * @return the cross product of two vectors
+ */
+constexpr Vec<3> cross(const Vec<3>& a, const Vec<3>& b);
+
+/*
+ * Print
+ */
+
+/**
+ * @brief Output vector data to the specified output stream.
+ *
+ * @param os an output stream
+ * @param vec the vector to be printed to the output stream
+ * @return self reference of the output stream
+ */
+template <int N>
+std::ostream& operator<<(std::ostream& os, const Vec<N>& vec);
+
+template <int N>
+constexpr Vec<N>::Vec()
+    : elements_{}
+{
+}
+
+template <int N>
+template <typename... Ts, std::enable_if_t<sizeof...(Ts) == N && (std::is_arithmetic_v<Ts> && ...), int>>
+constexpr Vec<N>::Vec(Ts... elements)
+    : elements_{double(elements)...}
+{
+}
+
+template <int N>
+Vec<N>::Vec(const Vector& vector)
+    : elements_{}
+{
+    utility::check_size(vector.size(), N);
+
+    for (int i = 0; i < N; i++)
+    {
+        elements_[i] = vector.data()[i];
+    }
+}
+
+template <int N>
+Vec<N>::operator Vector() const
+{
+    Vector vector(N, 0);
+    for (int i = 0; i < N; i++)
+    {
+        vector.data()[i] = elements_[i];
+    }
+    return vector;
+}
+
+template <int N>
+constexpr bool Vec<N>::operator==(const Vec& that) const
+{
+    for (int i = 0; i < N; i++)
+    {
+        if (elements_[i] != that.elements_[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int N>
+constexpr bool Vec<N>::operator!=(const Vec& that) const
+{
+    return !(*this == that);
+}
+
+template <int N>
+constexpr double& Vec<N>::operator[](int index)
+{
+    utility::check_index(index, N);
+
+    return elements_[index];
+}
+
+template <int N>
+constexpr const double& Vec<N>::operator[](int index) const
+{
+    utility::check_index(index, N);
+
+    return elements_[index];
+}
+
+template <int N>
+constexpr double* Vec<N>::data()
+{
+    return elements_;
+}
+
+template <int N>
+constexpr const double* Vec<N>::data() const
+{
+    return elements_;
+}
+
+template <int N>
+constexpr double* Vec<N>::begin()
+{
+    return elements_;
+}
+
+template <int N>
+constexpr const double* Vec<N>::begin() const
+{
+    return elements_;
+}
+
+template <int N>
+constexpr double* Vec<N>::end()
+{
+    return elements_ + N;
+}
+
+template <int N>
+constexpr const double* Vec<N>::end() const
+{
+    return elements_ + N;
+}
+
+template <int N>
+constexpr int Vec<N>::size()
+{
+    return N;
+}
+
+template <int N>
+double Vec<N>::length() const
+{
+    return std::sqrt(dot(*this, *this));
+}
+
+template <int N>
+constexpr bool Vec<N>::is_zero() const
+{
+    for (int i = 0; i < N; i++)
+    {
+        if (elements_[i] != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int N>
+constexpr Vec<N>& Vec<N>::operator+=(const Vec& that)
+{
+    for (int i = 0; i < N; i++)
+    {
+        elements_[i] += that.elements_[i];
+    }
+    return *this;
+}
+
+template <int N>
+constexpr Vec<N>& Vec<N>::operator-=(const Vec& that)
+{
+    for (int i = 0; i < N; i++)
+    {
+        elements_[i] -= that.elements_[i];
+    }
+    return *this;
+}
+
+template <int N>
+constexpr Vec<N>& Vec<N>::operator*=(const Vec& that)
+{
+    for (int i = 0; i < N; i++)
+    {
+        elements_[i] *= that.elements_[i];
+    }
+    return *this;
+}
+
+template <int N>
+constexpr Vec<N>& Vec<N>::operator*=(const double c)
+{
+    for (int i = 0; i < N; i++)
+    {
+        elements_[i] *= c;
+    }
+    return *this;
+}
+
+template <int N>
+constexpr Vec<N> operator+(const Vec<N>& a, const Vec<N>& b)
+{
+    Vec<N> result = a;
+    return result += b;
+}
+
+template <int N>
+constexpr Vec<N> operator-(const Vec<N>& a, const Vec<N>& b)
+{
+    Vec<N> result = a;
+    return result -= b;
+}
+
+template <int N>
+constexpr Vec<N> operator-(const Vec<N>& v)
+{
+    Vec<N> result = v;
+    return result *= -1;
+}
+
+template <int N>
+constexpr Vec<N> operator*(const Vec<N>& a, const Vec<N>& b)
+{
+    Vec<N> result = a;
+    return result *= b;
+}
+
+template <int N>
+constexpr Vec<N> operator*(const Vec<N>& v, const double c)
+{
+    Vec<N> result = v;
+    return result *= c;
+}
+
+template <int N>
+constexpr Vec<N> operator*(const double c, const Vec<N>& v)
+{
+    return v * c;
+}
+
+template <int N>
+constexpr double dot(const Vec<N>& a, const Vec<N>& b)
+{
+    const double* x = a.data();
+    const double* y = b.data();
+    double result = 0;
+    for (int i = 0; i < N; i++)
+    {
+        result += x[i] * y[i];
+    }
+    return result;
+}
+
+constexpr Vec<1> cross(const Vec<2>& a, const Vec<2>& b)
+{
+    const double* x = a.data();
+    const double* y = b.data();
+    return Vec<1>(x[0] * y[1] - x[1] * y[0]);
+}
+
+constexpr Vec<3> cross(const Vec<3>& a, const Vec<3>& b)
+{
+    const double* x = a.data();
+    const double* y = b.data();
+    return Vec<3>(x[1] * y[2] - x[2] * y[1], x[2] * y[0] - x[0] * y[2], x[0] * y[1] - x[1] * y[0]);
+}
+
+template <int N>
+std::ostream& operator<<(std::ostream& os, const Vec<N>& vec)
+{
+    return os << Vector(vec);
+}
+
+} // namespace mla
+
+#endif // VEC_H
@@ -2,48 +2,59 @@
 
 #include <climits> // INT_MAX
 #include <cmath>   // std::sqrt
+#include <complex> // std::complex std::conj std::norm
 
+#include "simd.h"
+#include "text.hpp"
 #include "utility.hpp"
 
 namespace mla
 {
 
-Vector::Vector()
+template <typename T>
+BasicVector<T>::BasicVector()
     : elements_()
 {
 }
 
-Vector::Vector(const std::initializer_list<double>& il)
+template <typename T>
+BasicVector<T>::BasicVector(const std::initializer_list<T>& il)
     : elements_(il)
 {
 }
 
-Vector::Vector(int n, double element)
+template <typename T>
+BasicVector<T>::BasicVector(int n, const T& element)
     : elements_(n, element)
 {
 }
 
-Vector::Vector(const Vector& that)
+template <typename T>
+BasicVector<T>::BasicVector(const BasicVector& that)
     : elements_(that.elements_)
 {
 }
 
-Vector::Vector(Vector&& that)
+template <typename T>
+BasicVector<T>::BasicVector(BasicVector&& that) noexcept
     : elements_(std::move(that.elements_))
 {
 }
 
-bool Vector::operator==(const Vector& that) const
+template <typename T>
+bool BasicVector<T>::operator==(const BasicVector& that) const
 {
     return elements_ == that.elements_;
 }
 
-bool Vector::operator!=(const Vector& that) const
+template <typename T>
+bool BasicVector<T>::operator!=(const BasicVector& that) const
 {
     return !(elements_ == that.elements_);
 }
 
-Vector& Vector::operator=(const Vector& that)
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator=(const BasicVector& that)
 {
     if (this != &that)
     {
@@ -53,7 +64,8 @@ Vector& Vector::operator=(const Vector& that)
     return *this;
 }
 
-Vector& Vector::operator=(Vector&& that)
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator=(BasicVector&& that)
 {
     if (this != &that)
     {
@@ -63,89 +75,101 @@ Vector& Vector::operator=(Vector&& that)
     return *this;
 }
 
-double& Vector::operator[](int index)
+template <typename T>
+T* BasicVector<T>::data()
 {
-    utility::check_bounds(index, 0, size());
-
-    return elements_[index];
+    return elements_.data();
 }
 
-const double& Vector::operator[](int index) const
+template <typename T>
+const T* BasicVector<T>::data() const
 {
-    utility::check_bounds(index, 0, size());
-
-    return elements_[index];
+    return elements_.data();
 }
 
-std::vector<double>::iterator Vector::begin()
+template <typename T>
+T* BasicVector<T>::begin()
 {
     return elements_.begin();
 }
 
-std::vector<double>::const_iterator Vector::begin() const
+template <typename T>
+const T* BasicVector<T>::begin() const
 {
-    return elements_.cbegin();
+    return elements_.begin();
 }
 
-std::vector<double>::iterator Vector::end()
+template <typename T>
+T* BasicVector<T>::end()
 {
     return elements_.end();
 }
 
-std::vector<double>::const_iterator Vector::end() const
-{
-    return elements_.cend();
-}
-
-int Vector::size() const
+template <typename T>
+const T* BasicVector<T>::end() const
 {
-    return int(elements_.size());
+    return elements_.end();
 }
 
-bool Vector::is_empty() const
+template <typename T>
+bool BasicVector<T>::is_empty() const
 {
     return elements_.empty();
 }
 
-std::string Vector::to_string() const
+// Print the elements as [e1 e2 ...] with six decimals, like std::to_string.
+template <typename T>
+static void print(text::Writer& writer, const BasicVector<T>& vector)
 {
-    if (elements_.empty())
-    {
-        return "[]";
-    }
-
-    auto it = elements_.begin();
-    std::string s = "[";
-    while (true)
+    writer.put('[');
+    for (int i = 0; i < vector.size(); i++)
     {
-        s.append(std::to_string(*it++));
-        if (it == elements_.end())
+        if (i != 0)
         {
-            return s.append("]");
+            writer.put(' ');
         }
-        s.append(" ");
+        writer.fixed(vector.data()[i]);
     }
+    writer.put(']');
+}
+
+template <typename T>
+std::string BasicVector<T>::to_string() const
+{
+    std::string s;
+    text::Writer writer(s);
+    print(writer, *this);
+    writer.flush();
     return s;
 }
 
-double Vector::length() const
+template <typename T>
+utility::real_t<T> BasicVector<T>::length() const
 {
     utility::check_empty(size());
 
-    double result = 0;
-    for (int i = 0; i < size(); i++)
+    if constexpr (utility::is_complex_v<T>)
     {
-        result += elements_[i] * elements_[i];
+        utility::real_t<T> sum = 0;
+        for (const T& e : elements_)
+        {
+            sum += std::norm(e);
+        }
+        return std::sqrt(sum);
+    }
+    else
+    {
+        return std::sqrt(kernel::dot(size(), data(), data()));
     }
-    return std::sqrt(result);
 }
 
-int Vector::count_leading_zeros() const
+template <typename T>
+int BasicVector<T>::count_leading_zeros() const
 {
     utility::check_empty(size());
 
     int lz = 0;
-    while (elements_[lz] == 0)
+    while (elements_[lz] == T(0))
     {
         lz++;
         if (lz == size())
@@ -156,12 +180,14 @@ int Vector::count_leading_zeros() const
     return lz;
 }
 
-bool Vector::is_zero() const
+template <typename T>
+bool BasicVector<T>::is_zero() const
 {
     return count_leading_zeros() == size();
 }
 
-Vector& Vector::append(double element)
+template <typename T>
+BasicVector<T>& BasicVector<T>::append(const T& element)
 {
     utility::check_full(size(), INT_MAX);
 
@@ -169,15 +195,22 @@ Vector& Vector::append(double element)
     return *this;
 }
 
-Vector& Vector::append(const Vector& vector)
+template <typename T>
+BasicVector<T>& BasicVector<T>::append(const BasicVector& vector)
 {
     utility::check_full(size() + vector.size() - 1, INT_MAX);
 
-    elements_.insert(elements_.end(), vector.elements_.begin(), vector.elements_.end());
+    if (&vector == this)
+    {
+        return append(BasicVector(vector));
+    }
+
+    elements_.append(vector.elements_.begin(), vector.elements_.end());
     return *this;
 }
 
-Vector& Vector::unitize()
+template <typename T>
+BasicVector<T>& BasicVector<T>::unitize()
 {
     utility::check_empty(size());
 
@@ -186,103 +219,88 @@ Vector& Vector::unitize()
         throw std::runtime_error("Error: The zero vector can not be unitized.");
     }
 
-    return *this = *this * (1.0 / length());
+    return *this *= T(1) / length();
 }
 
-Vector& Vector::operator+=(const Vector& vector)
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator+=(const BasicVector& vector)
 {
     utility::check_empty(size());
     utility::check_size(size(), vector.size());
 
-    for (int i = 0; i < size(); i++)
-    {
-        (*this)[i] += vector[i];
-    }
+    kernel::add(size(), vector.data(), data());
     return *this;
 }
 
-Vector& Vector::operator-=(const Vector& vector)
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator-=(const BasicVector& vector)
 {
     utility::check_empty(size());
     utility::check_size(size(), vector.size());
 
-    for (int i = 0; i < size(); i++)
-    {
-        (*this)[i] -= vector[i];
-    }
+    kernel::sub(size(), vector.data(), data());
     return *this;
 }
 
-Vector& Vector::operator*=(const Vector& vector)
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator*=(const BasicVector& vector)
 {
     utility::check_empty(size());
     utility::check_size(size(), vector.size());
 
-    for (int i = 0; i < size(); i++)
-    {
-        (*this)[i] *= vector[i];
-    }
+    kernel::mul(size(), vector.data(), data());
     return *this;
 }
 
-Vector& Vector::operator*=(const double c)
+template <typename T>
+BasicVector<T>& BasicVector<T>::operator*=(const T& c)
 {
     utility::check_empty(size());
 
-    for (int i = 0; i < size(); i++)
-    {
-        (*this)[i] *= c;
-    }
+    kernel::scale(size(), c, data());
     return *this;
 }
 
-Vector operator+(const Vector& a, const Vector& b)
-{
-    return Vector(a) += b;
-}
-
-Vector operator-(const Vector& a, const Vector& b)
-{
-    return Vector(a) -= b;
-}
-
-Vector operator*(const Vector& a, const Vector& b)
-{
-    return Vector(a) *= b;
-}
-
-Vector operator*(const Vector& v, const double c)
+// Inner product <a, b>, conjugating a for complex vectors.
+template <typename T>
+static T inner(const BasicVector<T>& a, const BasicVector<T>& b)
 {
-    return Vector(v) *= c;
+    if constexpr (utility::is_complex_v<T>)
+    {
+        T sum = 0;
+        for (int i = 0; i < a.size(); i++)
+        {
+            sum += std::conj(a[i]) * b[i];
+        }
+        return sum;
+    }
+    else
+    {
+        return kernel::dot(a.size(), a.data(), b.data());
+    }
 }
 
-Vector operator*(const double c, const Vector& v)
-{
-    return v * c;
-}
-
-double dot(const Vector& a, const Vector& b)
+template <typename T>
+T dot(const BasicVector<T>& a, const BasicVector<T>& b)
 {
     utility::check_empty(a.size());
     utility::check_size(a.size(), b.size());
 
-    double result = 0;
-    for (int i = 0; i < a.size(); i++)
-    {
-        result += a[i] * b[i];
-    }
-    return result;
+    return kernel::dot(a.size(), a.data(), b.data());
 }
 
-Vector cross(const Vector& a, const Vector& b)
+template <typename T>
+BasicVector<T> cross(const BasicVector<T>& a, const BasicVector<T>& b)
 {
+    const T* x = a.data();
+    const T* y = b.data();
     if (a.size() == 2 && b.size() == 2)
     {
-        return Vector({a[0] * b[1] - a[1] * b[0]});
+        return BasicVector<T>({x[0] * y[1] - x[1] * y[0]});
     }
     else if (a.size() == 3 && b.size() == 3)
     {
-        return Vector({a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]});
+        return BasicVector<T>({x[1] * y[2] - x[2] * y[1], x[2] * y[0] - x[0] * y[2], x[0] * y[1] - x[1] * y[0]});
     }
     else
     {
@@ -290,25 +308,69 @@ Vector cross(const Vector& a, const Vector& b)
     }
 }
 
-bool is_orthogonal(const Vector& a, const Vector& b)
+template <typename T>
+bool is_orthogonal(const BasicVector<T>& a, const BasicVector<T>& b)
 {
     utility::check_empty(a.size());
     utility::check_size(a.size(), b.size());
 
-    return dot(a, b) == 0;
+    return inner(a, b) == T(0);
 }
 
-bool is_parallel(const Vector& a, const Vector& b)
+template <typename T>
+bool is_parallel(const BasicVector<T>& a, const BasicVector<T>& b)
 {
     utility::check_empty(a.size());
     utility::check_size(a.size(), b.size());
 
-    return std::abs(dot(a, b)) == a.length() * b.length();
+    return std::abs(inner(a, b)) == a.length() * b.length();
+}
+
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const BasicVector<T>& vector)
+{
+    text::Writer writer(os);
+    print(writer, vector);
+    return os;
+}
+
+double dot(const Vector& a, const Vector& b)
+{
+    return dot<double>(a, b);
+}
+
+Vector cross(const Vector& a, const Vector& b)
+{
+    return cross<double>(a, b);
+}
+
+bool is_orthogonal(const Vector& a, const Vector& b)
+{
+    return is_orthogonal<double>(a, b);
+}
+
+bool is_parallel(const Vector& a, const Vector& b)
+{
+    return is_parallel<double>(a, b);
 }
 
 std::ostream& operator<<(std::ostream& os, const Vector& vector)
 {
-    return os << vector.to_string();
+    return operator<< <double>(os, vector);
 }
 
+#define MLA_INSTANTIATE_VECTOR(T)                                                    \
+    template class BasicVector<T>;                                                   \
+    template T dot<T>(const BasicVector<T>& a, const BasicVector<T>& b);             \
+    template BasicVector<T> cross(const BasicVector<T>& a, const BasicVector<T>& b); \
+    template bool is_orthogonal(const BasicVector<T>& a, const BasicVector<T>& b);   \
+    template bool is_parallel(const BasicVector<T>& a, const BasicVector<T>& b);     \
+    template std::ostream& operator<<(std::ostream& os, const BasicVector<T>& vector);
+
+MLA_INSTANTIATE_VECTOR(float)
+MLA_INSTANTIATE_VECTOR(double)
+MLA_INSTANTIATE_VECTOR(std::complex<double>)
+
+#undef MLA_INSTANTIATE_VECTOR
+
 } // namespace mla
@@ -1,7 +1,7 @@
 /**
  * @file Vector.h
  * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
- * @brief Vector class.
+ * @brief Vector class template.
  * @version 1.0
  * @date 2023.10.16
  *
@@ -11,26 +11,44 @@
 #ifndef VECTOR_H
 #define VECTOR_H
 
-#include <ostream> // std::ostream
-#include <string>  // std::string
-#include <utility> // std::initializer_list
-#include <vector>  // std::vector
+#include <ostream>     // std::ostream
+#include <string>      // std::string
+#include <type_traits> // std::decay_t std::enable_if_t
+#include <utility>     // std::forward std::initializer_list std::move
+
+#include "Allocator.h"
+#include "Expression.h"
+#include "SmallVector.h"
+#include "utility.hpp"
 
 namespace mla
 {
 
 /**
- * @brief Vector class.
+ * @brief Vector class template.
+ *
+ * Instantiated for float, double and std::complex<double>. Float halves the memory traffic and doubles
+ * the elements per SIMD instruction, complex numbers use portable kernels.
+ *
+ * Up to SMALL_BYTES of elements are stored inside the object, so short vectors never allocate. Longer ones
+ * are ALIGNMENT aligned and come from the memory resource of the constructing thread, see set_memory_resource().
+ *
+ * @tparam T scalar type of the elements
  */
-class Vector
+template <typename T>
+class BasicVector
 {
-    friend class Matrix;
+    template <typename U>
+    friend class BasicMatrix;
 
 private:
     // Vector elements.
-    std::vector<double> elements_;
+    SmallVector<T> elements_;
 
 public:
+    // Scalar type of the elements.
+    using value_type = T;
+
     /*
      * Constructor / Destructor
      */
@@ -38,14 +56,14 @@ public:
     /**
      * @brief Construct a new vector object.
      */
-    Vector();
+    BasicVector();
 
     /**
      * @brief Construct a vector based on the given initializer list.
      *
      * @param il initializer list
      */
-    Vector(const std::initializer_list<double>& il);
+    BasicVector(const std::initializer_list<T>& il);
 
     /**
      * @brief Construct a vector with n identical elements.
@@ -53,21 +71,29 @@ public:
      * @param n number of elements
      * @param element the element
      */
-    Vector(int n, double element);
+    BasicVector(int n, const T& element);
 
     /**
      * @brief Copy constructor.
      *
      * @param that another vector
      */
-    Vector(const Vector& that);
+    BasicVector(const BasicVector& that);
 
     /**
      * @brief Move constructor.
      *
      * @param that another vector
      */
-    Vector(Vector&& that);
+    BasicVector(BasicVector&& that) noexcept;
+
+    /**
+     * @brief Construct a vector by evaluating an expression in a single pass.
+     *
+     * @param expression a vector expression
+     */
+    template <typename Node>
+    BasicVector(const VectorExpression<Node>& expression);
 
     /*
      * Comparison
@@ -79,7 +105,7 @@ public:
      * @param that another vector
      * @return true if two vectors are equal
      */
-    bool operator==(const Vector& that) const;
+    bool operator==(const BasicVector& that) const;
 
     /**
      * @brief Check whether two vectors are not equal.
@@ -87,7 +113,7 @@ public:
      * @param that another vector
      * @return true if two vectors are not equal
      */
-    bool operator!=(const Vector& that) const;
+    bool operator!=(const BasicVector& that) const;
 
     /*
      * Assignment
@@ -99,15 +125,26 @@ public:
      * @param that another vector
      * @return self reference
      */
-    Vector& operator=(const Vector& that);
+    BasicVector& operator=(const BasicVector& that);
 
     /**
      * @brief Move assignment operator.
      *
+     * The elements are copied if that uses another memory resource, so unlike the move constructor it may allocate.
+     *
      * @param that another vector
      * @return self reference
      */
-    Vector& operator=(Vector&& that);
+    BasicVector& operator=(BasicVector&& that);
+
+    /**
+     * @brief Evaluate an expression in a single pass and assign the result.
+     *
+     * @param expression a vector expression
+     * @return self reference
+     */
+    template <typename Node>
+    BasicVector& operator=(const VectorExpression<Node>& expression);
 
     /*
      * Access
@@ -116,18 +153,52 @@ public:
     /**
      * @brief Return the reference to the element at the specified position.
      *
+     * The index is checked unless MLA_NO_BOUNDS_CHECK is defined for the whole project.
+     *
      * @param index index of the element to return
      * @return reference to the element at the specified position
      */
-    double& operator[](int index);
+    T& operator[](int index);
 
     /**
      * @brief Return the const reference to element at the specified position.
      *
+     * The index is checked unless MLA_NO_BOUNDS_CHECK is defined for the whole project.
+     *
      * @param index index of the element to return
      * @return const reference to the element at the specified position
      */
-    const double& operator[](int index) const;
+    const T& operator[](int index) const;
+
+    /**
+     * @brief Return the reference to the element at the specified position, the index is always checked.
+     *
+     * @param index index of the element to return
+     * @return reference to the element at the specified position
+     */
+    T& at(int index);
+
+    /**
+     * @brief Return the const reference to element at the specified position, the index is always checked.
+     *
+     * @param index index of the element to return
+     * @return const reference to the element at the specified position
+     */
+    const T& at(int index) const;
+
+    /**
+     * @brief Return the pointer to the first element.
+     *
+     * @return pointer to the first element
+     */
+    T* data();
+
+    /**
+     * @brief Return the const pointer to the first element.
+     *
+     * @return const pointer to the first element
+     */
+    const T* data() const;
 
     /*
      * Iterator
@@ -138,28 +209,28 @@ public:
      *
      * @return iterator to the first element
      */
-    std::vector<double>::iterator begin();
+    T* begin();
 
     /**
      * @brief Return a const iterator to the first element of the vector.
      *
      * @return const iterator to the first element
      */
-    std::vector<double>::const_iterator begin() const;
+    const T* begin() const;
 
     /**
      * @brief Return an iterator to the element following the last element of the vector.
      *
      * @return iterator to the element following the last element
      */
-    std::vector<double>::iterator end();
+    T* end();
 
     /**
      * @brief Return a const iterator to the element following the last element of the vector.
      *
      * @return const iterator to the element following the last element
      */
-    std::vector<double>::const_iterator end() const;
+    const T* end() const;
 
     /*
      * Examination (will not change the object itself)
@@ -191,7 +262,7 @@ public:
      *
      * @return the length of the vector
      */
-    double length() const;
+    utility::real_t<T> length() const;
 
     /**
      * @brief Calculate the number of leading zeros for this vector.
@@ -217,7 +288,7 @@ public:
      * @param element element to be appended to the vector
      * @return self reference
      */
-    Vector& append(double element);
+    BasicVector& append(const T& element);
 
     /**
      * @brief Append the specified vector to the end of the vector.
@@ -225,14 +296,14 @@ public:
      * @param vector vector to be appended to the vector
      * @return self reference
      */
-    Vector& append(const Vector& vector);
+    BasicVector& append(const BasicVector& vector);
 
     /**
      * @brief Unitize this vector.
      *
      * @return self reference
      */
-    Vector& unitize();
+    BasicVector& unitize();
 
     /**
      * @brief Addition.
@@ -240,7 +311,16 @@ public:
      * @param vector another vector
      * @return self reference
      */
-    Vector& operator+=(const Vector& vector);
+    BasicVector& operator+=(const BasicVector& vector);
+
+    /**
+     * @brief Addition of an expression, evaluated in the same pass.
+     *
+     * @param expression a vector expression
+     * @return self reference
+     */
+    template <typename Node>
+    BasicVector& operator+=(const VectorExpression<Node>& expression);
 
     /**
      * @brief Difference.
@@ -248,7 +328,16 @@ public:
      * @param vector another vector
      * @return self reference
      */
-    Vector& operator-=(const Vector& vector);
+    BasicVector& operator-=(const BasicVector& vector);
+
+    /**
+     * @brief Difference of an expression, evaluated in the same pass.
+     *
+     * @param expression a vector expression
+     * @return self reference
+     */
+    template <typename Node>
+    BasicVector& operator-=(const VectorExpression<Node>& expression);
 
     /**
      * @brief Hadamard product (entrywise product).
@@ -256,7 +345,7 @@ public:
      * @param vector another vector
      * @return self reference
      */
-    Vector& operator*=(const Vector& vector);
+    BasicVector& operator*=(const BasicVector& vector);
 
     /**
      * @brief Scalar multiplication.
@@ -264,57 +353,147 @@ public:
      * @param c a number
      * @return self reference
      */
-    Vector& operator*=(const double c);
+    BasicVector& operator*=(const T& c);
 };
 
+// Vector of double, the default scalar type.
+using Vector = BasicVector<double>;
+
 /*
  * Arithmetic
  */
 
+// Whether T is a vector, a view of a vector, such as a row of a matrix, or a vector expression.
+template <typename T>
+struct is_vector_operand : std::false_type
+{
+};
+
+template <typename T>
+struct is_vector_operand<BasicVector<T>> : std::true_type
+{
+};
+
+template <typename T>
+struct is_vector_operand<BasicVectorView<T>> : std::true_type
+{
+};
+
+template <typename E>
+struct is_vector_operand<VectorExpression<E>> : std::true_type
+{
+};
+
+template <typename T>
+constexpr bool is_vector_operand_v = is_vector_operand<std::decay_t<T>>::value;
+
+// Vectors, views and vector expressions of the same scalar type, possibly references.
+template <typename T, typename... Ts>
+using enable_if_vector_operands = std::enable_if_t<is_vector_operand_v<T> && (is_vector_operand_v<Ts> && ...) && (std::is_same_v<typename std::decay_t<T>::value_type, typename std::decay_t<Ts>::value_type> && ...), int>;
+
+// Whether an operand forwarded as T is a temporary vector, whose storage can take the result.
+template <typename T>
+constexpr bool is_temporary_vector_v = !std::is_reference_v<T> && !std::is_const_v<T> && std::is_same_v<T, BasicVector<typename std::decay_t<T>::value_type>>;
+
+// Whether an operand is a vector expression rather than a vector or a view, possibly a reference.
+template <typename T>
+struct is_vector_expression : std::false_type
+{
+};
+
+template <typename E>
+struct is_vector_expression<VectorExpression<E>> : std::true_type
+{
+};
+
+template <typename T>
+constexpr bool is_vector_expression_v = is_vector_expression<std::decay_t<T>>::value;
+
+/*
+ * Operations on vectors return vectors. An operation with an expression operand returns an expression instead,
+ * evaluated in a single pass when it is assigned to a vector, so lazy(a) + lazy(b) * 2 reads a and b only once.
+ */
+
+/**
+ * @brief Return an expression of a vector, so the operations applied to it are fused into one pass.
+ *
+ * The expression refers to the elements of the vector, which must outlive it (do not store it with `auto`).
+ *
+ * @param vector a vector
+ * @return an expression of the vector
+ */
+template <typename T>
+VectorExpression<expr::Leaf<T>> lazy(const BasicVector<T>& vector);
+
 /**
  * @brief Return the addition of two vectors.
  *
- * @param a non-empty vector
- * @param b another vector of the same size as a
- * @return the addition of two vectors
+ * @param a non-empty vector, view or vector expression
+ * @param b another vector, view or vector expression of the same size as a
+ * @return the addition of two vectors, held by a temporary operand if there is one, or an expression if an operand is an expression
  */
-Vector operator+(const Vector& a, const Vector& b);
+template <typename A, typename B, enable_if_vector_operands<A, B> = 0>
+auto operator+(A&& a, B&& b);
 
 /**
  * @brief Return the difference of two vectors.
  *
- * @param a non-empty vector
- * @param b another vector of the same size as a
- * @return the difference of two vectors
+ * @param a non-empty vector, view or vector expression
+ * @param b another vector, view or vector expression of the same size as a
+ * @return the difference of two vectors, held by a temporary operand if there is one, or an expression if an operand is an expression
  */
-Vector operator-(const Vector& a, const Vector& b);
+template <typename A, typename B, enable_if_vector_operands<A, B> = 0>
+auto operator-(A&& a, B&& b);
 
 /**
  * @brief Return the Hadamard product (entrywise product) of two vectors.
  *
- * @param a non-empty vector
- * @param b another vector of the same size as a
- * @return the Hadamard product (entrywise product) of two vectors
+ * @param a non-empty vector, view or vector expression
+ * @param b another vector, view or vector expression of the same size as a
+ * @return the Hadamard product (entrywise product) of two vectors, held by a temporary operand if there is one, or an expression if an operand is an expression
  */
-Vector operator*(const Vector& a, const Vector& b);
+template <typename A, typename B, enable_if_vector_operands<A, B> = 0>
+auto operator*(A&& a, B&& b);
 
 /**
  * @brief Return the scalar multiplication of vector and number.
  *
- * @param v non-empty vector
+ * @param v non-empty vector, view or vector expression
  * @param c a number
- * @return the scalar multiplication of vector and number
+ * @return the scalar multiplication of vector and number, held by v if it is a temporary, or an expression if v is an expression
  */
-Vector operator*(const Vector& v, const double c);
+template <typename V, enable_if_vector_operands<V> = 0>
+auto operator*(V&& v, const typename std::decay_t<V>::value_type& c);
 
 /**
  * @brief Return the scalar multiplication of vector and number.
  *
  * @param c a number
- * @param v non-empty vector
- * @return the scalar multiplication of vector and number
+ * @param v non-empty vector, view or vector expression
+ * @return the scalar multiplication of vector and number, held by v if it is a temporary, or an expression if v is an expression
+ */
+template <typename V, enable_if_vector_operands<V> = 0>
+auto operator*(const typename std::decay_t<V>::value_type& c, V&& v);
+
+/**
+ * @brief Check whether the result of an expression equals a vector.
+ *
+ * @param a a vector expression
+ * @param b a vector
+ * @return true if they are equal
  */
-Vector operator*(const double c, const Vector& v);
+template <typename E, typename T>
+bool operator==(const VectorExpression<E>& a, const BasicVector<T>& b);
+
+/**
+ * @brief Check whether the result of an expression does not equal a vector.
+ *
+ * @param a a vector expression
+ * @param b a vector
+ * @return true if they are not equal
+ */
+template <typename E, typename T>
+bool operator!=(const VectorExpression<E>& a, const BasicVector<T>& b);
 
 /**
  * @brief Return the dot product (scalar product, inner product) of two vectors.
@@ -323,7 +502,18 @@ Vector operator*(const double c, const Vector& v);
  * @param b another vector of the same size as a
  * @return the dot product of two vectors
  */
-double dot(const Vector& a, const Vector& b);
+template <typename T>
+T dot(const BasicVector<T>& a, const BasicVector<T>& b);
+
+/**
+ * @brief Return the dot product (scalar product, inner product) of two vectors or vector expressions.
+ *
+ * @param a non-empty vector, view or vector expression
+ * @param b another vector, view or vector expression of the same size as a
+ * @return the dot product of two vectors
+ */
+template <typename A, typename B, enable_if_vector_operands<A, B> = 0>
+typename A::value_type dot(const A& a, const B& b);
 
 /**
  * @brief Return the cross product of two vectors.
@@ -332,7 +522,8 @@ double dot(const Vector& a, const Vector& b);
  * @param b a three dimensional vector
  * @return the cross product of two vectors.
  */
-Vector cross(const Vector& a, const Vector& b);
+template <typename T>
+BasicVector<T> cross(const BasicVector<T>& a, const BasicVector<T>& b);
 
 /**
  * @brief Determine whether two vectors are orthogonal.
@@ -341,7 +532,8 @@ Vector cross(const Vector& a, const Vector& b);
  * @param b another vector of the same size as a
  * @return true if the two vectors are orthogonal
  */
-bool is_orthogonal(const Vector& a, const Vector& b);
+template <typename T>
+bool is_orthogonal(const BasicVector<T>& a, const BasicVector<T>& b);
 
 /**
  * @brief Determine whether two vectors are paralle.
@@ -350,7 +542,8 @@ bool is_orthogonal(const Vector& a, const Vector& b);
  * @param b another vector of the same size as a
  * @return true if the two vectors are paralle
  */
-bool is_parallel(const Vector& a, const Vector& b);
+template <typename T>
+bool is_parallel(const BasicVector<T>& a, const BasicVector<T>& b);
 
 /*
  * Print
@@ -363,8 +556,229 @@ bool is_parallel(const Vector& a, const Vector& b);
  * @param vector the vector to be printed to the output stream
  * @return self reference of the output stream
  */
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const BasicVector<T>& vector);
+
+/*
+ * Overloads for Vector. Unlike the templates they also take arguments that convert to a Vector,
+ * such as a double expression or a braced list: cross(lazy(a) + b, {0, 0, 1}), std::cout << lazy(a) * 2.
+ */
+
+double dot(const Vector& a, const Vector& b);
+
+Vector cross(const Vector& a, const Vector& b);
+
+bool is_orthogonal(const Vector& a, const Vector& b);
+
+bool is_parallel(const Vector& a, const Vector& b);
+
 std::ostream& operator<<(std::ostream& os, const Vector& vector);
 
+template <typename T>
+inline T& BasicVector<T>::operator[](int index)
+{
+    utility::check_index(index, size());
+
+    return elements_[index];
+}
+
+template <typename T>
+inline const T& BasicVector<T>::operator[](int index) const
+{
+    utility::check_index(index, size());
+
+    return elements_[index];
+}
+
+template <typename T>
+inline T& BasicVector<T>::at(int index)
+{
+    utility::check_bounds(index, 0, size());
+
+    return elements_[index];
+}
+
+template <typename T>
+inline const T& BasicVector<T>::at(int index) const
+{
+    utility::check_bounds(index, 0, size());
+
+    return elements_[index];
+}
+
+template <typename T>
+inline int BasicVector<T>::size() const
+{
+    return int(elements_.size());
+}
+
+template <typename T>
+template <typename Node>
+BasicVector<T>::BasicVector(const VectorExpression<Node>& expression)
+    : elements_(expression.size())
+{
+    expr::evaluate(expression.node(), size(), data(), [](T& e, const T& v)
+                   { e = v; });
+}
+
+template <typename T>
+template <typename Node>
+BasicVector<T>& BasicVector<T>::operator=(const VectorExpression<Node>& expression)
+{
+    // an operand viewing other elements of this vector would be overwritten before it is read
+    if (expression.node().overlaps(data(), data() + size()))
+    {
+        return *this = BasicVector(expression);
+    }
+
+    elements_.resize(expression.size());
+    expr::evaluate(expression.node(), size(), data(), [](T& e, const T& v)
+                   { e = v; });
+    return *this;
+}
+
+template <typename T>
+template <typename Node>
+BasicVector<T>& BasicVector<T>::operator+=(const VectorExpression<Node>& expression)
+{
+    utility::check_empty(size());
+    utility::check_size(size(), expression.size());
+
+    if (expression.node().overlaps(data(), data() + size()))
+    {
+        return *this += BasicVector(expression);
+    }
+
+    expr::evaluate(expression.node(), size(), data(), [](T& e, const T& v)
+                   { e += v; });
+    return *this;
+}
+
+template <typename T>
+template <typename Node>
+BasicVector<T>& BasicVector<T>::operator-=(const VectorExpression<Node>& expression)
+{
+    utility::check_empty(size());
+    utility::check_size(size(), expression.size());
+
+    if (expression.node().overlaps(data(), data() + size()))
+    {
+        return *this -= BasicVector(expression);
+    }
+
+    expr::evaluate(expression.node(), size(), data(), [](T& e, const T& v)
+                   { e -= v; });
+    return *this;
+}
+
+template <typename A, typename B, enable_if_vector_operands<A, B>>
+typename A::value_type dot(const A& a, const B& b)
+{
+    using T = typename A::value_type;
+    return dot<T>(BasicVector<T>(a), BasicVector<T>(b));
+}
+
+template <typename T>
+VectorExpression<expr::Leaf<T>> lazy(const BasicVector<T>& vector)
+{
+    return VectorExpression<expr::Leaf<T>>(expr::node(vector), vector.size());
+}
+
+/*
+ * Build the expression of an element-wise binary operation after checking the operands. If an operand is a
+ * temporary vector the expression is evaluated into it and the vector is returned, so a chain of operations
+ * on temporaries allocates nothing. The assignment evaluates through a copy if another operand views its elements.
+ * Otherwise the expression is returned if an operand is an expression, and evaluated into a new vector if not.
+ */
+template <typename Op, typename A, typename B>
+auto make_vector_expression(A&& a, B&& b)
+{
+    utility::check_empty(a.size());
+    utility::check_size(a.size(), b.size());
+
+    using Node = expr::Binary<expr::node_t<std::decay_t<A>>, expr::node_t<std::decay_t<B>>, Op>;
+    const VectorExpression<Node> expression(Node(expr::node(a), expr::node(b)), a.size());
+    if constexpr (is_temporary_vector_v<A>)
+    {
+        a = expression;
+        return std::move(a);
+    }
+    else if constexpr (is_temporary_vector_v<B>)
+    {
+        b = expression;
+        return std::move(b);
+    }
+    else if constexpr (is_vector_expression_v<A> || is_vector_expression_v<B>)
+    {
+        return expression;
+    }
+    else
+    {
+        return BasicVector<typename std::decay_t<A>::value_type>(expression);
+    }
+}
+
+template <typename A, typename B, enable_if_vector_operands<A, B>>
+auto operator+(A&& a, B&& b)
+{
+    return make_vector_expression<expr::Add>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template <typename A, typename B, enable_if_vector_operands<A, B>>
+auto operator-(A&& a, B&& b)
+{
+    return make_vector_expression<expr::Sub>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template <typename A, typename B, enable_if_vector_operands<A, B>>
+auto operator*(A&& a, B&& b)
+{
+    return make_vector_expression<expr::Mul>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template <typename V, enable_if_vector_operands<V>>
+auto operator*(V&& v, const typename std::decay_t<V>::value_type& c)
+{
+    utility::check_empty(v.size());
+
+    if constexpr (is_temporary_vector_v<V>)
+    {
+        v *= c;
+        return std::move(v);
+    }
+    else
+    {
+        using Node = expr::Scale<expr::node_t<std::decay_t<V>>, typename std::decay_t<V>::value_type>;
+        const VectorExpression<Node> expression(Node(expr::node(v), c), v.size());
+        if constexpr (is_vector_expression_v<V>)
+        {
+            return expression;
+        }
+        else
+        {
+            return BasicVector<typename std::decay_t<V>::value_type>(expression);
+        }
+    }
+}
+
+template <typename V, enable_if_vector_operands<V>>
+auto operator*(const typename std::decay_t<V>::value_type& c, V&& v)
+{
+    return std::forward<V>(v) * c;
+}
+
+template <typename E, typename T>
+bool operator==(const VectorExpression<E>& a, const BasicVector<T>& b)
+{
+    return BasicVector<T>(a) == b;
+}
+
+template <typename E, typename T>
+bool operator!=(const VectorExpression<E>& a, const BasicVector<T>& b)
+{
+    return !(a == b);
+}
+
 } // namespace mla
 
 #endif // VECTOR_H
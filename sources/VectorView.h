@@ -0,0 +1,558 @@
+/**
+ * @file VectorView.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief Vector view class.
+ * @version 1.0
+ * @date 2026.10.16
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef VECTOR_VIEW_H
+#define VECTOR_VIEW_H
+
+#include <algorithm>   // std::copy std::equal
+#include <cmath>       // std::sqrt
+#include <complex>     // std::norm
+#include <string>      // std::string
+#include <type_traits> // std::enable_if_t std::is_const_v std::remove_const_t
+
+#include "Vector.h"
+#include "simd.h"
+#include "utility.hpp"
+
+namespace mla
+{
+
+/**
+ * @brief Non-owning view of a contiguous sequence of elements, such as a row of a matrix.
+ *
+ * Assignment through a view copies elements into the viewed storage, it never rebinds the view.
+ *
+ * @tparam T scalar type for a mutable view, such as `double`, or its const version for a read-only view
+ */
+template <typename T>
+class BasicVectorView
+{
+public:
+    // Scalar type of the elements, without const.
+    using value_type = std::remove_const_t<T>;
+
+private:
+    // Pointer to the first element.
+    T* data_;
+
+    // Number of elements.
+    int size_;
+
+public:
+    /*
+     * Constructor / Destructor
+     */
+
+    /**
+     * @brief Construct a view of size elements starting at data.
+     *
+     * @param data pointer to the first element
+     * @param size number of elements
+     */
+    BasicVectorView(T* data, int size);
+
+    /**
+     * @brief Construct a view of a whole vector.
+     *
+     * @param vector the viewed vector
+     */
+    BasicVectorView(BasicVector<value_type>& vector);
+
+    /**
+     * @brief Construct a read-only view of a whole vector.
+     *
+     * @param vector the viewed vector
+     */
+    template <typename U = T, std::enable_if_t<std::is_const_v<U>, int> = 0>
+    BasicVectorView(const BasicVector<value_type>& vector);
+
+    /**
+     * @brief Copy constructor, the new view refers to the same elements.
+     *
+     * @param that another view
+     */
+    BasicVectorView(const BasicVectorView& that) = default;
+
+    /**
+     * @brief Construct a read-only view from a mutable view.
+     *
+     * @param that a mutable view
+     */
+    template <typename U = T, std::enable_if_t<std::is_const_v<U>, int> = 0>
+    BasicVectorView(const BasicVectorView<value_type>& that);
+
+    /*
+     * Assignment
+     */
+
+    /**
+     * @brief Copy the elements of another view into the viewed elements.
+     *
+     * @param that another view of the same size
+     * @return self reference
+     */
+    BasicVectorView& operator=(const BasicVectorView& that);
+
+    /**
+     * @brief Copy the elements of a vector into the viewed elements.
+     *
+     * @param vector a vector of the same size
+     * @return self reference
+     */
+    BasicVectorView& operator=(const BasicVector<value_type>& vector);
+
+    /*
+     * Access
+     */
+
+    /**
+     * @brief Return the reference to the element at the specified position.
+     *
+     * The index is checked unless MLA_NO_BOUNDS_CHECK is defined for the whole project.
+     *
+     * @param index index of the element to return
+     * @return reference to the element at the specified position
+     */
+    T& operator[](int index) const;
+
+    /**
+     * @brief Return the reference to the element at the specified position, the index is always checked.
+     *
+     * @param index index of the element to return
+     * @return reference to the element at the specified position
+     */
+    T& at(int index) const;
+
+    /**
+     * @brief Return the pointer to the first element.
+     *
+     * @return pointer to the first element
+     */
+    T* data() const;
+
+    /*
+     * Iterator
+     */
+
+    /**
+     * @brief Return an iterator to the first element of the view.
+     *
+     * @return iterator to the first element
+     */
+    T* begin() const;
+
+    /**
+     * @brief Return an iterator to the element following the last element of the view.
+     *
+     * @return iterator to the element following the last element
+     */
+    T* end() const;
+
+    /*
+     * Examination (will not change the object itself)
+     */
+
+    /**
+     * @brief Return the number of elements in the view.
+     *
+     * @return the number of elements in the view
+     */
+    int size() const;
+
+    /**
+     * @brief Return true if the view contains no elements.
+     *
+     * @return true if the view contains no elements
+     */
+    bool is_empty() const;
+
+    /**
+     * @brief Return a string representing the viewed elements.
+     *
+     * @return a string representing the viewed elements
+     */
+    std::string to_string() const;
+
+    /**
+     * @brief Return the length of the viewed elements as a vector.
+     *
+     * @return the length of the viewed elements as a vector
+     */
+    utility::real_t<value_type> length() const;
+
+    /**
+     * @brief Return the number of leading zeros of the viewed elements.
+     *
+     * @return the number of leading zeros of the viewed elements
+     */
+    int count_leading_zeros() const;
+
+    /**
+     * @brief Return true if all the viewed elements are zero.
+     *
+     * @return true if all the viewed elements are zero
+     */
+    bool is_zero() const;
+
+    /*
+     * Manipulation (will change the viewed elements)
+     */
+
+    /**
+     * @brief Unitize the viewed elements as a vector.
+     *
+     * @return self reference
+     */
+    const BasicVectorView& unitize() const;
+
+    /**
+     * @brief Addition.
+     *
+     * @param that a vector or view of the same size, not overlapping this view
+     * @return self reference
+     */
+    const BasicVectorView& operator+=(const BasicVectorView<const value_type>& that) const;
+
+    /**
+     * @brief Difference.
+     *
+     * @param that a vector or view of the same size, not overlapping this view
+     * @return self reference
+     */
+    const BasicVectorView& operator-=(const BasicVectorView<const value_type>& that) const;
+
+    /**
+     * @brief Hadamard product (entrywise product).
+     *
+     * @param that a vector or view of the same size, not overlapping this view
+     * @return self reference
+     */
+    const BasicVectorView& operator*=(const BasicVectorView<const value_type>& that) const;
+
+    /**
+     * @brief Scalar multiplication.
+     *
+     * @param c a number
+     * @return self reference
+     */
+    const BasicVectorView& operator*=(const value_type& c) const;
+
+    /*
+     * Production (will produce new object)
+     */
+
+    /**
+     * @brief Copy the viewed elements into a new vector.
+     *
+     * @return a vector with the viewed elements
+     */
+    operator BasicVector<value_type>() const;
+};
+
+// Mutable view.
+using VectorView = BasicVectorView<double>;
+
+// Read-only view.
+using ConstVectorView = BasicVectorView<const double>;
+
+// Whether T is a view of a vector.
+template <typename T>
+struct is_vector_view : std::false_type
+{
+};
+
+template <typename T>
+struct is_vector_view<BasicVectorView<T>> : std::true_type
+{
+};
+
+// Scalar type of a vector or a view, void for other types.
+template <typename T>
+struct vector_scalar
+{
+    using type = void;
+};
+
+template <typename T>
+struct vector_scalar<BasicVector<T>>
+{
+    using type = T;
+};
+
+template <typename T>
+struct vector_scalar<BasicVectorView<T>>
+{
+    using type = std::remove_const_t<T>;
+};
+
+template <typename T>
+using vector_scalar_t = typename vector_scalar<T>::type;
+
+// A view and a vector or another view of the same scalar type, both converted to read-only views.
+template <typename A, typename B>
+using enable_if_vector_view_operands = std::enable_if_t<(is_vector_view<A>::value || is_vector_view<B>::value) && std::is_same_v<vector_scalar_t<A>, vector_scalar_t<B>>, int>;
+
+/**
+ * @brief Check whether two vectors or views have the same elements, at least one of them a view.
+ *
+ * @param a a vector or view
+ * @param b another vector or view
+ * @return true if they are equal
+ */
+template <typename A, typename B, enable_if_vector_view_operands<A, B> = 0>
+bool operator==(const A& a, const B& b);
+
+/**
+ * @brief Check whether two vectors or views differ in size or elements, at least one of them a view.
+ *
+ * @param a a vector or view
+ * @param b another vector or view
+ * @return true if they are not equal
+ */
+template <typename A, typename B, enable_if_vector_view_operands<A, B> = 0>
+bool operator!=(const A& a, const B& b);
+
+/**
+ * @brief Return an expression of a view, so the operations applied to it are fused into one pass, see lazy(vector).
+ *
+ * The expression refers to the viewed elements, which must outlive it (do not store it with `auto`).
+ *
+ * @param view a view
+ * @return an expression of the view
+ */
+template <typename T>
+VectorExpression<expr::Leaf<std::remove_const_t<T>>> lazy(const BasicVectorView<T>& view);
+
+template <typename T>
+BasicVectorView<T>::BasicVectorView(T* data, int size)
+    : data_(data)
+    , size_(size)
+{
+}
+
+template <typename T>
+BasicVectorView<T>::BasicVectorView(BasicVector<value_type>& vector)
+    : data_(vector.data())
+    , size_(vector.size())
+{
+}
+
+template <typename T>
+template <typename U, std::enable_if_t<std::is_const_v<U>, int>>
+BasicVectorView<T>::BasicVectorView(const BasicVector<value_type>& vector)
+    : data_(vector.data())
+    , size_(vector.size())
+{
+}
+
+template <typename T>
+template <typename U, std::enable_if_t<std::is_const_v<U>, int>>
+BasicVectorView<T>::BasicVectorView(const BasicVectorView<value_type>& that)
+    : data_(that.data())
+    , size_(that.size())
+{
+}
+
+template <typename T>
+BasicVectorView<T>& BasicVectorView<T>::operator=(const BasicVectorView& that)
+{
+    utility::check_size(size_, that.size_);
+
+    if (data_ != that.data_)
+    {
+        std::copy(that.data_, that.data_ + size_, data_);
+    }
+
+    return *this;
+}
+
+template <typename T>
+BasicVectorView<T>& BasicVectorView<T>::operator=(const BasicVector<value_type>& vector)
+{
+    utility::check_size(size_, vector.size());
+
+    std::copy(vector.begin(), vector.end(), data_);
+    return *this;
+}
+
+template <typename T>
+T& BasicVectorView<T>::operator[](int index) const
+{
+    utility::check_index(index, size_);
+
+    return data_[index];
+}
+
+template <typename T>
+T& BasicVectorView<T>::at(int index) const
+{
+    utility::check_bounds(index, 0, size_);
+
+    return data_[index];
+}
+
+template <typename T>
+T* BasicVectorView<T>::data() const
+{
+    return data_;
+}
+
+template <typename T>
+T* BasicVectorView<T>::begin() const
+{
+    return data_;
+}
+
+template <typename T>
+T* BasicVectorView<T>::end() const
+{
+    return data_ + size_;
+}
+
+template <typename T>
+int BasicVectorView<T>::size() const
+{
+    return size_;
+}
+
+template <typename T>
+bool BasicVectorView<T>::is_empty() const
+{
+    return size_ == 0;
+}
+
+template <typename T>
+std::string BasicVectorView<T>::to_string() const
+{
+    return BasicVector<value_type>(*this).to_string();
+}
+
+template <typename T>
+utility::real_t<std::remove_const_t<T>> BasicVectorView<T>::length() const
+{
+    utility::check_empty(size_);
+
+    if constexpr (utility::is_complex_v<value_type>)
+    {
+        utility::real_t<value_type> sum = 0;
+        for (int i = 0; i < size_; i++)
+        {
+            sum += std::norm(data_[i]);
+        }
+        return std::sqrt(sum);
+    }
+    else
+    {
+        return std::sqrt(kernel::dot(size_, data_, data_));
+    }
+}
+
+template <typename T>
+int BasicVectorView<T>::count_leading_zeros() const
+{
+    utility::check_empty(size_);
+
+    int lz = 0;
+    while (lz < size_ && data_[lz] == value_type(0))
+    {
+        lz++;
+    }
+    return lz;
+}
+
+template <typename T>
+bool BasicVectorView<T>::is_zero() const
+{
+    return count_leading_zeros() == size_;
+}
+
+template <typename T>
+const BasicVectorView<T>& BasicVectorView<T>::unitize() const
+{
+    utility::check_empty(size_);
+
+    if (is_zero())
+    {
+        throw std::runtime_error("Error: The zero vector can not be unitized.");
+    }
+
+    return *this *= value_type(1) / length();
+}
+
+template <typename T>
+const BasicVectorView<T>& BasicVectorView<T>::operator+=(const BasicVectorView<const value_type>& that) const
+{
+    utility::check_empty(size_);
+    utility::check_size(size_, that.size());
+
+    kernel::add(size_, that.data(), data_);
+    return *this;
+}
+
+template <typename T>
+const BasicVectorView<T>& BasicVectorView<T>::operator-=(const BasicVectorView<const value_type>& that) const
+{
+    utility::check_empty(size_);
+    utility::check_size(size_, that.size());
+
+    kernel::sub(size_, that.data(), data_);
+    return *this;
+}
+
+template <typename T>
+const BasicVectorView<T>& BasicVectorView<T>::operator*=(const BasicVectorView<const value_type>& that) const
+{
+    utility::check_empty(size_);
+    utility::check_size(size_, that.size());
+
+    kernel::mul(size_, that.data(), data_);
+    return *this;
+}
+
+template <typename T>
+const BasicVectorView<T>& BasicVectorView<T>::operator*=(const value_type& c) const
+{
+    utility::check_empty(size_);
+
+    kernel::scale(size_, c, data_);
+    return *this;
+}
+
+template <typename T>
+BasicVectorView<T>::operator BasicVector<value_type>() const
+{
+    BasicVector<value_type> vector(size_, 0);
+    std::copy(data_, data_ + size_, vector.begin());
+    return vector;
+}
+
+template <typename A, typename B, enable_if_vector_view_operands<A, B>>
+bool operator==(const A& a, const B& b)
+{
+    using T = vector_scalar_t<A>;
+    const BasicVectorView<const T> x(a), y(b);
+    return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+}
+
+template <typename A, typename B, enable_if_vector_view_operands<A, B>>
+bool operator!=(const A& a, const B& b)
+{
+    return !(a == b);
+}
+
+template <typename T>
+VectorExpression<expr::Leaf<std::remove_const_t<T>>> lazy(const BasicVectorView<T>& view)
+{
+    return VectorExpression<expr::Leaf<std::remove_const_t<T>>>(expr::node(view), view.size());
+}
+
+} // namespace mla
+
+#endif // VECTOR_VIEW_H
@@ -0,0 +1,539 @@
+#include "gemm.h"
+#include "parallel.h"
+#include "simd.h"
+
+#include <algorithm> // std::min
+#include <atomic>    // std::atomic
+#include <cstddef>   // std::ptrdiff_t
+#include <vector>    // std::vector
+
+#if MLA_X86
+#include <immintrin.h>
+#endif
+
+namespace mla::kernel
+{
+
+// Cache blocks: a KC x NR sliver of B stays in L1, an MC x KC block of A stays in L2,
+// and a KC x NC panel of B stays in L3. MC and NC are multiples of every MR and NR below.
+static constexpr int MC = 96;
+static constexpr int KC = 256;
+static constexpr int NC = 4096;
+
+// Below this many multiply-adds the packing costs more than it saves.
+static constexpr long long SMALL = 32 * 32 * 32;
+
+// Pack an mc x kc block of A into panels of MR rows, each panel stored column by column.
+template <typename T>
+static void pack_a(int MR, int mc, int kc, const T* a, int lda, T* packed)
+{
+    for (int i = 0; i < mc; i += MR)
+    {
+        const int mr = std::min(MR, mc - i);
+        const T* panel = a + std::ptrdiff_t(i) * lda;
+        for (int p = 0; p < kc; p++)
+        {
+            for (int ii = 0; ii < mr; ii++)
+            {
+                *packed++ = panel[std::ptrdiff_t(ii) * lda + p];
+            }
+            for (int ii = mr; ii < MR; ii++)
+            {
+                *packed++ = 0;
+            }
+        }
+    }
+}
+
+// Pack a kc x nc block of B into panels of NR columns, each panel stored row by row.
+template <typename T>
+static void pack_b(int NR, int kc, int nc, const T* b, int ldb, T* packed)
+{
+    for (int j = 0; j < nc; j += NR)
+    {
+        const int nr = std::min(NR, nc - j);
+        for (int p = 0; p < kc; p++)
+        {
+            const T* row = b + std::ptrdiff_t(p) * ldb + j;
+            for (int jj = 0; jj < nr; jj++)
+            {
+                *packed++ = row[jj];
+            }
+            for (int jj = nr; jj < NR; jj++)
+            {
+                *packed++ = 0;
+            }
+        }
+    }
+}
+
+// Add the first mr x nr elements of an MR x NR tile to C.
+template <typename T>
+static void add_tile(int NR, const T* ab, T* c, int ldc, int mr, int nr)
+{
+    for (int i = 0; i < mr; i++)
+    {
+        T* row = c + std::ptrdiff_t(i) * ldc;
+        for (int j = 0; j < nr; j++)
+        {
+            row[j] += ab[i * NR + j];
+        }
+    }
+}
+
+// C[0:mr, 0:nr] += A panel * B panel, accumulating the whole 4 x 8 tile in registers.
+template <typename T>
+static void micro_kernel_scalar(int kc, const T* a, const T* b, T* c, int ldc, int mr, int nr)
+{
+    constexpr int MR = 4, NR = 8;
+
+    T ab[MR * NR] = {};
+    for (int p = 0; p < kc; p++)
+    {
+        for (int i = 0; i < MR; i++)
+        {
+            for (int j = 0; j < NR; j++)
+            {
+                ab[i * NR + j] += a[i] * b[j];
+            }
+        }
+        a += MR;
+        b += NR;
+    }
+    add_tile(NR, ab, c, ldc, mr, nr);
+}
+
+#if MLA_X86
+
+// 6 x 8 tile in twelve 256-bit accumulators.
+MLA_TARGET("avx2,fma")
+static void micro_kernel_avx2(int kc, const double* a, const double* b, double* c, int ldc, int mr, int nr)
+{
+    constexpr int MR = 6, NR = 8;
+
+    __m256d acc[MR][2];
+    for (int i = 0; i < MR; i++)
+    {
+        acc[i][0] = _mm256_setzero_pd();
+        acc[i][1] = _mm256_setzero_pd();
+    }
+    for (int p = 0; p < kc; p++)
+    {
+        const __m256d b0 = _mm256_loadu_pd(b);
+        const __m256d b1 = _mm256_loadu_pd(b + 4);
+        for (int i = 0; i < MR; i++)
+        {
+            const __m256d ai = _mm256_broadcast_sd(a + i);
+            acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+            acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+        }
+        a += MR;
+        b += NR;
+    }
+
+    if (mr == MR && nr == NR)
+    {
+        for (int i = 0; i < MR; i++)
+        {
+            double* row = c + std::ptrdiff_t(i) * ldc;
+            _mm256_storeu_pd(row, _mm256_add_pd(_mm256_loadu_pd(row), acc[i][0]));
+            _mm256_storeu_pd(row + 4, _mm256_add_pd(_mm256_loadu_pd(row + 4), acc[i][1]));
+        }
+    }
+    else
+    {
+        alignas(32) double ab[MR * NR];
+        for (int i = 0; i < MR; i++)
+        {
+            _mm256_store_pd(ab + i * NR, acc[i][0]);
+            _mm256_store_pd(ab + i * NR + 4, acc[i][1]);
+        }
+        add_tile(NR, ab, c, ldc, mr, nr);
+    }
+}
+
+// 8 x 16 tile in sixteen 512-bit accumulators.
+MLA_TARGET("avx512f")
+static void micro_kernel_avx512(int kc, const double* a, const double* b, double* c, int ldc, int mr, int nr)
+{
+    constexpr int MR = 8, NR = 16;
+
+    __m512d acc[MR][2];
+    for (int i = 0; i < MR; i++)
+    {
+        acc[i][0] = _mm512_setzero_pd();
+        acc[i][1] = _mm512_setzero_pd();
+    }
+    for (int p = 0; p < kc; p++)
+    {
+        const __m512d b0 = _mm512_loadu_pd(b);
+        const __m512d b1 = _mm512_loadu_pd(b + 8);
+        for (int i = 0; i < MR; i++)
+        {
+            const __m512d ai = _mm512_set1_pd(a[i]);
+            acc[i][0] = _mm512_fmadd_pd(ai, b0, acc[i][0]);
+            acc[i][1] = _mm512_fmadd_pd(ai, b1, acc[i][1]);
+        }
+        a += MR;
+        b += NR;
+    }
+
+    if (mr == MR && nr == NR)
+    {
+        for (int i = 0; i < MR; i++)
+        {
+            double* row = c + std::ptrdiff_t(i) * ldc;
+            _mm512_storeu_pd(row, _mm512_add_pd(_mm512_loadu_pd(row), acc[i][0]));
+            _mm512_storeu_pd(row + 8, _mm512_add_pd(_mm512_loadu_pd(row + 8), acc[i][1]));
+        }
+    }
+    else
+    {
+        alignas(64) double ab[MR * NR];
+        for (int i = 0; i < MR; i++)
+        {
+            _mm512_store_pd(ab + i * NR, acc[i][0]);
+            _mm512_store_pd(ab + i * NR + 8, acc[i][1]);
+        }
+        add_tile(NR, ab, c, ldc, mr, nr);
+    }
+}
+
+// 6 x 16 float tile in twelve 256-bit accumulators.
+MLA_TARGET("avx2,fma")
+static void micro_kernel_avx2(int kc, const float* a, const float* b, float* c, int ldc, int mr, int nr)
+{
+    constexpr int MR = 6, NR = 16;
+
+    __m256 acc[MR][2];
+    for (int i = 0; i < MR; i++)
+    {
+        acc[i][0] = _mm256_setzero_ps();
+        acc[i][1] = _mm256_setzero_ps();
+    }
+    for (int p = 0; p < kc; p++)
+    {
+        const __m256 b0 = _mm256_loadu_ps(b);
+        const __m256 b1 = _mm256_loadu_ps(b + 8);
+        for (int i = 0; i < MR; i++)
+        {
+            const __m256 ai = _mm256_broadcast_ss(a + i);
+            acc[i][0] = _mm256_fmadd_ps(ai, b0, acc[i][0]);
+            acc[i][1] = _mm256_fmadd_ps(ai, b1, acc[i][1]);
+        }
+        a += MR;
+        b += NR;
+    }
+
+    if (mr == MR && nr == NR)
+    {
+        for (int i = 0; i < MR; i++)
+        {
+            float* row = c + std::ptrdiff_t(i) * ldc;
+            _mm256_storeu_ps(row, _mm256_add_ps(_mm256_loadu_ps(row), acc[i][0]));
+            _mm256_storeu_ps(row + 8, _mm256_add_ps(_mm256_loadu_ps(row + 8), acc[i][1]));
+        }
+    }
+    else
+    {
+        alignas(32) float ab[MR * NR];
+        for (int i = 0; i < MR; i++)
+        {
+            _mm256_store_ps(ab + i * NR, acc[i][0]);
+            _mm256_store_ps(ab + i * NR + 8, acc[i][1]);
+        }
+        add_tile(NR, ab, c, ldc, mr, nr);
+    }
+}
+
+// 8 x 32 float tile in sixteen 512-bit accumulators.
+MLA_TARGET("avx512f")
+static void micro_kernel_avx512(int kc, const float* a, const float* b, float* c, int ldc, int mr, int nr)
+{
+    constexpr int MR = 8, NR = 32;
+
+    __m512 acc[MR][2];
+    for (int i = 0; i < MR; i++)
+    {
+        acc[i][0] = _mm512_setzero_ps();
+        acc[i][1] = _mm512_setzero_ps();
+    }
+    for (int p = 0; p < kc; p++)
+    {
+        const __m512 b0 = _mm512_loadu_ps(b);
+        const __m512 b1 = _mm512_loadu_ps(b + 16);
+        for (int i = 0; i < MR; i++)
+        {
+            const __m512 ai = _mm512_set1_ps(a[i]);
+            acc[i][0] = _mm512_fmadd_ps(ai, b0, acc[i][0]);
+            acc[i][1] = _mm512_fmadd_ps(ai, b1, acc[i][1]);
+        }
+        a += MR;
+        b += NR;
+    }
+
+    if (mr == MR && nr == NR)
+    {
+        for (int i = 0; i < MR; i++)
+        {
+            float* row = c + std::ptrdiff_t(i) * ldc;
+            _mm512_storeu_ps(row, _mm512_add_ps(_mm512_loadu_ps(row), acc[i][0]));
+            _mm512_storeu_ps(row + 16, _mm512_add_ps(_mm512_loadu_ps(row + 16), acc[i][1]));
+        }
+    }
+    else
+    {
+        alignas(64) float ab[MR * NR];
+        for (int i = 0; i < MR; i++)
+        {
+            _mm512_store_ps(ab + i * NR, acc[i][0]);
+            _mm512_store_ps(ab + i * NR + 16, acc[i][1]);
+        }
+        add_tile(NR, ab, c, ldc, mr, nr);
+    }
+}
+
+#endif // MLA_X86
+
+// Register tile shape and micro-kernel for one instruction set.
+template <typename T>
+struct MicroKernel
+{
+    int mr;
+    int nr;
+    void (*run)(int kc, const T* a, const T* b, T* c, int ldc, int mr, int nr);
+};
+
+// The tiles hold twice as many float columns, as a register holds twice as many floats.
+template <typename T>
+static MicroKernel<T> micro_kernel()
+{
+    constexpr int WIDTH = sizeof(double) / sizeof(T);
+    switch (isa())
+    {
+#if MLA_X86
+        case Isa::AVX512:
+            return {8, 16 * WIDTH, micro_kernel_avx512};
+        case Isa::AVX2:
+            return {6, 8 * WIDTH, micro_kernel_avx2};
+#endif
+        default:
+            return {4, 8, micro_kernel_scalar<T>};
+    }
+}
+
+// Straightforward loop for products too small to amortize the packing.
+template <typename T>
+static void gemm_small(int m, int n, int k, const T* a, int lda, const T* b, int ldb, T* c, int ldc)
+{
+    for (int i = 0; i < m; i++)
+    {
+        T* c_row = c + std::ptrdiff_t(i) * ldc;
+        for (int p = 0; p < k; p++)
+        {
+            const T a_ip = a[std::ptrdiff_t(i) * lda + p];
+            const T* b_row = b + std::ptrdiff_t(p) * ldb;
+            for (int j = 0; j < n; j++)
+            {
+                c_row[j] += a_ip * b_row[j];
+            }
+        }
+    }
+}
+
+// Packed, cache-blocked product.
+template <typename T>
+static void gemm_blocked(int m, int n, int k, const T* a, int lda, const T* b, int ldb, T* c, int ldc)
+{
+    if ((long long)m * n * k < SMALL)
+    {
+        gemm_small(m, n, k, a, lda, b, ldb, c, ldc);
+        return;
+    }
+
+    const MicroKernel<T> kernel = micro_kernel<T>();
+    const int MR = kernel.mr, NR = kernel.nr;
+
+    std::vector<T> packed_b(std::size_t(KC) * ((std::min(n, NC) + NR - 1) / NR * NR));
+
+    for (int jc = 0; jc < n; jc += NC)
+    {
+        const int nc = std::min(NC, n - jc);
+        for (int pc = 0; pc < k; pc += KC)
+        {
+            const int kc = std::min(KC, k - pc);
+            pack_b(NR, kc, nc, b + std::ptrdiff_t(pc) * ldb + jc, ldb, packed_b.data());
+
+            // the row blocks of C are independent, each thread packs its own blocks of A
+            parallel_for(0, (m + MC - 1) / MC, 1, [&](int first, int last)
+                         {
+                std::vector<T> packed_a(std::size_t(MC) * KC);
+                for (int ic = first * MC; ic < std::min(last * MC, m); ic += MC)
+                {
+                    const int mc = std::min(MC, m - ic);
+                    pack_a(MR, mc, kc, a + std::ptrdiff_t(ic) * lda + pc, lda, packed_a.data());
+                    for (int jr = 0; jr < nc; jr += NR)
+                    {
+                        for (int ir = 0; ir < mc; ir += MR)
+                        {
+                            kernel.run(kc,
+                                       packed_a.data() + std::ptrdiff_t(ir) * kc,
+                                       packed_b.data() + std::ptrdiff_t(jr) * kc,
+                                       c + std::ptrdiff_t(ic + ir) * ldc + jc + jr,
+                                       ldc,
+                                       std::min(MR, mc - ir),
+                                       std::min(NR, nc - jr));
+                        }
+                    }
+                } });
+        }
+    }
+}
+
+// z = x + sign * y for m x n blocks, split across threads by rows.
+static void add_block(int m, int n, const double* x, int ldx, const double* y, int ldy, double sign, double* z, int ldz)
+{
+    parallel_for(0, m, std::max(1, PARALLEL_GRAIN / std::max(n, 1)), [=](int begin, int end)
+                 {
+        for (int i = begin; i < end; i++)
+        {
+            const double* x_row = x + std::ptrdiff_t(i) * ldx;
+            const double* y_row = y + std::ptrdiff_t(i) * ldy;
+            double* z_row = z + std::ptrdiff_t(i) * ldz;
+            for (int j = 0; j < n; j++)
+            {
+                z_row[j] = x_row[j] + sign * y_row[j];
+            }
+        } });
+}
+
+// z += x for m x n blocks.
+static void accumulate_block(int m, int n, const double* x, int ldx, double* z, int ldz)
+{
+    add_block(m, n, z, ldz, x, ldx, 1, z, ldz);
+}
+
+// Matrices of every dimension at least this large use the Strassen-Winograd recursion, 0 disables it.
+static std::atomic<int> strassen_crossover{2048};
+
+// C += A * B with the Winograd variant of Strassen's algorithm: 7 half-size products and 15 block
+// additions per level instead of 8 products. Odd trailing rows and columns are fixed up with the
+// classical kernel, and the recursion stops below the crossover.
+static void strassen(int m, int n, int k, const double* a, int lda, const double* b, int ldb, double* c, int ldc, int crossover)
+{
+    if (crossover <= 0 || std::min({m, n, k}) < crossover)
+    {
+        gemm_blocked(m, n, k, a, lda, b, ldb, c, ldc);
+        return;
+    }
+
+    const int m2 = m / 2, n2 = n / 2, k2 = k / 2;
+
+    const double* a11 = a;
+    const double* a12 = a + k2;
+    const double* a21 = a + std::ptrdiff_t(m2) * lda;
+    const double* a22 = a21 + k2;
+    const double* b11 = b;
+    const double* b12 = b + n2;
+    const double* b21 = b + std::ptrdiff_t(k2) * ldb;
+    const double* b22 = b21 + n2;
+    double* c11 = c;
+    double* c12 = c + n2;
+    double* c21 = c + std::ptrdiff_t(m2) * ldc;
+    double* c22 = c21 + n2;
+
+    // x and y hold the operand combinations, p and q the products that are added to several blocks
+    std::vector<double> x(std::size_t(m2) * k2), y(std::size_t(k2) * n2), p(std::size_t(m2) * n2), q(std::size_t(m2) * n2);
+
+    // c11 += a11 b11 + a12 b21
+    strassen(m2, n2, k2, a11, lda, b11, ldb, p.data(), n2, crossover);
+    accumulate_block(m2, n2, p.data(), n2, c11, ldc);
+    strassen(m2, n2, k2, a12, lda, b21, ldb, c11, ldc, crossover);
+
+    // p = a11 b11 + (a21 + a22 - a11)(b11 - b12 + b22), added to c12, c21 and c22
+    add_block(m2, k2, a21, lda, a22, lda, 1, x.data(), k2);
+    add_block(m2, k2, x.data(), k2, a11, lda, -1, x.data(), k2);
+    add_block(k2, n2, b22, ldb, b12, ldb, -1, y.data(), n2);
+    add_block(k2, n2, y.data(), n2, b11, ldb, 1, y.data(), n2);
+    strassen(m2, n2, k2, x.data(), k2, y.data(), n2, p.data(), n2, crossover);
+    accumulate_block(m2, n2, p.data(), n2, c12, ldc);
+    accumulate_block(m2, n2, p.data(), n2, c21, ldc);
+    accumulate_block(m2, n2, p.data(), n2, c22, ldc);
+
+    // c21 += a22 (b21 - b11 + b12 - b22), from y above
+    add_block(k2, n2, b21, ldb, y.data(), n2, -1, y.data(), n2);
+    strassen(m2, n2, k2, a22, lda, y.data(), n2, c21, ldc, crossover);
+
+    // c12 += (a12 - a21 - a22 + a11) b22, from x above
+    add_block(m2, k2, a12, lda, x.data(), k2, -1, x.data(), k2);
+    strassen(m2, n2, k2, x.data(), k2, b22, ldb, c12, ldc, crossover);
+
+    // q = (a21 + a22)(b12 - b11), added to c12 and c22
+    add_block(m2, k2, a21, lda, a22, lda, 1, x.data(), k2);
+    add_block(k2, n2, b12, ldb, b11, ldb, -1, y.data(), n2);
+    std::fill(q.begin(), q.end(), 0.0);
+    strassen(m2, n2, k2, x.data(), k2, y.data(), n2, q.data(), n2, crossover);
+    accumulate_block(m2, n2, q.data(), n2, c12, ldc);
+    accumulate_block(m2, n2, q.data(), n2, c22, ldc);
+
+    // q = (a11 - a21)(b22 - b12), added to c21 and c22
+    add_block(m2, k2, a11, lda, a21, lda, -1, x.data(), k2);
+    add_block(k2, n2, b22, ldb, b12, ldb, -1, y.data(), n2);
+    std::fill(q.begin(), q.end(), 0.0);
+    strassen(m2, n2, k2, x.data(), k2, y.data(), n2, q.data(), n2, crossover);
+    accumulate_block(m2, n2, q.data(), n2, c21, ldc);
+    accumulate_block(m2, n2, q.data(), n2, c22, ldc);
+
+    // odd k: the last column of A times the last row of B
+    if (k % 2 != 0)
+    {
+        gemm_blocked(2 * m2, 2 * n2, 1, a + 2 * k2, lda, b + std::ptrdiff_t(2 * k2) * ldb, ldb, c, ldc);
+    }
+    // odd n: the last column of C
+    if (n % 2 != 0)
+    {
+        gemm_blocked(2 * m2, 1, k, a, lda, b + 2 * n2, ldb, c + 2 * n2, ldc);
+    }
+    // odd m: the last row of C
+    if (m % 2 != 0)
+    {
+        gemm_blocked(1, n, k, a + std::ptrdiff_t(2 * m2) * lda, lda, b, ldb, c + std::ptrdiff_t(2 * m2) * ldc, ldc);
+    }
+}
+
+void gemm(int m, int n, int k, const double* a, int lda, const double* b, int ldb, double* c, int ldc)
+{
+    if (m == 0 || n == 0 || k == 0)
+    {
+        return;
+    }
+
+    strassen(m, n, k, a, lda, b, ldb, c, ldc, strassen_crossover.load(std::memory_order_relaxed));
+}
+
+void gemm(int m, int n, int k, const float* a, int lda, const float* b, int ldb, float* c, int ldc)
+{
+    if (m == 0 || n == 0 || k == 0)
+    {
+        return;
+    }
+
+    gemm_blocked(m, n, k, a, lda, b, ldb, c, ldc);
+}
+
+} // namespace mla::kernel
+
+namespace mla
+{
+
+void set_strassen_crossover(int n)
+{
+    kernel::strassen_crossover.store(n, std::memory_order_relaxed);
+}
+
+int strassen_crossover()
+{
+    return kernel::strassen_crossover.load(std::memory_order_relaxed);
+}
+
+} // namespace mla
@@ -0,0 +1,107 @@
+/**
+ * @file gemm.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief General matrix multiplication kernel.
+ * @version 1.0
+ * @date 2026.10.16
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef GEMM_H
+#define GEMM_H
+
+#include <algorithm> // std::max std::min
+#include <cstddef>   // std::ptrdiff_t
+
+#include "parallel.h"
+
+namespace mla
+{
+
+/**
+ * @brief Set the crossover of the Strassen-Winograd recursion used by large matrix products.
+ *
+ * Products whose dimensions are all at least n are split recursively into 7 half-size products,
+ * smaller ones use the classical kernel. The recursion trades a few bits of accuracy for fewer
+ * multiplications. Not meant to be called while an operation is running on other threads.
+ *
+ * @param n the crossover, 0 to always use the classical kernel (2048 by default)
+ */
+void set_strassen_crossover(int n);
+
+/**
+ * @brief Return the crossover of the Strassen-Winograd recursion.
+ *
+ * @return the crossover of the Strassen-Winograd recursion, 0 if disabled
+ */
+int strassen_crossover();
+
+} // namespace mla
+
+namespace mla::kernel
+{
+
+/**
+ * @brief Compute C += A * B for row-major operands.
+ *
+ * Uses the Strassen-Winograd recursion above strassen_crossover(). A is m x k with leading dimension lda, B is k x n with leading dimension ldb,
+ * C is m x n with leading dimension ldc. C must not alias A or B.
+ *
+ * @param m number of rows of A and C
+ * @param n number of columns of B and C
+ * @param k number of columns of A and rows of B
+ * @param a pointer to the first element of A
+ * @param lda distance between the starts of two adjacent rows of A
+ * @param b pointer to the first element of B
+ * @param ldb distance between the starts of two adjacent rows of B
+ * @param c pointer to the first element of C
+ * @param ldc distance between the starts of two adjacent rows of C
+ */
+void gemm(int m, int n, int k, const double* a, int lda, const double* b, int ldb, double* c, int ldc);
+
+/**
+ * @brief Compute C += A * B for row-major float operands, with the packed kernel on float tiles.
+ *
+ * The Strassen-Winograd recursion is not used, float has too few bits to spare.
+ */
+void gemm(int m, int n, int k, const float* a, int lda, const float* b, int ldb, float* c, int ldc);
+
+/**
+ * @brief Compute C += A * B for row-major operands of another scalar type, such as std::complex<double>.
+ *
+ * Rows of C are split across threads. Each row is updated by a multiple of a row of B at a time,
+ * in blocks of B that stay in cache, so the inner loop is contiguous and vectorizes.
+ */
+template <typename T>
+void gemm(int m, int n, int k, const T* a, int lda, const T* b, int ldb, T* c, int ldc)
+{
+    constexpr int KB = 256, NB = 1024;
+    const int grain = std::max(1, PARALLEL_GRAIN / std::max(1, n * std::min(k, KB)));
+    parallel_for(0, m, grain, [=](int begin, int end)
+                 {
+        for (int p0 = 0; p0 < k; p0 += KB)
+        {
+            for (int j0 = 0; j0 < n; j0 += NB)
+            {
+                const int pb = std::min(KB, k - p0), nb = std::min(NB, n - j0);
+                for (int i = begin; i < end; i++)
+                {
+                    T* row = c + std::ptrdiff_t(i) * ldc + j0;
+                    for (int p = p0; p < p0 + pb; p++)
+                    {
+                        const T e = a[std::ptrdiff_t(i) * lda + p];
+                        const T* other = b + std::ptrdiff_t(p) * ldb + j0;
+                        for (int j = 0; j < nb; j++)
+                        {
+                            row[j] += e * other[j];
+                        }
+                    }
+                }
+            }
+        } });
+}
+
+} // namespace mla::kernel
+
+#endif // GEMM_H
@@ -13,8 +13,23 @@
 
 #if ((defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L)
 
+#include "Allocator.h"
+#include "Cholesky.h"
+#include "Expression.h"
+#include "LU.h"
+#include "Mat.h"
 #include "Matrix.h"
+#include "MatrixBatch.h"
+#include "MatrixFile.h"
+#include "MatrixText.h"
+#include "MatrixView.h"
+#include "QR.h"
+#include "SparseMatrix.h"
+#include "Vec.h"
 #include "Vector.h"
+#include "VectorView.h"
+#include "gemm.h"
+#include "parallel.h"
 
 #else
 #error "Require at least C++17."
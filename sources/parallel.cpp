@@ -0,0 +1,216 @@
+#include "parallel.h"
+
+#include <algorithm>          // std::min std::max
+#include <condition_variable> // std::condition_variable
+#include <deque>              // std::deque
+#include <exception>          // std::exception_ptr
+#include <memory>             // std::unique_ptr
+#include <mutex>              // std::mutex
+#include <thread>             // std::thread
+#include <vector>             // std::vector
+
+namespace mla
+{
+
+/**
+ * @brief Fixed set of worker threads taking jobs from a shared queue.
+ */
+class ThreadPool
+{
+private:
+    // Worker threads.
+    std::vector<std::thread> workers_;
+
+    // Pending jobs.
+    std::deque<std::function<void()>> jobs_;
+
+    // Protects jobs_ and stop_.
+    std::mutex mutex_;
+
+    // Signals a new job or the stop request.
+    std::condition_variable cv_;
+
+    // Whether the workers should exit.
+    bool stop_;
+
+    void work();
+
+public:
+    explicit ThreadPool(int workers);
+
+    ~ThreadPool();
+
+    void submit(std::function<void()> job);
+};
+
+// Whether the current thread is already running a chunk of a parallel_for.
+static thread_local bool inside_parallel = false;
+
+ThreadPool::ThreadPool(int workers)
+    : stop_(false)
+{
+    for (int i = 0; i < workers; i++)
+    {
+        workers_.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(std::move(job));
+    }
+    cv_.notify_one();
+}
+
+void ThreadPool::work()
+{
+    inside_parallel = true;
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]()
+                     { return stop_ || !jobs_.empty(); });
+            if (jobs_.empty())
+            {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job();
+    }
+}
+
+// Thread count and the pool, created on first use.
+struct Parallel
+{
+    std::mutex mutex;
+    int threads;
+    std::unique_ptr<ThreadPool> pool;
+};
+
+static int hardware_threads()
+{
+    return std::max(1, int(std::thread::hardware_concurrency()));
+}
+
+static Parallel& parallel()
+{
+    static Parallel instance{{}, hardware_threads(), nullptr};
+    return instance;
+}
+
+// The calling thread takes part in the work, so the pool holds one thread less.
+static ThreadPool& pool()
+{
+    Parallel& p = parallel();
+    std::lock_guard<std::mutex> lock(p.mutex);
+    if (!p.pool)
+    {
+        p.pool = std::make_unique<ThreadPool>(p.threads - 1);
+    }
+    return *p.pool;
+}
+
+void set_num_threads(int n)
+{
+    Parallel& p = parallel();
+    std::lock_guard<std::mutex> lock(p.mutex);
+    p.threads = n > 0 ? n : hardware_threads();
+    p.pool.reset();
+}
+
+int num_threads()
+{
+    return parallel().threads;
+}
+
+} // namespace mla
+
+namespace mla::kernel
+{
+
+void parallel_for(int begin, int end, int grain, const std::function<void(int begin, int end)>& body)
+{
+    const int n = end - begin;
+    const int chunks = std::min(num_threads(), n / std::max(grain, 1));
+    if (chunks < 2 || inside_parallel)
+    {
+        if (n > 0)
+        {
+            body(begin, end);
+        }
+        return;
+    }
+
+    auto bound = [=](int chunk)
+    {
+        return begin + int((long long)n * chunk / chunks);
+    };
+
+    std::mutex mutex;
+    std::condition_variable done;
+    int remaining = chunks - 1;
+    std::exception_ptr error;
+
+    auto run = [&](int chunk)
+    {
+        try
+        {
+            body(bound(chunk), bound(chunk + 1));
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    ThreadPool& workers = pool();
+    for (int chunk = 1; chunk < chunks; chunk++)
+    {
+        workers.submit([&, chunk]()
+                       {
+            run(chunk);
+            // notify under the lock, so the waiting thread cannot return and destroy it first
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--remaining == 0)
+            {
+                done.notify_one();
+            } });
+    }
+
+    inside_parallel = true;
+    run(0);
+    inside_parallel = false;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&]()
+              { return remaining == 0; });
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace mla::kernel
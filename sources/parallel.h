@@ -0,0 +1,58 @@
+/**
+ * @file parallel.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief Thread pool used to run large operations on several cores.
+ * @version 1.0
+ * @date 2026.10.16
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <functional> // std::function
+
+namespace mla
+{
+
+/**
+ * @brief Set the number of threads used by the library, including the calling thread.
+ *
+ * Not meant to be called while an operation is running on other threads.
+ *
+ * @param n number of threads, 0 for the number of hardware threads, 1 to run everything serially
+ */
+void set_num_threads(int n);
+
+/**
+ * @brief Return the number of threads used by the library.
+ *
+ * @return the number of threads used by the library
+ */
+int num_threads();
+
+} // namespace mla
+
+namespace mla::kernel
+{
+
+// Element-wise work below this many elements stays on the calling thread.
+constexpr int PARALLEL_GRAIN = 1 << 15;
+
+/**
+ * @brief Split [begin, end) into chunks of at least grain indices and run body on each chunk in parallel.
+ *
+ * Runs serially on the calling thread when the range holds less than two chunks, when the library
+ * uses a single thread, or when called from inside another parallel_for.
+ *
+ * @param begin first index
+ * @param end one past the last index
+ * @param grain minimum number of indices per chunk
+ * @param body a function takes 2 args: chunk begin, chunk end
+ */
+void parallel_for(int begin, int end, int grain, const std::function<void(int begin, int end)>& body);
+
+} // namespace mla::kernel
+
+#endif // PARALLEL_H
@@ -0,0 +1,1068 @@
+#include "simd.h"
+
+#include <algorithm> // std::max
+#include <atomic>    // std::atomic
+#include <cmath>     // std::abs
+#include <limits>    // std::numeric_limits
+
+#if MLA_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace mla::kernel
+{
+
+/*
+ * Detection
+ */
+
+#if MLA_X86
+
+static void cpuid(int leaf, int subleaf, unsigned regs[4])
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, leaf, subleaf);
+    for (int i = 0; i < 4; i++)
+    {
+        regs[i] = unsigned(info[i]);
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Read the XCR0 register, which tells which register states the OS saves on context switch.
+MLA_TARGET("xsave")
+static unsigned long long xcr0()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+#endif // MLA_X86
+
+Isa detect_isa()
+{
+#if MLA_X86
+    unsigned regs[4];
+    cpuid(0, 0, regs);
+    const unsigned max_leaf = regs[0];
+
+    cpuid(1, 0, regs);
+    const bool sse2 = regs[3] & (1u << 26);
+    const bool osxsave = regs[2] & (1u << 27);
+    const bool avx = regs[2] & (1u << 28);
+    const bool fma = regs[2] & (1u << 12);
+    if (!sse2)
+    {
+        return Isa::SCALAR;
+    }
+    if (!(osxsave && avx && fma) || max_leaf < 7)
+    {
+        return Isa::SSE2;
+    }
+
+    // XMM and YMM state, then opmask and ZMM state
+    const unsigned long long xcr = xcr0();
+    const bool ymm_state = (xcr & 0x6) == 0x6;
+    const bool zmm_state = (xcr & 0xE6) == 0xE6;
+
+    cpuid(7, 0, regs);
+    const bool avx2 = regs[1] & (1u << 5);
+    const bool avx512f = regs[1] & (1u << 16);
+
+    if (avx512f && zmm_state)
+    {
+        return Isa::AVX512;
+    }
+    if (avx2 && ymm_state)
+    {
+        return Isa::AVX2;
+    }
+    return Isa::SSE2;
+#else
+    return Isa::SCALAR;
+#endif
+}
+
+/*
+ * Portable C++
+ */
+
+static void add_scalar(int n, const double* x, double* y)
+{
+    for (int i = 0; i < n; i++)
+    {
+        y[i] += x[i];
+    }
+}
+
+static void sub_scalar(int n, const double* x, double* y)
+{
+    for (int i = 0; i < n; i++)
+    {
+        y[i] -= x[i];
+    }
+}
+
+static void mul_scalar(int n, const double* x, double* y)
+{
+    for (int i = 0; i < n; i++)
+    {
+        y[i] *= x[i];
+    }
+}
+
+static void scale_scalar(int n, double c, double* y)
+{
+    for (int i = 0; i < n; i++)
+    {
+        y[i] *= c;
+    }
+}
+
+static double dot_scalar(int n, const double* x, const double* y)
+{
+    double result = 0;
+    for (int i = 0; i < n; i++)
+    {
+        result += x[i] * y[i];
+    }
+    return result;
+}
+
+static double axpy_amax_scalar(int n, double c, const double* x, double* y)
+{
+    double result = 0;
+    for (int i = 0; i < n; i++)
+    {
+        y[i] += c * x[i];
+        result = nan_max(result, std::abs(y[i]));
+    }
+    return result;
+}
+
+static void add_scalar(int n, const float* x, float* y)
+{
+    for (int i = 0; i < n; i++)
+    {
+        y[i] += x[i];
+    }
+}
+
+static void sub_scalar(int n, const float* x, float* y)
+{
+    for (int i = 0; i < n; i++)
+    {
+        y[i] -= x[i];
+    }
+}
+
+static void mul_scalar(int n, const float* x, float* y)
+{
+    for (int i = 0; i < n; i++)
+    {
+        y[i] *= x[i];
+    }
+}
+
+static void scale_scalar(int n, float c, float* y)
+{
+    for (int i = 0; i < n; i++)
+    {
+        y[i] *= c;
+    }
+}
+
+static float dot_scalar(int n, const float* x, const float* y)
+{
+    float result = 0;
+    for (int i = 0; i < n; i++)
+    {
+        result += x[i] * y[i];
+    }
+    return result;
+}
+
+static float axpy_amax_scalar(int n, float c, const float* x, float* y)
+{
+    float result = 0;
+    for (int i = 0; i < n; i++)
+    {
+        y[i] += c * x[i];
+        result = nan_max(result, std::abs(y[i]));
+    }
+    return result;
+}
+
+#if MLA_X86
+
+/*
+ * SSE2
+ */
+
+MLA_TARGET("sse2")
+static void add_sse2(int n, const double* x, double* y)
+{
+    int i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), _mm_loadu_pd(x + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] += x[i];
+    }
+}
+
+MLA_TARGET("sse2")
+static void sub_sse2(int n, const double* x, double* y)
+{
+    int i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        _mm_storeu_pd(y + i, _mm_sub_pd(_mm_loadu_pd(y + i), _mm_loadu_pd(x + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] -= x[i];
+    }
+}
+
+MLA_TARGET("sse2")
+static void mul_sse2(int n, const double* x, double* y)
+{
+    int i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        _mm_storeu_pd(y + i, _mm_mul_pd(_mm_loadu_pd(y + i), _mm_loadu_pd(x + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] *= x[i];
+    }
+}
+
+MLA_TARGET("sse2")
+static void scale_sse2(int n, double c, double* y)
+{
+    const __m128d vc = _mm_set1_pd(c);
+    int i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        _mm_storeu_pd(y + i, _mm_mul_pd(_mm_loadu_pd(y + i), vc));
+    }
+    for (; i < n; i++)
+    {
+        y[i] *= c;
+    }
+}
+
+MLA_TARGET("sse2")
+static double dot_sse2(int n, const double* x, const double* y)
+{
+    // independent accumulators hide the latency of the additions
+    __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd(), acc2 = _mm_setzero_pd(), acc3 = _mm_setzero_pd();
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2)));
+        acc2 = _mm_add_pd(acc2, _mm_mul_pd(_mm_loadu_pd(x + i + 4), _mm_loadu_pd(y + i + 4)));
+        acc3 = _mm_add_pd(acc3, _mm_mul_pd(_mm_loadu_pd(x + i + 6), _mm_loadu_pd(y + i + 6)));
+    }
+    for (; i + 2 <= n; i += 2)
+    {
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+    }
+    const __m128d acc = _mm_add_pd(_mm_add_pd(acc0, acc1), _mm_add_pd(acc2, acc3));
+    double result = _mm_cvtsd_f64(_mm_add_sd(acc, _mm_unpackhi_pd(acc, acc)));
+    for (; i < n; i++)
+    {
+        result += x[i] * y[i];
+    }
+    return result;
+}
+
+MLA_TARGET("sse2")
+static double axpy_amax_sse2(int n, double c, const double* x, double* y)
+{
+    // clearing the sign bit gives the magnitude, two accumulators hide the latency of the maximum
+    // maxpd drops a NaN in one operand, so NaNs are tracked apart by an unordered comparison
+    const __m128d vc = _mm_set1_pd(c), sign = _mm_set1_pd(-0.0);
+    __m128d max0 = _mm_setzero_pd(), max1 = _mm_setzero_pd(), nan = _mm_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m128d y0 = _mm_add_pd(_mm_loadu_pd(y + i), _mm_mul_pd(vc, _mm_loadu_pd(x + i)));
+        const __m128d y1 = _mm_add_pd(_mm_loadu_pd(y + i + 2), _mm_mul_pd(vc, _mm_loadu_pd(x + i + 2)));
+        _mm_storeu_pd(y + i, y0);
+        _mm_storeu_pd(y + i + 2, y1);
+        max0 = _mm_max_pd(max0, _mm_andnot_pd(sign, y0));
+        max1 = _mm_max_pd(max1, _mm_andnot_pd(sign, y1));
+        nan = _mm_or_pd(nan, _mm_cmpunord_pd(y0, y1));
+    }
+    const __m128d max = _mm_max_pd(max0, max1);
+    double result = _mm_movemask_pd(nan) != 0 ? std::numeric_limits<double>::quiet_NaN() : _mm_cvtsd_f64(_mm_max_sd(max, _mm_unpackhi_pd(max, max)));
+    for (; i < n; i++)
+    {
+        y[i] += c * x[i];
+        result = nan_max(result, std::abs(y[i]));
+    }
+    return result;
+}
+
+MLA_TARGET("sse2")
+static float hsum_sse2(__m128 v)
+{
+    const __m128 pairs = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+}
+
+MLA_TARGET("sse2")
+static float hmax_sse2(__m128 v)
+{
+    const __m128 pairs = _mm_max_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_max_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+}
+
+MLA_TARGET("sse2")
+static void add_sse2(int n, const float* x, float* y)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_loadu_ps(x + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] += x[i];
+    }
+}
+
+MLA_TARGET("sse2")
+static void sub_sse2(int n, const float* x, float* y)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm_storeu_ps(y + i, _mm_sub_ps(_mm_loadu_ps(y + i), _mm_loadu_ps(x + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] -= x[i];
+    }
+}
+
+MLA_TARGET("sse2")
+static void mul_sse2(int n, const float* x, float* y)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm_storeu_ps(y + i, _mm_mul_ps(_mm_loadu_ps(y + i), _mm_loadu_ps(x + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] *= x[i];
+    }
+}
+
+MLA_TARGET("sse2")
+static void scale_sse2(int n, float c, float* y)
+{
+    const __m128 vc = _mm_set1_ps(c);
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm_storeu_ps(y + i, _mm_mul_ps(_mm_loadu_ps(y + i), vc));
+    }
+    for (; i < n; i++)
+    {
+        y[i] *= c;
+    }
+}
+
+MLA_TARGET("sse2")
+static float dot_sse2(int n, const float* x, const float* y)
+{
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps(), acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+    int i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(x + i + 4), _mm_loadu_ps(y + i + 4)));
+        acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(x + i + 8), _mm_loadu_ps(y + i + 8)));
+        acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(x + i + 12), _mm_loadu_ps(y + i + 12)));
+    }
+    for (; i + 4 <= n; i += 4)
+    {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)));
+    }
+    float result = hsum_sse2(_mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3)));
+    for (; i < n; i++)
+    {
+        result += x[i] * y[i];
+    }
+    return result;
+}
+
+MLA_TARGET("sse2")
+static float axpy_amax_sse2(int n, float c, const float* x, float* y)
+{
+    const __m128 vc = _mm_set1_ps(c), sign = _mm_set1_ps(-0.0f);
+    __m128 max0 = _mm_setzero_ps(), max1 = _mm_setzero_ps(), nan = _mm_setzero_ps();
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m128 y0 = _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(vc, _mm_loadu_ps(x + i)));
+        const __m128 y1 = _mm_add_ps(_mm_loadu_ps(y + i + 4), _mm_mul_ps(vc, _mm_loadu_ps(x + i + 4)));
+        _mm_storeu_ps(y + i, y0);
+        _mm_storeu_ps(y + i + 4, y1);
+        max0 = _mm_max_ps(max0, _mm_andnot_ps(sign, y0));
+        max1 = _mm_max_ps(max1, _mm_andnot_ps(sign, y1));
+        nan = _mm_or_ps(nan, _mm_cmpunord_ps(y0, y1));
+    }
+    float result = _mm_movemask_ps(nan) != 0 ? std::numeric_limits<float>::quiet_NaN() : hmax_sse2(_mm_max_ps(max0, max1));
+    for (; i < n; i++)
+    {
+        y[i] += c * x[i];
+        result = nan_max(result, std::abs(y[i]));
+    }
+    return result;
+}
+
+/*
+ * AVX2
+ */
+
+MLA_TARGET("avx2,fma")
+static void add_avx2(int n, const double* x, double* y)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_loadu_pd(y + i), _mm256_loadu_pd(x + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] += x[i];
+    }
+}
+
+MLA_TARGET("avx2,fma")
+static void sub_avx2(int n, const double* x, double* y)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm256_storeu_pd(y + i, _mm256_sub_pd(_mm256_loadu_pd(y + i), _mm256_loadu_pd(x + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] -= x[i];
+    }
+}
+
+MLA_TARGET("avx2,fma")
+static void mul_avx2(int n, const double* x, double* y)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm256_storeu_pd(y + i, _mm256_mul_pd(_mm256_loadu_pd(y + i), _mm256_loadu_pd(x + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] *= x[i];
+    }
+}
+
+MLA_TARGET("avx2,fma")
+static void scale_avx2(int n, double c, double* y)
+{
+    const __m256d vc = _mm256_set1_pd(c);
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm256_storeu_pd(y + i, _mm256_mul_pd(_mm256_loadu_pd(y + i), vc));
+    }
+    for (; i < n; i++)
+    {
+        y[i] *= c;
+    }
+}
+
+MLA_TARGET("avx2,fma")
+static double dot_avx2(int n, const double* x, const double* y)
+{
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd(), acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), acc0);
+        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), acc1);
+        acc2 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 8), _mm256_loadu_pd(y + i + 8), acc2);
+        acc3 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 12), _mm256_loadu_pd(y + i + 12), acc3);
+    }
+    for (; i + 4 <= n; i += 4)
+    {
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), acc0);
+    }
+    const __m256d acc = _mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3));
+    const __m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+    double result = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+    for (; i < n; i++)
+    {
+        result += x[i] * y[i];
+    }
+    return result;
+}
+
+MLA_TARGET("avx2,fma")
+static double axpy_amax_avx2(int n, double c, const double* x, double* y)
+{
+    const __m256d vc = _mm256_set1_pd(c), sign = _mm256_set1_pd(-0.0);
+    __m256d max0 = _mm256_setzero_pd(), max1 = _mm256_setzero_pd(), nan = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m256d y0 = _mm256_fmadd_pd(vc, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+        const __m256d y1 = _mm256_fmadd_pd(vc, _mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4));
+        _mm256_storeu_pd(y + i, y0);
+        _mm256_storeu_pd(y + i + 4, y1);
+        max0 = _mm256_max_pd(max0, _mm256_andnot_pd(sign, y0));
+        max1 = _mm256_max_pd(max1, _mm256_andnot_pd(sign, y1));
+        nan = _mm256_or_pd(nan, _mm256_cmp_pd(y0, y1, _CMP_UNORD_Q));
+    }
+    const __m256d max = _mm256_max_pd(max0, max1);
+    const __m128d half = _mm_max_pd(_mm256_castpd256_pd128(max), _mm256_extractf128_pd(max, 1));
+    double result = _mm256_movemask_pd(nan) != 0 ? std::numeric_limits<double>::quiet_NaN() : _mm_cvtsd_f64(_mm_max_sd(half, _mm_unpackhi_pd(half, half)));
+    for (; i < n; i++)
+    {
+        y[i] += c * x[i];
+        result = nan_max(result, std::abs(y[i]));
+    }
+    return result;
+}
+
+MLA_TARGET("avx2,fma")
+static void add_avx2(int n, const float* x, float* y)
+{
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_loadu_ps(x + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] += x[i];
+    }
+}
+
+MLA_TARGET("avx2,fma")
+static void sub_avx2(int n, const float* x, float* y)
+{
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(y + i, _mm256_sub_ps(_mm256_loadu_ps(y + i), _mm256_loadu_ps(x + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] -= x[i];
+    }
+}
+
+MLA_TARGET("avx2,fma")
+static void mul_avx2(int n, const float* x, float* y)
+{
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(y + i, _mm256_mul_ps(_mm256_loadu_ps(y + i), _mm256_loadu_ps(x + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] *= x[i];
+    }
+}
+
+MLA_TARGET("avx2,fma")
+static void scale_avx2(int n, float c, float* y)
+{
+    const __m256 vc = _mm256_set1_ps(c);
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(y + i, _mm256_mul_ps(_mm256_loadu_ps(y + i), vc));
+    }
+    for (; i < n; i++)
+    {
+        y[i] *= c;
+    }
+}
+
+MLA_TARGET("avx2,fma")
+static float dot_avx2(int n, const float* x, const float* y)
+{
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps(), acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+    int i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8), acc1);
+        acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 16), _mm256_loadu_ps(y + i + 16), acc2);
+        acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 24), _mm256_loadu_ps(y + i + 24), acc3);
+    }
+    for (; i + 8 <= n; i += 8)
+    {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), acc0);
+    }
+    const __m256 acc = _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3));
+    float result = hsum_sse2(_mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1)));
+    for (; i < n; i++)
+    {
+        result += x[i] * y[i];
+    }
+    return result;
+}
+
+MLA_TARGET("avx2,fma")
+static float axpy_amax_avx2(int n, float c, const float* x, float* y)
+{
+    const __m256 vc = _mm256_set1_ps(c), sign = _mm256_set1_ps(-0.0f);
+    __m256 max0 = _mm256_setzero_ps(), max1 = _mm256_setzero_ps(), nan = _mm256_setzero_ps();
+    int i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m256 y0 = _mm256_fmadd_ps(vc, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i));
+        const __m256 y1 = _mm256_fmadd_ps(vc, _mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8));
+        _mm256_storeu_ps(y + i, y0);
+        _mm256_storeu_ps(y + i + 8, y1);
+        max0 = _mm256_max_ps(max0, _mm256_andnot_ps(sign, y0));
+        max1 = _mm256_max_ps(max1, _mm256_andnot_ps(sign, y1));
+        nan = _mm256_or_ps(nan, _mm256_cmp_ps(y0, y1, _CMP_UNORD_Q));
+    }
+    const __m256 max = _mm256_max_ps(max0, max1);
+    float result = _mm256_movemask_ps(nan) != 0 ? std::numeric_limits<float>::quiet_NaN() : hmax_sse2(_mm_max_ps(_mm256_castps256_ps128(max), _mm256_extractf128_ps(max, 1)));
+    for (; i < n; i++)
+    {
+        y[i] += c * x[i];
+        result = nan_max(result, std::abs(y[i]));
+    }
+    return result;
+}
+
+/*
+ * AVX-512, the tail is handled with masked loads and stores.
+ */
+
+MLA_TARGET("avx512f")
+static __mmask8 tail_mask(int remaining)
+{
+    return __mmask8((1u << remaining) - 1);
+}
+
+MLA_TARGET("avx512f")
+static void add_avx512(int n, const double* x, double* y)
+{
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm512_storeu_pd(y + i, _mm512_add_pd(_mm512_loadu_pd(y + i), _mm512_loadu_pd(x + i)));
+    }
+    if (i < n)
+    {
+        const __mmask8 m = tail_mask(n - i);
+        _mm512_mask_storeu_pd(y + i, m, _mm512_add_pd(_mm512_maskz_loadu_pd(m, y + i), _mm512_maskz_loadu_pd(m, x + i)));
+    }
+}
+
+MLA_TARGET("avx512f")
+static void sub_avx512(int n, const double* x, double* y)
+{
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm512_storeu_pd(y + i, _mm512_sub_pd(_mm512_loadu_pd(y + i), _mm512_loadu_pd(x + i)));
+    }
+    if (i < n)
+    {
+        const __mmask8 m = tail_mask(n - i);
+        _mm512_mask_storeu_pd(y + i, m, _mm512_sub_pd(_mm512_maskz_loadu_pd(m, y + i), _mm512_maskz_loadu_pd(m, x + i)));
+    }
+}
+
+MLA_TARGET("avx512f")
+static void mul_avx512(int n, const double* x, double* y)
+{
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm512_storeu_pd(y + i, _mm512_mul_pd(_mm512_loadu_pd(y + i), _mm512_loadu_pd(x + i)));
+    }
+    if (i < n)
+    {
+        const __mmask8 m = tail_mask(n - i);
+        _mm512_mask_storeu_pd(y + i, m, _mm512_mul_pd(_mm512_maskz_loadu_pd(m, y + i), _mm512_maskz_loadu_pd(m, x + i)));
+    }
+}
+
+MLA_TARGET("avx512f")
+static void scale_avx512(int n, double c, double* y)
+{
+    const __m512d vc = _mm512_set1_pd(c);
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm512_storeu_pd(y + i, _mm512_mul_pd(_mm512_loadu_pd(y + i), vc));
+    }
+    if (i < n)
+    {
+        const __mmask8 m = tail_mask(n - i);
+        _mm512_mask_storeu_pd(y + i, m, _mm512_mul_pd(_mm512_maskz_loadu_pd(m, y + i), vc));
+    }
+}
+
+MLA_TARGET("avx512f")
+static double dot_avx512(int n, const double* x, const double* y)
+{
+    __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd(), acc2 = _mm512_setzero_pd(), acc3 = _mm512_setzero_pd();
+    int i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), acc0);
+        acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8), acc1);
+        acc2 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 16), _mm512_loadu_pd(y + i + 16), acc2);
+        acc3 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 24), _mm512_loadu_pd(y + i + 24), acc3);
+    }
+    for (; i + 8 <= n; i += 8)
+    {
+        acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), acc0);
+    }
+    if (i < n)
+    {
+        const __mmask8 m = tail_mask(n - i);
+        acc1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, x + i), _mm512_maskz_loadu_pd(m, y + i), acc1);
+    }
+    alignas(64) double lanes[8];
+    _mm512_store_pd(lanes, _mm512_add_pd(_mm512_add_pd(acc0, acc1), _mm512_add_pd(acc2, acc3)));
+    return ((lanes[0] + lanes[4]) + (lanes[2] + lanes[6])) + ((lanes[1] + lanes[5]) + (lanes[3] + lanes[7]));
+}
+
+MLA_TARGET("avx512f")
+static double axpy_amax_avx512(int n, double c, const double* x, double* y)
+{
+    // the zero-masked maximum has no undefined source operand, unlike _mm512_max_pd in some GCC versions
+    const __m512d vc = _mm512_set1_pd(c);
+    __m512d max0 = _mm512_setzero_pd(), max1 = _mm512_setzero_pd();
+    __mmask8 nan = 0;
+    int i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m512d y0 = _mm512_fmadd_pd(vc, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i));
+        const __m512d y1 = _mm512_fmadd_pd(vc, _mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8));
+        _mm512_storeu_pd(y + i, y0);
+        _mm512_storeu_pd(y + i + 8, y1);
+        max0 = _mm512_maskz_max_pd(0xFF, max0, _mm512_abs_pd(y0));
+        max1 = _mm512_maskz_max_pd(0xFF, max1, _mm512_abs_pd(y1));
+        nan |= _mm512_cmp_pd_mask(y0, y1, _CMP_UNORD_Q);
+    }
+    for (; i < n; i += 8)
+    {
+        // the masked-off lanes load zeros, which do not change the maximum
+        const __mmask8 m = n - i >= 8 ? __mmask8(0xFF) : tail_mask(n - i);
+        const __m512d y0 = _mm512_fmadd_pd(vc, _mm512_maskz_loadu_pd(m, x + i), _mm512_maskz_loadu_pd(m, y + i));
+        _mm512_mask_storeu_pd(y + i, m, y0);
+        max0 = _mm512_maskz_max_pd(0xFF, max0, _mm512_abs_pd(y0));
+        nan |= _mm512_cmp_pd_mask(y0, y0, _CMP_UNORD_Q);
+    }
+    if (nan != 0)
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    alignas(64) double lanes[8];
+    _mm512_store_pd(lanes, _mm512_maskz_max_pd(0xFF, max0, max1));
+    return std::max(std::max(std::max(lanes[0], lanes[4]), std::max(lanes[2], lanes[6])), std::max(std::max(lanes[1], lanes[5]), std::max(lanes[3], lanes[7])));
+}
+
+MLA_TARGET("avx512f")
+static __mmask16 tail_mask16(int remaining)
+{
+    return __mmask16((1u << remaining) - 1);
+}
+
+MLA_TARGET("avx512f")
+static void add_avx512(int n, const float* x, float* y)
+{
+    int i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        _mm512_storeu_ps(y + i, _mm512_add_ps(_mm512_loadu_ps(y + i), _mm512_loadu_ps(x + i)));
+    }
+    if (i < n)
+    {
+        const __mmask16 m = tail_mask16(n - i);
+        _mm512_mask_storeu_ps(y + i, m, _mm512_add_ps(_mm512_maskz_loadu_ps(m, y + i), _mm512_maskz_loadu_ps(m, x + i)));
+    }
+}
+
+MLA_TARGET("avx512f")
+static void sub_avx512(int n, const float* x, float* y)
+{
+    int i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        _mm512_storeu_ps(y + i, _mm512_sub_ps(_mm512_loadu_ps(y + i), _mm512_loadu_ps(x + i)));
+    }
+    if (i < n)
+    {
+        const __mmask16 m = tail_mask16(n - i);
+        _mm512_mask_storeu_ps(y + i, m, _mm512_sub_ps(_mm512_maskz_loadu_ps(m, y + i), _mm512_maskz_loadu_ps(m, x + i)));
+    }
+}
+
+MLA_TARGET("avx512f")
+static void mul_avx512(int n, const float* x, float* y)
+{
+    int i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        _mm512_storeu_ps(y + i, _mm512_mul_ps(_mm512_loadu_ps(y + i), _mm512_loadu_ps(x + i)));
+    }
+    if (i < n)
+    {
+        const __mmask16 m = tail_mask16(n - i);
+        _mm512_mask_storeu_ps(y + i, m, _mm512_mul_ps(_mm512_maskz_loadu_ps(m, y + i), _mm512_maskz_loadu_ps(m, x + i)));
+    }
+}
+
+MLA_TARGET("avx512f")
+static void scale_avx512(int n, float c, float* y)
+{
+    const __m512 vc = _mm512_set1_ps(c);
+    int i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        _mm512_storeu_ps(y + i, _mm512_mul_ps(_mm512_loadu_ps(y + i), vc));
+    }
+    if (i < n)
+    {
+        const __mmask16 m = tail_mask16(n - i);
+        _mm512_mask_storeu_ps(y + i, m, _mm512_mul_ps(_mm512_maskz_loadu_ps(m, y + i), vc));
+    }
+}
+
+MLA_TARGET("avx512f")
+static float dot_avx512(int n, const float* x, const float* y)
+{
+    __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps(), acc2 = _mm512_setzero_ps(), acc3 = _mm512_setzero_ps();
+    int i = 0;
+    for (; i + 64 <= n; i += 64)
+    {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 16), _mm512_loadu_ps(y + i + 16), acc1);
+        acc2 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 32), _mm512_loadu_ps(y + i + 32), acc2);
+        acc3 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 48), _mm512_loadu_ps(y + i + 48), acc3);
+    }
+    for (; i + 16 <= n; i += 16)
+    {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), acc0);
+    }
+    if (i < n)
+    {
+        const __mmask16 m = tail_mask16(n - i);
+        acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, x + i), _mm512_maskz_loadu_ps(m, y + i), acc1);
+    }
+    alignas(64) float lanes[16];
+    _mm512_store_ps(lanes, _mm512_add_ps(_mm512_add_ps(acc0, acc1), _mm512_add_ps(acc2, acc3)));
+    float result = 0;
+    for (float lane : lanes)
+    {
+        result += lane;
+    }
+    return result;
+}
+
+MLA_TARGET("avx512f")
+static float axpy_amax_avx512(int n, float c, const float* x, float* y)
+{
+    // the zero-masked maximum has no undefined source operand, unlike _mm512_max_ps in some GCC versions
+    const __m512 vc = _mm512_set1_ps(c);
+    __m512 max0 = _mm512_setzero_ps(), max1 = _mm512_setzero_ps();
+    __mmask16 nan = 0;
+    int i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        const __m512 y0 = _mm512_fmadd_ps(vc, _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i));
+        const __m512 y1 = _mm512_fmadd_ps(vc, _mm512_loadu_ps(x + i + 16), _mm512_loadu_ps(y + i + 16));
+        _mm512_storeu_ps(y + i, y0);
+        _mm512_storeu_ps(y + i + 16, y1);
+        max0 = _mm512_maskz_max_ps(0xFFFF, max0, _mm512_abs_ps(y0));
+        max1 = _mm512_maskz_max_ps(0xFFFF, max1, _mm512_abs_ps(y1));
+        nan |= _mm512_cmp_ps_mask(y0, y1, _CMP_UNORD_Q);
+    }
+    for (; i < n; i += 16)
+    {
+        // the masked-off lanes load zeros, which do not change the maximum
+        const __mmask16 m = n - i >= 16 ? __mmask16(0xFFFF) : tail_mask16(n - i);
+        const __m512 y0 = _mm512_fmadd_ps(vc, _mm512_maskz_loadu_ps(m, x + i), _mm512_maskz_loadu_ps(m, y + i));
+        _mm512_mask_storeu_ps(y + i, m, y0);
+        max0 = _mm512_maskz_max_ps(0xFFFF, max0, _mm512_abs_ps(y0));
+        nan |= _mm512_cmp_ps_mask(y0, y0, _CMP_UNORD_Q);
+    }
+    if (nan != 0)
+    {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    alignas(64) float lanes[16];
+    _mm512_store_ps(lanes, _mm512_maskz_max_ps(0xFFFF, max0, max1));
+    float result = 0;
+    for (float lane : lanes)
+    {
+        result = std::max(result, lane);
+    }
+    return result;
+}
+
+#endif // MLA_X86
+
+/*
+ * Dispatch
+ */
+
+// Kernels for one instruction set.
+struct Kernels
+{
+    Isa isa;
+    void (*add)(int, const double*, double*);
+    void (*sub)(int, const double*, double*);
+    void (*mul)(int, const double*, double*);
+    void (*scale)(int, double, double*);
+    double (*dot)(int, const double*, const double*);
+    double (*axpy_amax)(int, double, const double*, double*);
+    void (*add_float)(int, const float*, float*);
+    void (*sub_float)(int, const float*, float*);
+    void (*mul_float)(int, const float*, float*);
+    void (*scale_float)(int, float, float*);
+    float (*dot_float)(int, const float*, const float*);
+    float (*axpy_amax_float)(int, float, const float*, float*);
+};
+
+static const Kernels SCALAR_KERNELS = {Isa::SCALAR, add_scalar, sub_scalar, mul_scalar, scale_scalar, dot_scalar, axpy_amax_scalar, add_scalar, sub_scalar, mul_scalar, scale_scalar, dot_scalar, axpy_amax_scalar};
+#if MLA_X86
+static const Kernels SSE2_KERNELS = {Isa::SSE2, add_sse2, sub_sse2, mul_sse2, scale_sse2, dot_sse2, axpy_amax_sse2, add_sse2, sub_sse2, mul_sse2, scale_sse2, dot_sse2, axpy_amax_sse2};
+static const Kernels AVX2_KERNELS = {Isa::AVX2, add_avx2, sub_avx2, mul_avx2, scale_avx2, dot_avx2, axpy_amax_avx2, add_avx2, sub_avx2, mul_avx2, scale_avx2, dot_avx2, axpy_amax_avx2};
+static const Kernels AVX512_KERNELS = {Isa::AVX512, add_avx512, sub_avx512, mul_avx512, scale_avx512, dot_avx512, axpy_amax_avx512, add_avx512, sub_avx512, mul_avx512, scale_avx512, dot_avx512, axpy_amax_avx512};
+#endif
+
+static const Kernels* kernels_for(Isa isa)
+{
+    switch (isa)
+    {
+#if MLA_X86
+        case Isa::AVX512:
+            return &AVX512_KERNELS;
+        case Isa::AVX2:
+            return &AVX2_KERNELS;
+        case Isa::SSE2:
+            return &SSE2_KERNELS;
+#endif
+        default:
+            return &SCALAR_KERNELS;
+    }
+}
+
+// The kernels in use, selected on first use so that it is safe during static initialization.
+static std::atomic<const Kernels*>& current()
+{
+    static std::atomic<const Kernels*> kernels(kernels_for(detect_isa()));
+    return kernels;
+}
+
+Isa isa()
+{
+    return current().load(std::memory_order_relaxed)->isa;
+}
+
+Isa set_isa(Isa isa)
+{
+    static const Isa detected = detect_isa();
+    const Isa selected = isa < detected ? isa : detected;
+    current().store(kernels_for(selected), std::memory_order_relaxed);
+    return selected;
+}
+
+void add(int n, const double* x, double* y)
+{
+    current().load(std::memory_order_relaxed)->add(n, x, y);
+}
+
+void sub(int n, const double* x, double* y)
+{
+    current().load(std::memory_order_relaxed)->sub(n, x, y);
+}
+
+void mul(int n, const double* x, double* y)
+{
+    current().load(std::memory_order_relaxed)->mul(n, x, y);
+}
+
+void scale(int n, double c, double* y)
+{
+    current().load(std::memory_order_relaxed)->scale(n, c, y);
+}
+
+double dot(int n, const double* x, const double* y)
+{
+    return current().load(std::memory_order_relaxed)->dot(n, x, y);
+}
+
+double axpy_amax(int n, double c, const double* x, double* y)
+{
+    return current().load(std::memory_order_relaxed)->axpy_amax(n, c, x, y);
+}
+
+void add(int n, const float* x, float* y)
+{
+    current().load(std::memory_order_relaxed)->add_float(n, x, y);
+}
+
+void sub(int n, const float* x, float* y)
+{
+    current().load(std::memory_order_relaxed)->sub_float(n, x, y);
+}
+
+void mul(int n, const float* x, float* y)
+{
+    current().load(std::memory_order_relaxed)->mul_float(n, x, y);
+}
+
+void scale(int n, float c, float* y)
+{
+    current().load(std::memory_order_relaxed)->scale_float(n, c, y);
+}
+
+float dot(int n, const float* x, const float* y)
+{
+    return current().load(std::memory_order_relaxed)->dot_float(n, x, y);
+}
+
+float axpy_amax(int n, float c, const float* x, float* y)
+{
+    return current().load(std::memory_order_relaxed)->axpy_amax_float(n, c, x, y);
+}
+
+} // namespace mla::kernel
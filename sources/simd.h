@@ -0,0 +1,187 @@
+/**
+ * @file simd.h
+ * @author 青羽 (chen_qingyu@qq.com, https://chen-qingyu.github.io/)
+ * @brief SIMD kernels with runtime instruction set dispatch.
+ * @version 1.0
+ * @date 2026.10.16
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MLA_X86 1
+#endif
+
+// Compile a single function for an instruction set beyond the baseline of the translation unit.
+// MSVC accepts the intrinsics of every instruction set without it.
+#if defined(__GNUC__) || defined(__clang__)
+#define MLA_TARGET(isa) __attribute__((target(isa)))
+#else
+#define MLA_TARGET(isa)
+#endif
+
+#include <algorithm> // std::max
+#include <cmath>     // std::abs std::isnan
+
+#include "utility.hpp"
+
+namespace mla::kernel
+{
+
+/**
+ * @brief Instruction set extensions, from the least to the most capable.
+ */
+enum class Isa
+{
+    SCALAR, // portable C++
+    SSE2,   // 128-bit
+    AVX2,   // 256-bit with FMA
+    AVX512  // 512-bit (AVX-512F)
+};
+
+/**
+ * @brief Return the most capable instruction set supported by both the CPU and the OS.
+ *
+ * @return the most capable supported instruction set
+ */
+Isa detect_isa();
+
+/**
+ * @brief Return the instruction set currently used by the kernels.
+ *
+ * @return the instruction set currently used by the kernels
+ */
+Isa isa();
+
+/**
+ * @brief Select the instruction set used by the kernels, capped at the detected one.
+ *
+ * Not meant to be called while kernels are running on other threads.
+ *
+ * @param isa the requested instruction set
+ * @return the instruction set actually selected
+ */
+Isa set_isa(Isa isa);
+
+/**
+ * @brief y[i] += x[i] for 0 <= i < n.
+ */
+void add(int n, const double* x, double* y);
+
+/**
+ * @brief y[i] -= x[i] for 0 <= i < n.
+ */
+void sub(int n, const double* x, double* y);
+
+/**
+ * @brief y[i] *= x[i] for 0 <= i < n.
+ */
+void mul(int n, const double* x, double* y);
+
+/**
+ * @brief y[i] *= c for 0 <= i < n.
+ */
+void scale(int n, double c, double* y);
+
+/**
+ * @brief Return the sum of x[i] * y[i] for 0 <= i < n.
+ */
+double dot(int n, const double* x, const double* y);
+
+/**
+ * @brief y[i] += c * x[i] for 0 <= i < n, and return the largest |y[i]|, NaN if any y[i] is NaN, zero if n is zero.
+ */
+double axpy_amax(int n, double c, const double* x, double* y);
+
+/*
+ * The same kernels on float, twice as many elements per instruction.
+ */
+
+void add(int n, const float* x, float* y);
+
+void sub(int n, const float* x, float* y);
+
+void mul(int n, const float* x, float* y);
+
+void scale(int n, float c, float* y);
+
+float dot(int n, const float* x, const float* y);
+
+float axpy_amax(int n, float c, const float* x, float* y);
+
+/*
+ * Portable versions for the other scalar types, such as std::complex<double>.
+ */
+
+template <typename T>
+void add(int n, const T* x, T* y)
+{
+    for (int i = 0; i < n; i++)
+    {
+        y[i] += x[i];
+    }
+}
+
+template <typename T>
+void sub(int n, const T* x, T* y)
+{
+    for (int i = 0; i < n; i++)
+    {
+        y[i] -= x[i];
+    }
+}
+
+template <typename T>
+void mul(int n, const T* x, T* y)
+{
+    for (int i = 0; i < n; i++)
+    {
+        y[i] *= x[i];
+    }
+}
+
+template <typename T>
+void scale(int n, T c, T* y)
+{
+    for (int i = 0; i < n; i++)
+    {
+        y[i] *= c;
+    }
+}
+
+template <typename T>
+T dot(int n, const T* x, const T* y)
+{
+    T result = 0;
+    for (int i = 0; i < n; i++)
+    {
+        result += x[i] * y[i];
+    }
+    return result;
+}
+
+// Running maximum of magnitudes that stays NaN once it meets one, std::max keeps or drops a NaN depending on the order.
+template <typename R>
+inline R nan_max(R result, R e)
+{
+    return e > result || std::isnan(e) ? e : result;
+}
+
+template <typename T>
+utility::real_t<T> axpy_amax(int n, T c, const T* x, T* y)
+{
+    utility::real_t<T> result = 0;
+    for (int i = 0; i < n; i++)
+    {
+        y[i] += c * x[i];
+        result = nan_max(result, std::abs(y[i]));
+    }
+    return result;
+}
+
+} // namespace mla::kernel
+
+#endif // SIMD_H
@@ -0,0 +1,194 @@
+#ifndef TEXT_HPP
+#define TEXT_HPP
+
+#include <charconv>     // std::to_chars std::from_chars
+#include <ostream>      // std::ostream
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <system_error> // std::errc
+
+#include "utility.hpp"
+
+namespace mla::text
+{
+
+/*
+ * Buffered writer of numbers and text to a stream or a string, formatting with std::to_chars into a local buffer
+ * that is written out when full, so no string is built per number and the output is never held whole.
+ */
+class Writer
+{
+private:
+    // Enough for any number in any format, a double in fixed notation takes up to 316 characters.
+    static constexpr int RESERVE = 512;
+
+    static constexpr int CAPACITY = 16384;
+
+    // Destination, one of the two is nullptr.
+    std::ostream* os_;
+    std::string* s_;
+
+    char buffer_[CAPACITY];
+
+    int size_;
+
+    // Make room for a number or a short text.
+    void reserve()
+    {
+        if (size_ > CAPACITY - RESERVE)
+        {
+            flush();
+        }
+    }
+
+    template <typename T>
+    void format(T e, bool fixed)
+    {
+        reserve();
+        auto result = fixed ? std::to_chars(buffer_ + size_, buffer_ + CAPACITY, e, std::chars_format::fixed, 6)
+                            : std::to_chars(buffer_ + size_, buffer_ + CAPACITY, e);
+        size_ = int(result.ptr - buffer_);
+    }
+
+public:
+    explicit Writer(std::ostream& os)
+        : os_(&os)
+        , s_(nullptr)
+        , size_(0)
+    {
+    }
+
+    explicit Writer(std::string& s)
+        : os_(nullptr)
+        , s_(&s)
+        , size_(0)
+    {
+    }
+
+    Writer(const Writer&) = delete;
+
+    Writer& operator=(const Writer&) = delete;
+
+    ~Writer()
+    {
+        flush();
+    }
+
+    void put(char c)
+    {
+        reserve();
+        buffer_[size_++] = c;
+    }
+
+    void put(std::string_view s)
+    {
+        if (size_ + int(s.size()) > CAPACITY)
+        {
+            flush();
+            if (os_ != nullptr)
+            {
+                os_->write(s.data(), std::streamsize(s.size()));
+            }
+            else
+            {
+                s_->append(s);
+            }
+            return;
+        }
+        s.copy(buffer_ + size_, s.size());
+        size_ += int(s.size());
+    }
+
+    void integer(long long e)
+    {
+        reserve();
+        size_ = int(std::to_chars(buffer_ + size_, buffer_ + CAPACITY, e).ptr - buffer_);
+    }
+
+    // Shortest representation that reads back to the same value.
+    template <typename T>
+    void shortest(const T& e)
+    {
+        if constexpr (utility::is_complex_v<T>)
+        {
+            put('(');
+            format(e.real(), false);
+            put(',');
+            format(e.imag(), false);
+            put(')');
+        }
+        else
+        {
+            format(e, false);
+        }
+    }
+
+    // Six decimals, the format of std::to_string.
+    template <typename T>
+    void fixed(const T& e)
+    {
+        if constexpr (utility::is_complex_v<T>)
+        {
+            put('(');
+            format(e.real(), true);
+            put(',');
+            format(e.imag(), true);
+            put(')');
+        }
+        else
+        {
+            format(e, true);
+        }
+    }
+
+    void flush()
+    {
+        if (os_ != nullptr)
+        {
+            os_->write(buffer_, size_);
+        }
+        else
+        {
+            s_->append(buffer_, size_);
+        }
+        size_ = 0;
+    }
+};
+
+// Skip spaces and tabs.
+inline const char* skip_blank(const char* first, const char* last)
+{
+    while (first != last && (*first == ' ' || *first == '\t'))
+    {
+        first++;
+    }
+    return first;
+}
+
+// Parse a number after optional blanks and an optional '+', return the end of the number, nullptr if there is none.
+template <typename T>
+inline const char* parse(const char* first, const char* last, T& e)
+{
+    first = skip_blank(first, last);
+    if (first != last && *first == '+')
+    {
+        first++;
+    }
+    auto result = std::from_chars(first, last, e);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+// Line without its trailing carriage return, for files written on Windows.
+inline std::string_view trim_line(const std::string& line)
+{
+    std::string_view s = line;
+    if (!s.empty() && s.back() == '\r')
+    {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+} // namespace mla::text
+
+#endif // TEXT_HPP
@@ -1,13 +1,15 @@
 #ifndef UTILITY_HPP
 #define UTILITY_HPP
 
+#include <complex>
 #include <stdexcept>
+#include <type_traits>
 
 namespace mla::utility
 {
 
 // Check whether the index is valid (begin <= pos < end).
-static inline void check_bounds(int pos, int begin, int end)
+static constexpr void check_bounds(int pos, int begin, int end)
 {
     if (pos < begin || pos >= end)
     {
@@ -15,6 +17,20 @@ static inline void check_bounds(int pos, int begin, int end)
     }
 }
 
+// Check the index of operator[], compiled out when MLA_NO_BOUNDS_CHECK is defined.
+// operator[] is defined inline in the headers and also instantiated by the library sources, so the macro
+// must be set the same way for every translation unit of the program, the library included. Mixing the
+// settings violates the one definition rule, and the linker may keep either version.
+static constexpr void check_index(int pos, int size)
+{
+#ifndef MLA_NO_BOUNDS_CHECK
+    check_bounds(pos, 0, size);
+#else
+    (void)pos;
+    (void)size;
+#endif
+}
+
 // Check whether is not empty.
 static inline void check_empty(int size)
 {
@@ -33,6 +49,12 @@ static inline void check_full(int size, int capacity)
     }
 }
 
+// Absolute value, usable in constant expressions.
+static constexpr double abs(double x)
+{
+    return x < 0 ? -x : x;
+}
+
 // Swap the content of the two elements.
 template <typename T>
 static inline void swap(T& e1, T& e2)
@@ -43,7 +65,7 @@ static inline void swap(T& e1, T& e2)
 }
 
 // Check that two vectors are of the same size.
-static inline void check_size(int s1, int s2)
+static constexpr void check_size(int s1, int s2)
 {
     if (s1 != s2)
     {
@@ -51,6 +73,26 @@ static inline void check_size(int s1, int s2)
     }
 }
 
+// Real type of a scalar: the scalar itself, or the type of the parts of a complex number.
+template <typename T>
+struct real_type
+{
+    using type = T;
+};
+
+template <typename T>
+struct real_type<std::complex<T>>
+{
+    using type = T;
+};
+
+template <typename T>
+using real_t = typename real_type<T>::type;
+
+// Whether the scalar is a complex number.
+template <typename T>
+constexpr bool is_complex_v = !std::is_same_v<T, real_t<T>>;
+
 } // namespace mla::utility
 
 #endif // UTILITY_HPP
@@ -0,0 +1,168 @@
+#include "../sources/Allocator.h"
+#include "../sources/Matrix.h"
+#include "../sources/Vector.h"
+
+#include "tool.hpp"
+
+#include <complex>
+#include <cstdint>
+
+using namespace mla;
+
+// Memory resource that counts the blocks it hands out.
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    int allocations = 0;
+    int deallocations = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        allocations++;
+        return default_memory_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        deallocations++;
+        default_memory_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& that) const noexcept override
+    {
+        return this == &that;
+    }
+};
+
+static bool is_aligned(const void* p)
+{
+    return reinterpret_cast<std::uintptr_t>(p) % ALIGNMENT == 0;
+}
+
+// ALIGNMENT
+TEST(Allocator, alignment)
+{
+    // short vectors are stored inline
+    for (int n = 1; n <= 200; n++)
+    {
+        ASSERT_TRUE(n <= SmallVector<double>::INLINE || is_aligned(Vector(n, 1).data()));
+        ASSERT_TRUE(n <= SmallVector<float>::INLINE || is_aligned(BasicVector<float>(n, 1).data()));
+        ASSERT_TRUE(is_aligned(Matrix(n, 3, 1).data()));
+    }
+
+    // pools hand out blocks of many sizes from the same chunks
+    MemoryResourceScope scope(thread_pool_resource());
+    for (int n = 1; n <= 200; n++)
+    {
+        ASSERT_TRUE(n <= SmallVector<double>::INLINE || is_aligned(Vector(n, 1).data()));
+        ASSERT_TRUE(n <= SmallVector<float>::INLINE || is_aligned(BasicVector<float>(n, 1).data()));
+        ASSERT_TRUE(is_aligned(Matrix(n, 3, 1).data()));
+    }
+}
+
+// memory_resource() set_memory_resource() MemoryResourceScope
+TEST(Allocator, memory_resource)
+{
+    ASSERT_EQ(memory_resource(), default_memory_resource());
+
+    CountingResource counter;
+    {
+        MemoryResourceScope scope(&counter);
+        ASSERT_EQ(memory_resource(), &counter);
+
+        // temporaries of the scope come from its resource
+        Vector a(100, 1), b(100, 2);
+        ASSERT_EQ(a + b, Vector(100, 3));
+        Matrix m = dot(Matrix(2, 2, 1), Matrix(2, 2, 1));
+        ASSERT_EQ(m, Matrix(2, 2, 2));
+
+        // nested scopes restore the outer resource
+        {
+            MemoryResourceScope inner(nullptr);
+            ASSERT_EQ(memory_resource(), default_memory_resource());
+        }
+        ASSERT_EQ(memory_resource(), &counter);
+    }
+    ASSERT_EQ(memory_resource(), default_memory_resource());
+    ASSERT_GE(counter.allocations, 7);
+    ASSERT_EQ(counter.allocations, counter.deallocations);
+
+    // an object built outside keeps the default resource when a scoped temporary is moved into it
+    Vector outside(100, 0);
+    {
+        MemoryResourceScope scope(&counter);
+        outside = Vector(100, 1);
+    }
+    const int allocations = counter.allocations;
+    ASSERT_EQ(outside, Vector(100, 1));
+    ASSERT_EQ(counter.allocations, counter.deallocations);
+    outside.append(Vector(100, 2));
+    ASSERT_EQ(counter.allocations, allocations);
+
+    set_memory_resource(&counter);
+    ASSERT_EQ(memory_resource(), &counter);
+    set_memory_resource(nullptr);
+    ASSERT_EQ(memory_resource(), default_memory_resource());
+}
+
+// thread_pool_resource()
+TEST(Allocator, thread_pool_resource)
+{
+    MemoryResourceScope scope(thread_pool_resource());
+
+    // a freed block is handed out again to the next temporary of its size
+    const double* p = Vector(8, 1).data();
+    Vector a(8, 2);
+    ASSERT_EQ(a.data(), p);
+    ASSERT_EQ(a, Vector(8, 2));
+
+    // large blocks go to the default resource
+    Vector b(10000, 1);
+    ASSERT_TRUE(is_aligned(b.data()));
+    ASSERT_EQ(b[9999], 1);
+}
+
+// SmallVector
+TEST(Allocator, small_vector)
+{
+    CountingResource counter;
+    MemoryResourceScope scope(&counter);
+
+    // short vectors and the rows of a small matrix do not allocate
+    Vector a = {1, 0, 0}, b = {0, 1, 0};
+    ASSERT_EQ(cross(a, b), Vector({0, 0, 1}));
+    ASSERT_EQ(a + b * 2, Vector({1, 2, 0}));
+    Matrix m = {{1, 2, 3}, {4, 5, 6}, {7, 8, 10}};
+    ASSERT_EQ(counter.allocations, 1);
+    ASSERT_EQ(BasicVector<float>(8, 1).size(), 8);
+    ASSERT_EQ(BasicVector<std::complex<double>>(2, 1).size(), 2);
+    ASSERT_EQ(counter.allocations, 1);
+
+    // growing past the inline capacity spills to the resource and keeps the elements
+    Vector v;
+    for (int i = 0; i < 20; i++)
+    {
+        v.append(i);
+    }
+    ASSERT_GT(counter.allocations, 1);
+    for (int i = 0; i < 20; i++)
+    {
+        ASSERT_EQ(v[i], i);
+    }
+    ASSERT_EQ(v.append(v).size(), 40);
+    ASSERT_EQ(v[39], 19);
+
+    // copies and moves of inline and spilled vectors
+    Vector small = {1, 2}, large(20, 3);
+    Vector copy = small, moved = std::move(large);
+    ASSERT_EQ(copy, Vector({1, 2}));
+    ASSERT_EQ(moved, Vector(20, 3));
+    ASSERT_EQ(large.size(), 0);
+    copy = moved;
+    moved = small;
+    ASSERT_EQ(copy, Vector(20, 3));
+    ASSERT_EQ(moved, Vector({1, 2}));
+    moved = std::move(copy);
+    ASSERT_EQ(moved, Vector(20, 3));
+}
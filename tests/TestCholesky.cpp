@@ -0,0 +1,109 @@
+#include "../sources/Cholesky.h"
+#include "../sources/LU.h"
+
+#include "tool.hpp"
+
+#include <cmath> // std::log
+
+using namespace mla;
+
+// n x n symmetric positive definite matrix.
+static Matrix make_spd(int n)
+{
+    Matrix a(n, n, 0);
+    a.map([](int r, int c, double& e)
+          { e = (r * 7 + c * 3) % 11 - 5; });
+    Matrix spd = dot(a.transpose(), a);
+    for (int i = 0; i < n; i++)
+    {
+        spd[i][i] += n;
+    }
+    // symmetric to the last bit
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < i; j++)
+        {
+            spd[j][i] = spd[i][j];
+        }
+    }
+    return spd;
+}
+
+// Cholesky() size() factor()
+TEST(Cholesky, basics)
+{
+    Cholesky cholesky = Matrix({{4, 2}, {2, 5}}).cholesky();
+    ASSERT_EQ(cholesky.size(), 2);
+    ASSERT_EQ(cholesky.factor(), Matrix({{2, 0}, {1, 2}}));
+    ASSERT_EQ(Matrix().cholesky().size(), 0);
+
+    // A = LL^T, across several diagonal blocks
+    Matrix a = make_spd(300);
+    Matrix l = a.cholesky().factor();
+    Matrix llt = dot(l, l.transpose());
+    for (int i = 0; i < 300; i++)
+    {
+        for (int j = 0; j < 300; j++)
+        {
+            ASSERT_NEAR(llt[i][j], a[i][j], 1e-9 * std::abs(a[i][i]));
+            if (j > i)
+            {
+                ASSERT_EQ(l[i][j], 0);
+            }
+        }
+    }
+
+    MY_ASSERT_THROW_MESSAGE(Matrix({{1, 2, 3}, {4, 5, 6}}).cholesky(), std::runtime_error, "Error: The dimensions mismatch.");
+    MY_ASSERT_THROW_MESSAGE(Matrix({{1, 2}, {2, 1}}).cholesky(), std::runtime_error, "Error: Not a symmetric positive definite matrix.");
+    MY_ASSERT_THROW_MESSAGE(Matrix({{1, 2}, {2, 4}}).cholesky(), std::runtime_error, "Error: Not a symmetric positive definite matrix.");
+    MY_ASSERT_THROW_MESSAGE(Matrix({{2, 1}, {0, 2}}).cholesky(), std::runtime_error, "Error: Not a symmetric positive definite matrix.");
+}
+
+// logdet()
+TEST(Cholesky, logdet)
+{
+    ASSERT_DOUBLE_EQ(Matrix({{4, 2}, {2, 5}}).cholesky().logdet(), std::log(16.0));
+    ASSERT_EQ(Matrix().cholesky().logdet(), 0);
+
+    Matrix a = make_spd(50);
+    ASSERT_NEAR(a.cholesky().logdet(), std::log(a.lu().det()), 1e-9);
+
+    // no overflow where the determinant itself is not representable
+    ASSERT_NEAR(Matrix(Matrix::eye(400) * 1e300).cholesky().logdet(), 400 * std::log(1e300), 1e-6);
+}
+
+// solve() inverse()
+TEST(Cholesky, solve)
+{
+    Matrix a = {{4, -2, 1}, {-2, 4, -2}, {1, -2, 4}};
+    Cholesky cholesky = a.cholesky();
+
+    Vector x = cholesky.solve(Vector({11, -16, 17}));
+    ASSERT_DOUBLE_EQ(x[0], 1);
+    ASSERT_DOUBLE_EQ(x[1], -2);
+    ASSERT_DOUBLE_EQ(x[2], 3);
+
+    MY_ASSERT_MATRIX_DOUBLE_EQ(cholesky.solve(Matrix({{11, 3.5}, {-16, -1}, {17, 2}})), Matrix({{1, 1}, {-2, 0.5}, {3, 0.5}}));
+    Matrix inverse = cholesky.inverse();
+    Matrix expected = a.lu().inverse();
+    for (int i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            ASSERT_NEAR(inverse[i][j], expected[i][j], 1e-15);
+        }
+    }
+
+    Matrix big = make_spd(300);
+    Matrix identity = dot(big, big.cholesky().inverse());
+    for (int i = 0; i < 300; i++)
+    {
+        for (int j = 0; j < 300; j++)
+        {
+            ASSERT_NEAR(identity[i][j], i == j ? 1 : 0, 1e-9);
+        }
+    }
+
+    MY_ASSERT_THROW_MESSAGE(cholesky.solve(Vector({1, 2})), std::runtime_error, "Error: The dimensions mismatch.");
+    MY_ASSERT_THROW_MESSAGE(cholesky.solve(Matrix(2, 2, 0)), std::runtime_error, "Error: The dimensions mismatch.");
+}
@@ -0,0 +1,317 @@
+#include "../sources/gemm.h"
+#include "../sources/simd.h"
+
+#include "tool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace mla;
+
+// Run the action once for every instruction set supported by this machine.
+template <typename Action>
+static void for_each_isa(Action action)
+{
+    const kernel::Isa original = kernel::isa();
+    for (auto isa : {kernel::Isa::SCALAR, kernel::Isa::SSE2, kernel::Isa::AVX2, kernel::Isa::AVX512})
+    {
+        if (kernel::set_isa(isa) == isa)
+        {
+            action();
+        }
+    }
+    kernel::set_isa(original);
+}
+
+// set_isa() isa() detect_isa()
+TEST(Kernel, isa)
+{
+    const kernel::Isa detected = kernel::detect_isa();
+    ASSERT_EQ(kernel::set_isa(kernel::Isa::SCALAR), kernel::Isa::SCALAR);
+    ASSERT_EQ(kernel::isa(), kernel::Isa::SCALAR);
+    ASSERT_EQ(kernel::set_isa(kernel::Isa::AVX512), detected);
+    ASSERT_EQ(kernel::isa(), detected);
+}
+
+// add() sub() mul() scale() dot() axpy_amax()
+TEST(Kernel, simd)
+{
+    for_each_isa([]()
+                 {
+        // every length up to a few vector widths, to cover the tails
+        for (int n = 0; n <= 37; n++)
+        {
+            std::vector<double> x(n), y(n);
+            for (int i = 0; i < n; i++)
+            {
+                x[i] = i % 7 - 3;
+                y[i] = i % 5 + 1;
+            }
+
+            std::vector<double> z = y;
+            kernel::add(n, x.data(), z.data());
+            for (int i = 0; i < n; i++)
+            {
+                ASSERT_EQ(z[i], y[i] + x[i]);
+            }
+
+            z = y;
+            kernel::sub(n, x.data(), z.data());
+            for (int i = 0; i < n; i++)
+            {
+                ASSERT_EQ(z[i], y[i] - x[i]);
+            }
+
+            z = y;
+            kernel::mul(n, x.data(), z.data());
+            for (int i = 0; i < n; i++)
+            {
+                ASSERT_EQ(z[i], y[i] * x[i]);
+            }
+
+            z = y;
+            kernel::scale(n, 0.5, z.data());
+            for (int i = 0; i < n; i++)
+            {
+                ASSERT_EQ(z[i], y[i] * 0.5);
+            }
+
+            double expected = 0;
+            for (int i = 0; i < n; i++)
+            {
+                expected += x[i] * y[i];
+            }
+            ASSERT_EQ(kernel::dot(n, x.data(), y.data()), expected);
+
+            z = y;
+            double max = 0;
+            for (int i = 0; i < n; i++)
+            {
+                max = std::max(max, std::abs(y[i] - 2 * x[i]));
+            }
+            ASSERT_EQ(kernel::axpy_amax(n, -2, x.data(), z.data()), max);
+            for (int i = 0; i < n; i++)
+            {
+                ASSERT_EQ(z[i], y[i] - 2 * x[i]);
+            }
+        } });
+}
+
+// float add() sub() mul() scale() dot() axpy_amax() gemm()
+TEST(Kernel, simd_float)
+{
+    for_each_isa([]()
+                 {
+        // every length up to a few vector widths of float, to cover the tails
+        for (int n = 0; n <= 70; n++)
+        {
+            std::vector<float> x(n), y(n);
+            for (int i = 0; i < n; i++)
+            {
+                x[i] = float(i % 7 - 3);
+                y[i] = float(i % 5 + 1);
+            }
+
+            std::vector<float> z = y;
+            kernel::add(n, x.data(), z.data());
+            for (int i = 0; i < n; i++)
+            {
+                ASSERT_EQ(z[i], y[i] + x[i]);
+            }
+
+            z = y;
+            kernel::sub(n, x.data(), z.data());
+            for (int i = 0; i < n; i++)
+            {
+                ASSERT_EQ(z[i], y[i] - x[i]);
+            }
+
+            z = y;
+            kernel::mul(n, x.data(), z.data());
+            for (int i = 0; i < n; i++)
+            {
+                ASSERT_EQ(z[i], y[i] * x[i]);
+            }
+
+            z = y;
+            kernel::scale(n, 0.5f, z.data());
+            for (int i = 0; i < n; i++)
+            {
+                ASSERT_EQ(z[i], y[i] * 0.5f);
+            }
+
+            float expected = 0;
+            for (int i = 0; i < n; i++)
+            {
+                expected += x[i] * y[i];
+            }
+            ASSERT_EQ(kernel::dot(n, x.data(), y.data()), expected);
+
+            z = y;
+            float max = 0;
+            for (int i = 0; i < n; i++)
+            {
+                max = std::max(max, std::abs(y[i] - 2 * x[i]));
+            }
+            ASSERT_EQ(kernel::axpy_amax(n, -2.0f, x.data(), z.data()), max);
+            for (int i = 0; i < n; i++)
+            {
+                ASSERT_EQ(z[i], y[i] - 2 * x[i]);
+            }
+        } });
+
+    // the packed product on float tiles, around the register tiles and cache blocks
+    for_each_isa([]()
+                 {
+        for (int s : {1, 7, 33, 97, 130})
+        {
+            const int m = s, n = s + 5, k = 2 * s + 300;
+            const int lda = k + 1, ldb = n + 2, ldc = n + 3;
+            std::vector<float> a(std::size_t(m) * lda), b(std::size_t(k) * ldb), c(std::size_t(m) * ldc, 1);
+            for (std::size_t i = 0; i < a.size(); i++)
+            {
+                a[i] = float(int(i % 9) - 4);
+            }
+            for (std::size_t i = 0; i < b.size(); i++)
+            {
+                b[i] = float(int(i % 5) - 2);
+            }
+
+            kernel::gemm(m, n, k, a.data(), lda, b.data(), ldb, c.data(), ldc);
+
+            for (int i = 0; i < m; i++)
+            {
+                for (int j = 0; j < n; j++)
+                {
+                    float expected = 1;
+                    for (int p = 0; p < k; p++)
+                    {
+                        expected += a[i * lda + p] * b[p * ldb + j];
+                    }
+                    ASSERT_EQ(c[i * ldc + j], expected);
+                }
+                // padding is left untouched
+                for (int j = n; j < ldc; j++)
+                {
+                    ASSERT_EQ(c[i * ldc + j], 1);
+                }
+            }
+        } });
+}
+
+// axpy_amax() with NaN and infinity
+TEST(Kernel, axpy_amax_non_finite)
+{
+    for_each_isa([]()
+                 {
+        // a NaN or an infinity at every position of every length, in the vector body and in the tail
+        for (int n = 1; n <= 37; n++)
+        {
+            for (int k = 0; k < n; k++)
+            {
+                std::vector<double> x(n, 1), y(n, -2);
+                y[k] = std::nan("");
+                ASSERT_TRUE(std::isnan(kernel::axpy_amax(n, 1, x.data(), y.data())));
+
+                std::vector<float> xf(n, 1), yf(n, -2);
+                yf[k] = std::nanf("");
+                ASSERT_TRUE(std::isnan(kernel::axpy_amax(n, 1.0f, xf.data(), yf.data())));
+
+                y.assign(n, -2);
+                y[k] = -INFINITY;
+                ASSERT_EQ(kernel::axpy_amax(n, 1, x.data(), y.data()), INFINITY);
+
+                yf.assign(n, -2);
+                yf[k] = -INFINITY;
+                ASSERT_EQ(kernel::axpy_amax(n, 1.0f, xf.data(), yf.data()), INFINITY);
+            }
+        } });
+}
+
+// gemm()
+TEST(Kernel, gemm)
+{
+    for_each_isa([]()
+                 {
+        // sizes around the register tiles and cache blocks, with padded leading dimensions
+        for (int s : {1, 7, 33, 97, 130})
+        {
+            const int m = s, n = s + 5, k = 2 * s + 300;
+            const int lda = k + 1, ldb = n + 2, ldc = n + 3;
+            std::vector<double> a(std::size_t(m) * lda), b(std::size_t(k) * ldb), c(std::size_t(m) * ldc, 1);
+            for (std::size_t i = 0; i < a.size(); i++)
+            {
+                a[i] = int(i % 9) - 4;
+            }
+            for (std::size_t i = 0; i < b.size(); i++)
+            {
+                b[i] = int(i % 5) - 2;
+            }
+
+            kernel::gemm(m, n, k, a.data(), lda, b.data(), ldb, c.data(), ldc);
+
+            for (int i = 0; i < m; i++)
+            {
+                for (int j = 0; j < n; j++)
+                {
+                    double expected = 1;
+                    for (int p = 0; p < k; p++)
+                    {
+                        expected += a[i * lda + p] * b[p * ldb + j];
+                    }
+                    ASSERT_EQ(c[i * ldc + j], expected);
+                }
+                // padding is left untouched
+                for (int j = n; j < ldc; j++)
+                {
+                    ASSERT_EQ(c[i * ldc + j], 1);
+                }
+            }
+        } });
+}
+
+// gemm() with the Strassen-Winograd recursion
+TEST(Kernel, strassen)
+{
+    const int original = strassen_crossover();
+    set_strassen_crossover(16);
+    ASSERT_EQ(strassen_crossover(), 16);
+
+    // odd and even dimensions, a few levels deep, with padded leading dimensions
+    for (int s : {16, 33, 64, 101})
+    {
+        const int m = s, n = s + 3, k = s + 6;
+        const int lda = k + 1, ldb = n + 2, ldc = n + 3;
+        std::vector<double> a(std::size_t(m) * lda), b(std::size_t(k) * ldb), c(std::size_t(m) * ldc, 1);
+        for (std::size_t i = 0; i < a.size(); i++)
+        {
+            a[i] = int(i % 9) - 4;
+        }
+        for (std::size_t i = 0; i < b.size(); i++)
+        {
+            b[i] = int(i % 5) - 2;
+        }
+
+        kernel::gemm(m, n, k, a.data(), lda, b.data(), ldb, c.data(), ldc);
+
+        for (int i = 0; i < m; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                double expected = 1;
+                for (int p = 0; p < k; p++)
+                {
+                    expected += a[i * lda + p] * b[p * ldb + j];
+                }
+                ASSERT_EQ(c[i * ldc + j], expected);
+            }
+            for (int j = n; j < ldc; j++)
+            {
+                ASSERT_EQ(c[i * ldc + j], 1);
+            }
+        }
+    }
+
+    set_strassen_crossover(original);
+}
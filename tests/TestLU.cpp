@@ -0,0 +1,124 @@
+#include "../sources/LU.h"
+
+#include "tool.hpp"
+
+using namespace mla;
+
+// LU() size() is_singular() factors() permutation()
+TEST(LU, basics)
+{
+    LU lu = Matrix({{1, 2}, {3, 4}}).lu();
+    ASSERT_EQ(lu.size(), 2);
+    ASSERT_FALSE(lu.is_singular());
+    ASSERT_EQ(lu.permutation(), std::vector<int>({1, 0}));
+
+    // PA = LU
+    Matrix l = {{1, 0}, {lu.factors()[1][0], 1}};
+    Matrix u = {{lu.factors()[0][0], lu.factors()[0][1]}, {0, lu.factors()[1][1]}};
+    MY_ASSERT_MATRIX_DOUBLE_EQ(dot(l, u), Matrix({{3, 4}, {1, 2}}));
+
+    ASSERT_TRUE(Matrix({{1, 2, 3}, {2, 4, 6}, {1, 0, 1}}).lu().is_singular());
+    ASSERT_TRUE(Matrix(3, 3, 0).lu().is_singular());
+
+    // only an exactly zero pivot is singular, a tiny one is left to the caller
+    ASSERT_FALSE(Matrix({{1e-20, 0}, {0, 1e-20}}).lu().is_singular());
+
+    // diagonal pivoting keeps the rows in place unless a pivot is zero
+    LU diagonal(Matrix({{1, 2}, {3, 4}}), Pivoting::DIAGONAL);
+    ASSERT_EQ(diagonal.permutation(), std::vector<int>({0, 1}));
+    ASSERT_EQ(diagonal.factors(), Matrix({{1, 2}, {3, -2}}));
+    ASSERT_EQ(LU(Matrix({{0, 1}, {1, 0}}), Pivoting::DIAGONAL).permutation(), std::vector<int>({1, 0}));
+    ASSERT_TRUE(LU(Matrix({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}), Pivoting::DIAGONAL).is_singular());
+    ASSERT_EQ(Matrix().lu().size(), 0);
+
+    MY_ASSERT_THROW_MESSAGE(Matrix({{1, 2, 3}, {4, 5, 6}}).lu(), std::runtime_error, "Error: The dimensions mismatch.");
+}
+
+// det()
+TEST(LU, det)
+{
+    ASSERT_EQ(Matrix({{2}}).lu().det(), 2);
+    ASSERT_EQ(Matrix({{0, 1}, {1, 0}}).lu().det(), -1);
+    ASSERT_EQ(Matrix({{1, 2}, {2, 4}}).lu().det(), 0);
+    ASSERT_EQ(LU(Matrix({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}), Pivoting::DIAGONAL).det(), 0);
+    ASSERT_EQ(Matrix({{1e-20, 0}, {0, 1e-20}}).lu().det(), 1e-40);
+    ASSERT_DOUBLE_EQ(Matrix({{2, 0, 1}, {1, 3, 2}, {1, 1, 2}}).lu().det(), 6);
+    ASSERT_EQ(Matrix().lu().det(), 1);
+}
+
+// solve()
+TEST(LU, solve)
+{
+    Matrix a = {{4, -2, 1}, {-2, 4, -2}, {1, -2, 4}};
+    LU lu = a.lu();
+
+    // one right-hand side
+    Vector x = lu.solve(Vector({11, -16, 17}));
+    ASSERT_DOUBLE_EQ(x[0], 1);
+    ASSERT_DOUBLE_EQ(x[1], -2);
+    ASSERT_DOUBLE_EQ(x[2], 3);
+
+    // many right-hand sides with the same factors
+    Matrix b = Matrix(3, 40, 0).map([](int r, int c, double& e)
+                                    { e = (r + 1) * (c % 7) - c; });
+    MY_ASSERT_MATRIX_DOUBLE_EQ(dot(a, lu.solve(b)), b);
+
+    MY_ASSERT_THROW_MESSAGE(lu.solve(Vector({1, 2})), std::runtime_error, "Error: The dimensions mismatch.");
+    MY_ASSERT_THROW_MESSAGE(lu.solve(Matrix(2, 2, 1)), std::runtime_error, "Error: The dimensions mismatch.");
+    MY_ASSERT_THROW_MESSAGE(Matrix(2, 2, 1).lu().solve(Vector({1, 2})), std::runtime_error, "Error: Singular matrix.");
+}
+
+// solve(ConstMatrixView a, const Vector& b) solve(ConstMatrixView a, const Matrix& b)
+TEST(LU, solve_direct)
+{
+    Matrix a = {{4, -2, 1}, {-2, 4, -2}, {1, -2, 4}};
+
+    Vector x = solve(a, Vector({11, -16, 17}));
+    ASSERT_DOUBLE_EQ(x[0], 1);
+    ASSERT_DOUBLE_EQ(x[1], -2);
+    ASSERT_DOUBLE_EQ(x[2], 3);
+
+    // same as the inverse path, with one factorization and no extra product
+    Matrix big = Matrix(60, 60, 0).map([](int r, int c, double& e)
+                                       { e = r == c ? 60 : (r * 7 + c * 3) % 11 - 5; });
+    Matrix b = Matrix(60, 5, 0).map([](int r, int c, double& e)
+                                    { e = (r + 1) * (c % 7) - c; });
+    Matrix solution = solve(big, b);
+    Matrix product = dot(big, solution);
+    Matrix through_inverse = dot(big.inv(), b);
+    for (int r = 0; r < 60; r++)
+    {
+        for (int c = 0; c < 5; c++)
+        {
+            ASSERT_NEAR(product[r][c], b[r][c], 1e-12);
+            ASSERT_NEAR(solution[r][c], through_inverse[r][c], 1e-14);
+        }
+    }
+
+    // a block without copying it first
+    ASSERT_EQ(solve(big.block(0, 0, 5, 5), Matrix(b.block(0, 0, 5, 5))), Matrix(big.block(0, 0, 5, 5)).lu().solve(Matrix(b.block(0, 0, 5, 5))));
+
+    MY_ASSERT_THROW_MESSAGE(solve(a, Vector({1, 2})), std::runtime_error, "Error: The dimensions mismatch.");
+    MY_ASSERT_THROW_MESSAGE(solve(Matrix(2, 3, 1), Vector({1, 2})), std::runtime_error, "Error: The dimensions mismatch.");
+    MY_ASSERT_THROW_MESSAGE(solve(Matrix(2, 2, 1), Matrix(2, 2, 1)), std::runtime_error, "Error: Singular matrix.");
+}
+
+// inverse()
+TEST(LU, inverse)
+{
+    MY_ASSERT_MATRIX_DOUBLE_EQ(Matrix({{1, 2}, {3, 4}}).lu().inverse(), Matrix({{-2.0, 1.0}, {1.5, -0.5}}));
+
+    // A * inv(A) = E on a larger, well-conditioned matrix
+    Matrix a = Matrix(60, 60, 0).map([](int r, int c, double& e)
+                                     { e = r == c ? 60 : (r * 7 + c * 3) % 11 - 5; });
+    Matrix product = dot(a, a.lu().inverse());
+    for (int r = 0; r < 60; r++)
+    {
+        for (int c = 0; c < 60; c++)
+        {
+            ASSERT_NEAR(product[r][c], r == c ? 1 : 0, 1e-12);
+        }
+    }
+
+    MY_ASSERT_THROW_MESSAGE(Matrix(2, 2, 1).lu().inverse(), std::runtime_error, "Error: Singular matrix.");
+}
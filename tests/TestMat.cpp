@@ -0,0 +1,123 @@
+#include "../sources/Mat.h"
+
+#include "tool.hpp"
+
+using namespace mla;
+
+// Everything below except the conversions is evaluated at compile time.
+constexpr Mat2 a = {{1, 2}, {3, 4}};
+static_assert(a.det() == -2);
+static_assert(Mat2({2, 1}, {1, 1}).inv() == Mat2({1, -1}, {-1, 2}));
+static_assert(dot(Mat<2, 3>({1, 2, 3}, {4, 5, 6}), Mat<3, 1>({1}, {0}, {1})) == Mat<2, 1>({4}, {10}));
+static_assert(dot(a, Vec<2>(1, 1)) == Vec<2>(3, 7));
+static_assert(Mat<2, 3>({1, 2, 3}, {4, 5, 6}).transpose() == Mat<3, 2>({1, 4}, {2, 5}, {3, 6}));
+
+// constructor row_size() col_size() operator==() operator!=()
+TEST(Mat, basics)
+{
+    // Mat()
+    Mat<2, 3> mat1;
+    ASSERT_EQ(mat1.row_size(), 2);
+    ASSERT_EQ(mat1.col_size(), 3);
+    ASSERT_EQ(mat1, (Mat<2, 3>({0, 0, 0}, {0, 0, 0})));
+
+    // Mat(const double (&... rows)[Ns])
+    Mat<2, 3> mat2 = {{1, 2, 3}, {4, 5, 6}};
+    ASSERT_NE(mat1, mat2);
+
+    // eye()
+    ASSERT_EQ(Mat2::eye(), Mat2({1, 0}, {0, 1}));
+
+    // layout
+    static_assert(sizeof(Mat4) == 16 * sizeof(double));
+}
+
+// operator[]()
+TEST(Mat, access)
+{
+    Mat<2, 3> mat = {{1, 2, 3}, {4, 5, 6}};
+    for (int r = 0; r < mat.row_size(); r++)
+    {
+        for (int c = 0; c < mat.col_size(); c++)
+        {
+            ASSERT_EQ(mat[r][c], r * 3 + c + 1);
+        }
+    }
+
+    mat[1] = Vec<3>(7, 8, 9);
+    ASSERT_EQ(mat, (Mat<2, 3>({1, 2, 3}, {7, 8, 9})));
+
+#ifndef MLA_NO_BOUNDS_CHECK
+    MY_ASSERT_THROW_MESSAGE(mat[2], std::runtime_error, "Error: Index out of range.");
+#endif
+}
+
+// Mat(const Matrix& matrix) operator Matrix()
+TEST(Mat, convert)
+{
+    Mat2 mat(Matrix({{1, 2}, {3, 4}}));
+    ASSERT_EQ(mat, Mat2({1, 2}, {3, 4}));
+
+    Matrix matrix = mat;
+    ASSERT_EQ(matrix, Matrix({{1, 2}, {3, 4}}));
+
+    MY_ASSERT_THROW_MESSAGE(Mat2(Matrix(2, 3, 0)), std::runtime_error, "Error: The dimensions mismatch.");
+}
+
+// det() inv() transpose()
+TEST(Mat, algebra)
+{
+    ASSERT_EQ((Mat<1, 1>({5}).det()), 5);
+    ASSERT_EQ(Mat3({1, 2, 3}, {4, 5, 6}, {7, 8, 0}).det(), 27);
+    ASSERT_EQ(Mat3({1, 2, 3}, {4, 5, 6}, {7, 8, 9}).det(), 0);
+    ASSERT_DOUBLE_EQ(Mat4({0, 1, 0, 0}, {1, 0, 0, 0}, {0, 0, 2, 1}, {0, 0, 1, 2}).det(), -3);
+    ASSERT_EQ(Mat4({1, 2, 3, 4}, {2, 4, 6, 8}, {0, 0, 1, 0}, {0, 0, 0, 1}).det(), 0);
+
+    // agrees with the dynamic matrix
+    Mat4 mat = {{4, -2, 1, 0}, {-2, 4, -2, 1}, {1, -2, 4, -2}, {0, 1, -2, 4}};
+    ASSERT_DOUBLE_EQ(mat.det(), Matrix(mat).det());
+    MY_ASSERT_MATRIX_DOUBLE_EQ(Matrix(mat.inv()), Matrix(mat).inv());
+    Mat4 product = dot(mat, mat.inv());
+    for (int r = 0; r < 4; r++)
+    {
+        for (int c = 0; c < 4; c++)
+        {
+            ASSERT_NEAR(product[r][c], r == c ? 1 : 0, 1e-15);
+        }
+    }
+
+    MY_ASSERT_THROW_MESSAGE(Mat2({1, 2}, {2, 4}).inv(), std::runtime_error, "Error: Singular matrix.");
+    ASSERT_EQ((Mat4::eye() * 1e-20).inv(), Mat4::eye() * 1e20);
+
+    ASSERT_EQ((Mat<1, 2>({1, 2}).transpose()), (Mat<2, 1>({1}, {2})));
+}
+
+// operator+=() operator-=() operator*=() operator+() operator-() operator*() dot()
+TEST(Mat, arithmetic)
+{
+    Mat2 mat = {{1, 2}, {3, 4}};
+    mat += Mat2({1, 1}, {1, 1});
+    ASSERT_EQ(mat, Mat2({2, 3}, {4, 5}));
+    mat -= Mat2({2, 2}, {2, 2});
+    ASSERT_EQ(mat, Mat2({0, 1}, {2, 3}));
+    mat *= Mat2({2, 2}, {2, 2});
+    ASSERT_EQ(mat, Mat2({0, 2}, {4, 6}));
+    mat *= 0.5;
+    ASSERT_EQ(mat, Mat2({0, 1}, {2, 3}));
+
+    ASSERT_EQ(mat + mat, mat * 2);
+    ASSERT_EQ(mat - mat, Mat2());
+    ASSERT_EQ(mat * mat, Mat2({0, 1}, {4, 9}));
+    ASSERT_EQ(0.5 * mat, Mat2({0, 0.5}, {1, 1.5}));
+
+    ASSERT_EQ((dot(Mat<1, 2>({1, 2}), Mat<2, 1>({3}, {4}))), (Mat<1, 1>({11})));
+    ASSERT_EQ(dot(Mat2({1, 2}, {3, 4}), Vec<2>(1, 0)), Vec<2>(1, 3));
+}
+
+// operator<<()
+TEST(Mat, print)
+{
+    std::ostringstream oss;
+    oss << Mat2({1, 2}, {3, 4});
+    ASSERT_EQ(oss.str(), Matrix({{1, 2}, {3, 4}}).to_string());
+}
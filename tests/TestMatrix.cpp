@@ -1,7 +1,11 @@
 #include "../sources/Matrix.h"
+#include "../sources/simd.h"
 
 #include "tool.hpp"
 
+#include <cmath>
+#include <sstream>
+
 using namespace mla;
 
 // constructor destructor row_size() col_size()
@@ -87,8 +91,58 @@ TEST(Matrix, access)
     matrix[0][0] = 0;
     ASSERT_EQ(matrix[0][0], 0);
 
+    // row assignment
+    matrix[0] = Vector({7, 8, 9});
+    ASSERT_EQ(matrix, Matrix({{7, 8, 9}, {4, 5, 6}}));
+    matrix[1] = matrix[0];
+    ASSERT_EQ(matrix, Matrix({{7, 8, 9}, {7, 8, 9}}));
+    MY_ASSERT_THROW_MESSAGE(matrix[0] = Vector({1, 2}), std::runtime_error, "Error: The dimensions mismatch.");
+
+    // row copy
+    Vector row = matrix[1];
+    row[0] = 0;
+    ASSERT_EQ(row, Vector({0, 8, 9}));
+    ASSERT_EQ(matrix[1][0], 7);
+
+    // row queries and operations, like on a vector
+    ASSERT_EQ(matrix[0].to_string(), "[7.000000 8.000000 9.000000]");
+    ASSERT_DOUBLE_EQ(Matrix({{3, 4}}).at(0).length(), 5);
+    ASSERT_EQ(Matrix({{0, 0, 1}}).at(0).count_leading_zeros(), 2);
+    ASSERT_TRUE(Matrix(1, 2, 0).at(0).is_zero());
+    ASSERT_FALSE(matrix[0].is_zero());
+    ASSERT_EQ(matrix[0], Vector({7, 8, 9}));
+    ASSERT_EQ(Vector({7, 8, 9}), matrix[1]);
+    ASSERT_EQ(matrix[0], matrix[1]);
+    ASSERT_NE(matrix[0], Vector({7, 8}));
+    matrix[1] += Vector({1, 1, 1});
+    matrix[1] -= matrix[0];
+    ASSERT_EQ(matrix[1], Vector({1, 1, 1}));
+    matrix[1] *= 2;
+    matrix[1] *= Vector({1, 2, 3});
+    ASSERT_EQ(matrix, Matrix({{7, 8, 9}, {2, 4, 6}}));
+    MY_ASSERT_THROW_MESSAGE(matrix[1] += Vector({1, 2}), std::runtime_error, "Error: The dimensions mismatch.");
+    Matrix unit = {{0, 2}};
+    unit[0].unitize();
+    ASSERT_EQ(unit, Matrix({{0, 1}}));
+    MY_ASSERT_THROW_MESSAGE(Matrix(1, 2, 0).at(0).unitize(), std::runtime_error, "Error: The zero vector can not be unitized.");
+    matrix[1] = Vector({7, 8, 9});
+
+    // at
+    ASSERT_EQ(matrix.at(1).at(2), 9);
+    ASSERT_EQ(matrix.at(1, 2), 9);
+    matrix.at(1, 2) = 0;
+    ASSERT_EQ(std::as_const(matrix).at(1, 2), 0);
+    ASSERT_EQ(std::as_const(matrix).at(1)[2], 0);
+
     // check bounds
+#ifndef MLA_NO_BOUNDS_CHECK
     MY_ASSERT_THROW_MESSAGE(matrix[5][5], std::runtime_error, "Error: Index out of range.");
+    MY_ASSERT_THROW_MESSAGE(matrix[0][5], std::runtime_error, "Error: Index out of range.");
+#endif
+    MY_ASSERT_THROW_MESSAGE(matrix.at(5), std::runtime_error, "Error: Index out of range.");
+    MY_ASSERT_THROW_MESSAGE(matrix.at(0).at(5), std::runtime_error, "Error: Index out of range.");
+    MY_ASSERT_THROW_MESSAGE(matrix.at(2, 0), std::runtime_error, "Error: Index out of range.");
+    MY_ASSERT_THROW_MESSAGE(matrix.at(0, 3), std::runtime_error, "Error: Index out of range.");
 }
 
 // begin() end()
@@ -111,6 +165,38 @@ TEST(Matrix, iterator)
     {
         ASSERT_EQ(e.size(), 3);
     }
+
+    // for in, writing through the rows
+    for (auto& row : matrix)
+    {
+        row *= 2;
+    }
+    ASSERT_EQ(matrix, Matrix({{2, 4, 6}, {8, 10, 12}}));
+}
+
+// operator+() operator-() operator*() dot() on rows
+TEST(Matrix, row_arithmetic)
+{
+    Matrix matrix = {{1, 2, 3}, {4, 5, 6}};
+    const Matrix& constant = matrix;
+    Vector v = {1, 1, 1};
+
+    ASSERT_EQ(matrix[0] + v, Vector({2, 3, 4}));
+    ASSERT_EQ(v - matrix[1], Vector({-3, -4, -5}));
+    ASSERT_EQ(matrix[0] * 2.0, Vector({2, 4, 6}));
+    ASSERT_EQ(2 * constant[1], Vector({8, 10, 12}));
+    ASSERT_EQ(matrix[0] * constant[1], Vector({4, 10, 18}));
+    ASSERT_EQ(dot(matrix[0], v), 6);
+    ASSERT_EQ((matrix[0] + matrix[1]).length(), std::sqrt(5 * 5 + 7 * 7 + 9 * 9));
+
+    // fused with lazy(), and still a vector without it
+    Vector fused = lazy(matrix[0]) + lazy(v) * 2 - matrix[1];
+    ASSERT_EQ(fused, Vector({-1, -1, -1}));
+    Vector sum = matrix[0] + matrix[1];
+    sum[0] = 0;
+    ASSERT_EQ(matrix[0][0], 1);
+
+    MY_ASSERT_THROW_MESSAGE(matrix[0] + Vector({1, 2}), std::runtime_error, "Error: The dimensions mismatch.");
 }
 
 // to_string()
@@ -134,6 +220,46 @@ TEST(Matrix, rank)
     ASSERT_EQ(Matrix({{1, 2}, {3, 4}, {5, 6}}).rank(), 2);
     ASSERT_EQ(Matrix({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}).rank(), 2);
     ASSERT_EQ(Matrix({{1, 2, 3}, {4, 5, 6}, {7, 8, 0}}).rank(), 3);
+    ASSERT_EQ(Matrix().rank(), 0);
+    ASSERT_EQ(Matrix(3, 4, 0).rank(), 0);
+    ASSERT_EQ(Matrix({{0, 0, 1}, {0, 0, 2}, {1, 0, 0}}).rank(), 2);
+
+    // rounding noise of the elimination is not counted
+    ASSERT_EQ(Matrix({{0.1, 0.2, 0.3}, {0.4, 0.5, 0.6}, {0.7, 0.8, 0.9}}).rank(), 2);
+
+    // a larger matrix of known rank: the product of 200 x 30 and 30 x 150 factors
+    Matrix left = Matrix(200, 30, 0).map([](int r, int c, double& e)
+                                         { e = r == c ? 10 : (r * 7 + c * 3) % 11 - 5; });
+    Matrix right = Matrix(30, 150, 0).map([](int r, int c, double& e)
+                                          { e = r == c ? 10 : (r * 5 + c * 2) % 13 - 6; });
+    ASSERT_EQ(dot(left, right).rank(), 30);
+    ASSERT_EQ(dot(left, right).transpose().rank(), 30);
+
+    // rank(double tolerance)
+    Matrix nearly = {{1, 0}, {0, 1e-9}};
+    ASSERT_EQ(nearly.rank(), 2);
+    ASSERT_EQ(nearly.rank(1e-6), 1);
+    ASSERT_EQ(nearly.rank(0), 2);
+    ASSERT_EQ(nearly.rank(2), 0);
+
+    // NaN is never negligible and an infinity leaves no default tolerance, whatever the instruction set
+    const kernel::Isa original = kernel::isa();
+    for (auto isa : {kernel::Isa::SCALAR, kernel::Isa::SSE2, kernel::Isa::AVX2, kernel::Isa::AVX512})
+    {
+        kernel::set_isa(isa);
+
+        Matrix nan(4, 12, 1);
+        nan[2][9] = std::nan("");
+        ASSERT_EQ(nan.rank(), 4);
+        ASSERT_EQ(nan.rank(1), 4);
+
+        Matrix inf(4, 12, 1);
+        inf[1][5] = -INFINITY;
+        ASSERT_EQ(inf.rank(), 2);
+        ASSERT_EQ(Matrix({{1, 2}, {3, INFINITY}}).rank(), 2);
+        ASSERT_EQ(Matrix({{INFINITY, 0}, {0, 0}}).rank(), 1);
+    }
+    kernel::set_isa(original);
 }
 
 // det()
@@ -141,6 +267,10 @@ TEST(Matrix, det)
 {
     ASSERT_EQ(Matrix({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}).det(), 0);
     ASSERT_EQ(Matrix({{1, 2, 3}, {4, 5, 6}, {7, 8, 0}}).det(), 27);
+    ASSERT_EQ(Matrix({{0, 1}, {1, 0}}).det(), -1);
+
+    // a well-scaled matrix is not singular however small its elements
+    ASSERT_EQ(Matrix({{1e-20, 0}, {0, 1}}).det(), 1e-20);
     MY_ASSERT_THROW_MESSAGE(Matrix({{1, 2, 3}, {4, 5, 6}}).det(), std::runtime_error, "Error: The dimensions mismatch.");
 }
 
@@ -148,6 +278,8 @@ TEST(Matrix, det)
 TEST(Matrix, inv)
 {
     ASSERT_EQ(Matrix({{1, 2}, {3, 4}}).inv(), Matrix({{-2.0, 1.0}, {1.5, -0.5}}));
+    ASSERT_EQ(Matrix({{0, 2}, {4, 0}}).inv(), Matrix({{0, 0.25}, {0.5, 0}}));
+    ASSERT_EQ(Matrix({{1e-20, 0}, {0, 1}}).inv(), Matrix({{1e20, 0}, {0, 1}}));
     MY_ASSERT_THROW_MESSAGE(Matrix({{1, 2, 3}, {4, 5, 6}}).inv(), std::runtime_error, "Error: The dimensions mismatch.");
     MY_ASSERT_THROW_MESSAGE(Matrix({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}).inv(), std::runtime_error, "Error: Singular matrix.");
 }
@@ -182,13 +314,46 @@ TEST(Matrix, transform_row_echelon)
 // map()
 TEST(Matrix, map)
 {
-    ASSERT_EQ(Matrix(2, 2, 1).map([](int r, int c, double& e)
+    ASSERT_EQ(Matrix(2, 2, 1).map([](int, int, double& e)
                                   { e *= 4; }),
               Matrix(2, 2, 4));
 
     ASSERT_EQ(Matrix(2, 2, 0).map([](int r, int c, double& e)
                                   { e = r + c; }),
               Matrix({{0, 1}, {1, 2}}));
+
+    const double scale = 3;
+    ASSERT_EQ(Matrix(2, 2, 1).map([scale](double& e)
+                                  { e *= scale; }),
+              Matrix(2, 2, 3));
+
+    // large enough to be split across threads when asked to
+    Matrix big = Matrix(300, 257, 0).map([scale](int r, int c, double& e)
+                                         { e = scale * r + c; },
+                                         true);
+    ASSERT_EQ(big[299][256], 3 * 299 + 256);
+
+    // serial in row-major order by default, so a stateful callable is safe on a large matrix
+    double count = 0;
+    big.map([&count](double& e)
+            { e = count++; });
+    ASSERT_EQ(count, 300 * 257);
+    ASSERT_EQ(big[299][256], 300 * 257 - 1);
+    ASSERT_EQ(big[1][0], 257);
+}
+
+// for_each()
+TEST(Matrix, for_each)
+{
+    double sum = 0;
+    Matrix({{1, 2}, {3, 4}}).for_each([&sum](const double& e)
+                                      { sum += e; });
+    ASSERT_EQ(sum, 10);
+
+    std::vector<int> order;
+    Matrix({{1, 2}, {3, 4}}).for_each([&order](int r, int c, const double&)
+                                      { order.push_back(r * 10 + c); });
+    ASSERT_EQ(order, std::vector<int>({0, 1, 10, 11}));
 }
 
 // split_row() split_col()
@@ -203,11 +368,38 @@ TEST(Matrix, split)
     ASSERT_EQ(matrix.split_col(1).second, Matrix({{2}, {4}, {6}}));
 }
 
-// transpose()
+// transpose() transpose_inplace()
 TEST(Matrix, transpose)
 {
     ASSERT_EQ(Matrix(2, 3, 1).transpose(), Matrix(3, 2, 1));
     ASSERT_EQ(Matrix(1, 3, 3).transpose(), Matrix(3, 1, 3));
+    ASSERT_EQ(Matrix({{1, 2, 3}, {4, 5, 6}}).transpose(), Matrix({{1, 4}, {2, 5}, {3, 6}}));
+    ASSERT_EQ(Matrix().transpose(), Matrix());
+
+    // sizes around the tiles
+    for (int n : {31, 32, 33, 100})
+    {
+        Matrix matrix = Matrix(n, n + 7, 0).map([](int r, int c, double& e)
+                                                { e = r * 1000 + c; });
+        Matrix transpose = matrix.transpose();
+        ASSERT_EQ(transpose.row_size(), n + 7);
+        ASSERT_EQ(transpose.col_size(), n);
+        for (int r = 0; r < n + 7; r++)
+        {
+            for (int c = 0; c < n; c++)
+            {
+                ASSERT_EQ(transpose[r][c], c * 1000 + r);
+            }
+        }
+
+        Matrix square = Matrix(n, n, 0).map([](int r, int c, double& e)
+                                            { e = r * 1000 + c; });
+        Matrix expected = square.transpose();
+        ASSERT_EQ(square.transpose_inplace(), expected);
+        ASSERT_EQ(square.transpose_inplace().transpose_inplace(), expected);
+    }
+
+    MY_ASSERT_THROW_MESSAGE(Matrix(2, 3, 0).transpose_inplace(), std::runtime_error, "Error: The dimensions mismatch.");
 }
 
 // eye()
@@ -263,4 +455,141 @@ TEST(Matrix, dot)
     ASSERT_EQ(dot(Matrix(2, 2, 1), Matrix(2, 2, 2)), Matrix(2, 2, 4));
     ASSERT_EQ(dot(Matrix(1, 3, 1), Matrix(3, 1, 1)), Matrix(1, 1, 3));
     MY_ASSERT_THROW_MESSAGE(dot(Matrix(1, 3, 1), Matrix(1, 3, 1)), std::runtime_error, "Error: The dimensions mismatch.");
+
+    // large enough for the blocked kernel, with partial tiles and several k blocks
+    Matrix a = Matrix(67, 301, 0).map([](int r, int c, double& e)
+                                      { e = (r * 7 + c * 3) % 5 - 2; });
+    Matrix b = Matrix(301, 45, 0).map([](int r, int c, double& e)
+                                      { e = (r + c * 2) % 3 - 1; });
+    Matrix expected(67, 45, 0);
+    for (int r = 0; r < 67; r++)
+    {
+        for (int c = 0; c < 45; c++)
+        {
+            for (int k = 0; k < 301; k++)
+            {
+                expected[r][c] += a[r][k] * b[k][c];
+            }
+        }
+    }
+    ASSERT_EQ(dot(a, b), expected);
+}
+
+// expression templates
+TEST(Matrix, expression)
+{
+    Matrix a = {{1, 2}, {3, 4}};
+    Matrix b = {{1, 1}, {2, 2}};
+
+    // operations on matrices return matrices, with the whole member API
+    static_assert(std::is_same_v<decltype(a + b), Matrix>);
+    static_assert(std::is_same_v<decltype(a * 2), Matrix>);
+    ASSERT_EQ((a + a).transpose(), Matrix({{2, 6}, {4, 8}}));
+    ASSERT_EQ((a * 2).det(), -8);
+    ASSERT_EQ((a - b)[1][0], 1);
+
+    // a lazy() operand makes the chain an expression, evaluated in a single pass
+    static_assert(!std::is_same_v<decltype(lazy(a) + b), Matrix>);
+    static_assert(!std::is_same_v<decltype(lazy(a) * 2), Matrix>);
+    Matrix result = lazy(a) + lazy(b) * 2 - lazy(a) * b;
+    ASSERT_EQ(result, Matrix({{2, 2}, {1, 0}}));
+    ASSERT_EQ(a + b * 2 - a * b, result);
+
+    // operands may alias the destination
+    a = lazy(a) * a - b;
+    ASSERT_EQ(a, Matrix({{0, 3}, {7, 14}}));
+    a += lazy(b) * 3;
+    ASSERT_EQ(a, Matrix({{3, 6}, {13, 20}}));
+    a -= lazy(b) + b;
+    ASSERT_EQ(a, Matrix({{1, 4}, {9, 16}}));
+
+    // assignment reshapes the destination
+    Matrix c;
+    c = lazy(Matrix(2, 3, 1)) * 2 + Matrix(2, 3, 1);
+    ASSERT_EQ(c, Matrix(2, 3, 3));
+
+    // expressions are accepted where a matrix is expected
+    ASSERT_EQ(dot(lazy(b) + b, Matrix::eye(2)), Matrix({{2, 2}, {4, 4}}));
+    ASSERT_EQ(dot({{1, 0}, {0, 1}}, b), b);
+    std::ostringstream os;
+    os << lazy(b) * 2 << b * 2;
+    ASSERT_EQ(os.str(), "[2.000000 2.000000;\n 4.000000 4.000000][2.000000 2.000000;\n 4.000000 4.000000]");
+
+    MY_ASSERT_THROW_MESSAGE(Matrix(2, 3, 1) + Matrix(3, 2, 1), std::runtime_error, "Error: The dimensions mismatch.");
+}
+
+// operator+(Matrix&&) operator-(Matrix&&) operator*(Matrix&&)
+TEST(Matrix, temporary_operands)
+{
+    Matrix a = {{1, 2}, {3, 4}};
+
+    static_assert(std::is_same_v<decltype(Matrix(a) + a), Matrix>);
+    static_assert(std::is_same_v<decltype(lazy(a) * 2 - Matrix(a)), Matrix>);
+    static_assert(std::is_same_v<decltype(2.0 * Matrix(a)), Matrix>);
+    static_assert(std::is_nothrow_move_constructible_v<Matrix>);
+
+    Matrix t = Matrix::eye(2);
+    const double* storage = t.data();
+    Matrix result = (std::move(t) + a) * 2.0 - a;
+    ASSERT_EQ(result.data(), storage);
+    ASSERT_EQ(result, Matrix({{3, 2}, {3, 6}}));
+
+    ASSERT_EQ(a - Matrix::eye(2), Matrix({{0, 2}, {3, 3}}));
+    ASSERT_EQ(Matrix(a) * Matrix(a), Matrix({{1, 4}, {9, 16}}));
+    ASSERT_EQ(0.5 * Matrix(a), Matrix({{0.5, 1}, {1.5, 2}}));
+
+    MY_ASSERT_THROW_MESSAGE(Matrix(2, 3, 1) + Matrix(3, 2, 1), std::runtime_error, "Error: The dimensions mismatch.");
+}
+
+// BasicMatrix<float> BasicMatrix<std::complex<double>>
+TEST(Matrix, scalar_types)
+{
+    using FloatMatrix = BasicMatrix<float>;
+    using ComplexMatrix = BasicMatrix<std::complex<double>>;
+    using namespace std::complex_literals;
+
+    // float
+    FloatMatrix a = {{2, 1}, {1, 3}};
+    ASSERT_EQ(a * 2.0f - a, a);
+    ASSERT_EQ(dot(a, FloatMatrix::eye(2)), a);
+    ASSERT_FLOAT_EQ(a.det(), 5.0f);
+    ASSERT_EQ(a.rank(), 2);
+    ASSERT_EQ(FloatMatrix({{1, 2}, {2, 4}}).rank(), 1);
+    FloatMatrix inverse = a.inv();
+    FloatMatrix identity = dot(a, inverse);
+    for (int r = 0; r < 2; r++)
+    {
+        for (int c = 0; c < 2; c++)
+        {
+            ASSERT_NEAR(identity[r][c], r == c ? 1 : 0, 1e-6);
+        }
+    }
+
+    // float product through the packed kernel, with partial tiles and several k blocks
+    FloatMatrix x = FloatMatrix(17, 301, 0).map([](int r, int c, float& e)
+                                                { e = float((r * 7 + c * 3) % 5 - 2); });
+    FloatMatrix y = FloatMatrix(301, 11, 0).map([](int r, int c, float& e)
+                                                { e = float((r + c * 2) % 3 - 1); });
+    FloatMatrix expected(17, 11, 0);
+    for (int r = 0; r < 17; r++)
+    {
+        for (int c = 0; c < 11; c++)
+        {
+            for (int k = 0; k < 301; k++)
+            {
+                expected[r][c] += x[r][k] * y[k][c];
+            }
+        }
+    }
+    ASSERT_EQ(dot(x, y), expected);
+
+    // complex
+    ComplexMatrix b = {{1i, 0.0}, {0.0, 2.0}};
+    ASSERT_EQ(b * 1i, ComplexMatrix({{-1.0, 0.0}, {0.0, 2i}}));
+    ASSERT_EQ(dot(b, b), ComplexMatrix({{-1.0, 0.0}, {0.0, 4.0}}));
+    ASSERT_EQ(b.det(), 2i);
+    ASSERT_EQ(b.inv(), ComplexMatrix({{-1i, 0.0}, {0.0, 0.5}}));
+    ASSERT_EQ(b.rank(), 2);
+    ASSERT_EQ(ComplexMatrix({{1i, 1.0}, {-1.0, 1i}}).rank(), 1);
+    ASSERT_EQ(b.transpose(), b);
 }
@@ -0,0 +1,136 @@
+#include "../sources/LU.h"
+#include "../sources/MatrixBatch.h"
+
+#include "tool.hpp"
+
+using namespace mla;
+
+// n x n matrices, diagonally dominant except for every seventh which is singular.
+static std::vector<Matrix> make_matrices(int size, int n)
+{
+    std::vector<Matrix> matrices;
+    for (int i = 0; i < size; i++)
+    {
+        Matrix matrix(n, n, 0);
+        for (int r = 0; r < n; r++)
+        {
+            for (int c = 0; c < n; c++)
+            {
+                matrix[r][c] = (r == c ? 2 * n : 0) + ((i + 3 * r + 5 * c) % 7 - 3) * 0.5;
+            }
+        }
+        if (i % 7 == 6)
+        {
+            matrix[n - 1] = matrix[0];
+        }
+        matrices.push_back(matrix);
+    }
+    return matrices;
+}
+
+// constructor size() row_size() col_size() get() set() at()
+TEST(MatrixBatch, basics)
+{
+    // MatrixBatch()
+    MatrixBatch batch1;
+    ASSERT_EQ(batch1.size(), 0);
+    ASSERT_EQ(batch1.row_size(), 0);
+    ASSERT_EQ(batch1.col_size(), 0);
+
+    // MatrixBatch(int size, int row, int col, double element)
+    MatrixBatch batch2(5, 2, 3, 1);
+    ASSERT_EQ(batch2.size(), 5);
+    ASSERT_EQ(batch2.row_size(), 2);
+    ASSERT_EQ(batch2.col_size(), 3);
+    ASSERT_EQ(batch2.get(4), Matrix(2, 3, 1));
+
+    // MatrixBatch(const std::vector<Matrix>& matrices)
+    MatrixBatch batch3({Matrix({{1, 2}, {3, 4}}), Matrix({{5, 6}, {7, 8}})});
+    ASSERT_EQ(batch3.get(1), Matrix({{5, 6}, {7, 8}}));
+
+    // structure-of-arrays layout
+    ASSERT_EQ(batch3.data()[MatrixBatch::LANES + 0], 2);
+    ASSERT_EQ(batch3.data()[MatrixBatch::LANES + 1], 6);
+    ASSERT_EQ(batch3.at(1, 0, 1), 6);
+    batch3.at(1, 1, 0) = 0;
+    ASSERT_EQ(batch3.get(1), Matrix({{5, 6}, {0, 8}}));
+
+    batch3.set(0, Matrix({{0, 0}, {0, 1}}));
+    ASSERT_EQ(batch3.get(0), Matrix({{0, 0}, {0, 1}}));
+    ASSERT_TRUE(batch3 != MatrixBatch(2, 2, 2, 0));
+
+    MY_ASSERT_THROW_MESSAGE(batch3.get(2), std::runtime_error, "Error: Index out of range.");
+    MY_ASSERT_THROW_MESSAGE(batch3.at(0, 2, 0), std::runtime_error, "Error: Index out of range.");
+    MY_ASSERT_THROW_MESSAGE(batch3.set(0, Matrix(2, 3, 0)), std::runtime_error, "Error: The dimensions mismatch.");
+    MY_ASSERT_THROW_MESSAGE(MatrixBatch({Matrix(2, 2, 0), Matrix(3, 3, 0)}), std::runtime_error, "Error: The dimensions mismatch.");
+}
+
+// dot()
+TEST(MatrixBatch, dot)
+{
+    std::vector<Matrix> a = make_matrices(300, 4);
+    std::vector<Matrix> b = make_matrices(300, 4);
+    std::rotate(b.begin(), b.begin() + 1, b.end());
+
+    MatrixBatch product = dot(MatrixBatch(a), MatrixBatch(b));
+    for (int i = 0; i < 300; i++)
+    {
+        ASSERT_EQ(product.get(i), dot(a[i], b[i]));
+    }
+
+    ASSERT_EQ(dot(MatrixBatch(2, 2, 3, 1), MatrixBatch(2, 3, 1, 2)), MatrixBatch(2, 2, 1, 6));
+
+    MY_ASSERT_THROW_MESSAGE(dot(MatrixBatch(2, 2, 3, 1), MatrixBatch(2, 2, 3, 1)), std::runtime_error, "Error: The dimensions mismatch.");
+    MY_ASSERT_THROW_MESSAGE(dot(MatrixBatch(2, 2, 2, 1), MatrixBatch(3, 2, 2, 1)), std::runtime_error, "Error: The dimensions mismatch.");
+}
+
+// det()
+TEST(MatrixBatch, det)
+{
+    for (int n = 1; n <= 8; n++)
+    {
+        std::vector<Matrix> matrices = make_matrices(200, n);
+        Vector det = MatrixBatch(matrices).det();
+        for (int i = 0; i < 200; i++)
+        {
+            ASSERT_NEAR(det[i], matrices[i].det(), 1e-9 * std::abs(matrices[i].det()) + 1e-9);
+        }
+    }
+
+    ASSERT_EQ(MatrixBatch({Matrix({{0, 1}, {1, 0}}), Matrix({{1, 2}, {2, 4}})}).det(), Vector({-1, 0}));
+    ASSERT_EQ(MatrixBatch({Matrix({{1e-20, 0}, {0, 1}})}).det(), Vector({1e-20}));
+
+    MY_ASSERT_THROW_MESSAGE(MatrixBatch(2, 2, 3, 1).det(), std::runtime_error, "Error: The dimensions mismatch.");
+}
+
+// inv() solve()
+TEST(MatrixBatch, solve)
+{
+    for (int n = 1; n <= 8; n++)
+    {
+        std::vector<Matrix> matrices = make_matrices(200, n);
+        for (int i = 6; i < 200; i += 7)
+        {
+            matrices[i][n - 1][n - 1] += 1; // no longer singular
+        }
+
+        MatrixBatch batch(matrices);
+        MatrixBatch inverse = batch.inv();
+        MatrixBatch x = solve(batch, MatrixBatch(200, n, 2, 1));
+        for (int i = 0; i < 200; i++)
+        {
+            // same elimination as LU, but the rounding of the updates may differ
+            Matrix error1 = inverse.get(i) - matrices[i].lu().inverse();
+            Matrix error2 = x.get(i) - matrices[i].lu().solve(Matrix(n, 2, 1));
+            for (int r = 0; r < n; r++)
+            {
+                ASSERT_LT(Vector(error1[r]).length(), 1e-14);
+                ASSERT_LT(Vector(error2[r]).length(), 1e-14);
+            }
+        }
+    }
+
+    MY_ASSERT_THROW_MESSAGE(MatrixBatch(make_matrices(7, 3)).inv(), std::runtime_error, "Error: Singular matrix.");
+    ASSERT_EQ(MatrixBatch({Matrix({{1e-20, 0}, {0, 1}})}).inv().get(0), Matrix({{1e20, 0}, {0, 1}}));
+    MY_ASSERT_THROW_MESSAGE(solve(MatrixBatch(2, 2, 2, 1), MatrixBatch(2, 3, 1, 1)), std::runtime_error, "Error: The dimensions mismatch.");
+}
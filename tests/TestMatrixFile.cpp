@@ -0,0 +1,114 @@
+#include "../sources/MatrixFile.h"
+
+#include "tool.hpp"
+
+#include <complex>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace mla;
+
+// Path of a file in the temporary directory, removed at the end of the test.
+class TempFile
+{
+private:
+    std::string path_;
+
+public:
+    explicit TempFile(const std::string& name)
+        : path_((std::filesystem::temp_directory_path() / name).string())
+    {
+    }
+
+    ~TempFile()
+    {
+        std::remove(path_.c_str());
+    }
+
+    const std::string& path() const
+    {
+        return path_;
+    }
+};
+
+// m x n matrix whose elements are not exact in decimal.
+static Matrix make_matrix(int m, int n)
+{
+    Matrix a(m, n, 0);
+    a.map([](int r, int c, double& e)
+          { e = (r * 7 + c * 3) / 3.0 + 1e-300; });
+    return a;
+}
+
+// save() load()
+TEST(MatrixFile, save_load)
+{
+    TempFile file("mla_save_load.mat");
+
+    // elements are stored exactly
+    Matrix a = make_matrix(37, 29);
+    save(a, file.path());
+    ASSERT_EQ(load(file.path()), a);
+    ASSERT_EQ(std::filesystem::file_size(file.path()), 64 + 37 * 29 * sizeof(double));
+
+    // a block of a matrix is saved without its stride
+    save(ConstMatrixView(a).block(3, 5, 10, 7), file.path());
+    ASSERT_EQ(load(file.path()), Matrix(ConstMatrixView(a).block(3, 5, 10, 7)));
+
+    BasicMatrix<float> f = {{1.5f, 2}, {3, 4.25f}};
+    save(f, file.path());
+    ASSERT_EQ(load<float>(file.path()), f);
+
+    BasicMatrix<std::complex<double>> z = {{{1, 2}, {3, -4}}, {{0, 1.0 / 3}, {5, 0}}};
+    save(z, file.path());
+    ASSERT_EQ(load<std::complex<double>>(file.path()), z);
+
+    save(Matrix(), file.path());
+    ASSERT_EQ(load(file.path()), Matrix());
+}
+
+// MappedMatrix() operator[]() data() view() row_size() col_size()
+TEST(MatrixFile, mapped_matrix)
+{
+    TempFile file("mla_mapped_matrix.mat");
+    Matrix a = make_matrix(100, 33);
+    save(a, file.path());
+
+    MappedMatrix mapped(file.path());
+    ASSERT_EQ(mapped.row_size(), 100);
+    ASSERT_EQ(mapped.col_size(), 33);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(mapped.data()) % ALIGNMENT, 0);
+    ASSERT_EQ(mapped[42][17], a[42][17]);
+    ASSERT_EQ(mapped.view(), a);
+    ASSERT_EQ(dot(mapped.view(), Matrix(33, 2, 1)), dot(a, Matrix(33, 2, 1)));
+
+    // the mapping moves with the object
+    MappedMatrix moved = std::move(mapped);
+    ASSERT_EQ(mapped.row_size(), 0);
+    ASSERT_EQ(mapped.data(), nullptr);
+    ASSERT_EQ(Matrix(moved.view()), a);
+    moved = MappedMatrix();
+    ASSERT_EQ(moved.data(), nullptr);
+}
+
+// exceptions of load() and MappedMatrix()
+TEST(MatrixFile, exception)
+{
+    TempFile file("mla_exception.mat");
+
+    MY_ASSERT_THROW_MESSAGE(load(file.path()), std::runtime_error, "Error: Failed to open the matrix file.");
+    MY_ASSERT_THROW_MESSAGE(MappedMatrix(file.path()), std::runtime_error, "Error: Failed to open the matrix file.");
+
+    std::ofstream(file.path()) << "1 2 3\n";
+    MY_ASSERT_THROW_MESSAGE(load(file.path()), std::runtime_error, "Error: Not a matrix file.");
+    MY_ASSERT_THROW_MESSAGE(MappedMatrix(file.path()), std::runtime_error, "Error: Not a matrix file.");
+
+    save(Matrix(4, 4, 1), file.path());
+    MY_ASSERT_THROW_MESSAGE(load<float>(file.path()), std::runtime_error, "Error: The matrix file has another element type.");
+    MY_ASSERT_THROW_MESSAGE(BasicMappedMatrix<float>(file.path()), std::runtime_error, "Error: The matrix file has another element type.");
+
+    std::filesystem::resize_file(file.path(), 64 + 15 * sizeof(double));
+    MY_ASSERT_THROW_MESSAGE(load(file.path()), std::runtime_error, "Error: The matrix file is truncated.");
+    MY_ASSERT_THROW_MESSAGE(MappedMatrix(file.path()), std::runtime_error, "Error: The matrix file is truncated.");
+}
@@ -0,0 +1,115 @@
+#include "../sources/MatrixText.h"
+
+#include "tool.hpp"
+
+#include <sstream>
+
+using namespace mla;
+
+// m x n matrix whose elements are not exact in decimal.
+static Matrix make_matrix(int m, int n)
+{
+    Matrix a(m, n, 0);
+    a.map([](int r, int c, double& e)
+          { e = (r * 7 - c * 3) / 3.0 + (r == c ? 1e-300 : 0); });
+    return a;
+}
+
+// Read a matrix from CSV text.
+template <typename T = double>
+static BasicMatrix<T> csv(const std::string& text, char delimiter = ',')
+{
+    std::istringstream is(text);
+    return read_csv<T>(is, delimiter);
+}
+
+// Read a matrix from Matrix Market text.
+template <typename T = double>
+static BasicMatrix<T> matrix_market(const std::string& text)
+{
+    std::istringstream is(text);
+    return read_matrix_market<T>(is);
+}
+
+// write_csv() read_csv()
+TEST(MatrixText, csv)
+{
+    std::ostringstream oss;
+    write_csv(oss, Matrix({{1, 0.5}, {-3, 1e300}}));
+    ASSERT_EQ(oss.str(), "1,0.5\n-3,1e+300\n");
+
+    // shortest output reads back exactly
+    Matrix a = make_matrix(40, 30);
+    std::stringstream ss;
+    write_csv(ss, a);
+    ASSERT_EQ(read_csv(ss), a);
+
+    std::stringstream view;
+    write_csv(view, ConstMatrixView(a).block(5, 3, 4, 6), ';');
+    ASSERT_EQ(read_csv(view, ';'), Matrix(ConstMatrixView(a).block(5, 3, 4, 6)));
+
+    BasicMatrix<float> f = {{0.1f, 1.0f / 3}};
+    std::stringstream fs;
+    write_csv(fs, f);
+    ASSERT_EQ(fs.str(), "0.1,0.33333334\n");
+    ASSERT_EQ(read_csv<float>(fs), f);
+
+    // blanks, a leading '+', carriage returns and blank lines are accepted
+    ASSERT_EQ(csv(" 1 , +2.5,3e2\r\n\n4,5 ,  6\n"), Matrix({{1, 2.5, 300}, {4, 5, 6}}));
+    ASSERT_EQ(csv("1 2\t 3\n4  5 6\n", ' '), Matrix({{1, 2, 3}, {4, 5, 6}}));
+    ASSERT_EQ(csv(""), Matrix());
+
+    MY_ASSERT_THROW_MESSAGE(csv("1,2\n3\n"), std::runtime_error, "Error: The dimensions mismatch.");
+    MY_ASSERT_THROW_MESSAGE(csv("1,x\n"), std::runtime_error, "Error: Invalid CSV data.");
+    MY_ASSERT_THROW_MESSAGE(csv("1,2,\n"), std::runtime_error, "Error: Invalid CSV data.");
+}
+
+// write_matrix_market() read_matrix_market()
+TEST(MatrixText, matrix_market)
+{
+    std::ostringstream oss;
+    write_matrix_market(oss, Matrix({{1, 2}, {3, 4}, {5, 6}}));
+    ASSERT_EQ(oss.str(), "%%MatrixMarket matrix array real general\n3 2\n1\n3\n5\n2\n4\n6\n");
+
+    Matrix a = make_matrix(20, 35);
+    std::stringstream ss;
+    write_matrix_market(ss, a);
+    ASSERT_EQ(read_matrix_market(ss), a);
+
+    // comments, symmetric array
+    ASSERT_EQ(matrix_market("%%MatrixMarket matrix array real symmetric\n% comment\n3 3\n1\n2\n3\n4\n5\n6\n"), Matrix({{1, 2, 3}, {2, 4, 5}, {3, 5, 6}}));
+    ASSERT_EQ(matrix_market("%%MatrixMarket matrix array real skew-symmetric\n3 3\n1 2\n3\n"), Matrix({{0, -1, -2}, {1, 0, -3}, {2, 3, 0}}));
+
+    // coordinate into a dense matrix, pattern and integer fields
+    ASSERT_EQ(matrix_market("%%MatrixMarket matrix coordinate real general\n2 3 2\n1 3 1.5\n2 1 -2\n"), Matrix({{0, 0, 1.5}, {-2, 0, 0}}));
+    ASSERT_EQ(matrix_market<float>("%%MatrixMarket matrix coordinate pattern symmetric\n2 2 2\n1 1\n2 1\n"), BasicMatrix<float>({{1, 1}, {1, 0}}));
+    ASSERT_EQ(matrix_market("%%MATRIXMARKET MATRIX ARRAY INTEGER GENERAL\r\n1 2\r\n7\r\n-8\r\n"), Matrix({{7, -8}}));
+
+    MY_ASSERT_THROW_MESSAGE(matrix_market("1,2\n"), std::runtime_error, "Error: Not a Matrix Market file.");
+    MY_ASSERT_THROW_MESSAGE(matrix_market("%%MatrixMarket matrix coordinate complex general\n1 1 1\n1 1 1 2\n"), std::runtime_error, "Error: Unsupported Matrix Market format.");
+    MY_ASSERT_THROW_MESSAGE(matrix_market("%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n"), std::runtime_error, "Error: The Matrix Market data is truncated.");
+    MY_ASSERT_THROW_MESSAGE(matrix_market("%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1\n"), std::runtime_error, "Error: Index out of range.");
+}
+
+// write_matrix_market(const SparseMatrix&) read_sparse_matrix_market()
+TEST(MatrixText, sparse_matrix_market)
+{
+    SparseMatrix a(3, 4, {{0, 1, 2}, {1, 0, 1.0 / 3}, {2, 3, -4}});
+    std::stringstream ss;
+    write_matrix_market(ss, a);
+    ASSERT_EQ(ss.str(), "%%MatrixMarket matrix coordinate real general\n3 4 3\n1 2 2\n2 1 0.3333333333333333\n3 4 -4\n");
+    ASSERT_EQ(read_sparse_matrix_market(ss), a);
+
+    std::istringstream symmetric("%%MatrixMarket matrix coordinate real symmetric\n3 3 2\n2 1 5\n3 3 1\n");
+    ASSERT_EQ(read_sparse_matrix_market(symmetric), SparseMatrix(Matrix({{0, 5, 0}, {5, 0, 0}, {0, 0, 1}})));
+}
+
+// operator<<() streams the same text as to_string()
+TEST(MatrixText, to_string)
+{
+    Matrix a = make_matrix(300, 200);
+    std::ostringstream oss;
+    oss << a;
+    ASSERT_EQ(oss.str(), a.to_string());
+    ASSERT_EQ(Matrix({{1e300, -0.5}}).to_string(), "[" + std::to_string(1e300) + " -0.500000]");
+}
@@ -0,0 +1,219 @@
+#include "../sources/LU.h"
+#include "../sources/MatrixView.h"
+#include "../sources/parallel.h"
+
+#include "tool.hpp"
+
+using namespace mla;
+
+// constructor row_size() col_size() stride() data()
+TEST(MatrixView, basics)
+{
+    Matrix matrix = {{1, 2, 3}, {4, 5, 6}};
+
+    // BasicMatrixView(Matrix& matrix)
+    MatrixView view1 = matrix;
+    ASSERT_EQ(view1.row_size(), 2);
+    ASSERT_EQ(view1.col_size(), 3);
+    ASSERT_EQ(view1.stride(), 3);
+    ASSERT_EQ(view1.data(), matrix.data());
+
+    // BasicMatrixView(const Matrix& matrix)
+    const Matrix& cref = matrix;
+    ConstMatrixView view2 = cref;
+    ASSERT_EQ(view2.data(), matrix.data());
+
+    // BasicMatrixView(const BasicMatrixView<double>& that)
+    ConstMatrixView view3 = view1;
+    ASSERT_EQ(view3.data(), matrix.data());
+
+    // Matrix(ConstMatrixView view)
+    ASSERT_EQ(Matrix(view3), matrix);
+    ASSERT_EQ(Matrix(matrix.block(1, 1, 0, 2)), Matrix());
+}
+
+// block() split_row() split_col()
+TEST(MatrixView, block)
+{
+    Matrix matrix = {{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}};
+
+    MatrixView block = matrix.block(1, 1, 2, 2);
+    ASSERT_EQ(block.stride(), 4);
+    ASSERT_EQ(Matrix(block), Matrix({{6, 7}, {10, 11}}));
+    ASSERT_EQ(Matrix(block.block(1, 0, 1, 2)), Matrix({{10, 11}}));
+
+    auto [top, bottom] = matrix.view().split_row(1);
+    ASSERT_EQ(Matrix(top), Matrix({{1, 2, 3, 4}}));
+    ASSERT_EQ(Matrix(bottom), Matrix({{5, 6, 7, 8}, {9, 10, 11, 12}}));
+
+    auto [left, right] = matrix.view().split_col(3);
+    ASSERT_EQ(Matrix(left), Matrix({{1, 2, 3}, {5, 6, 7}, {9, 10, 11}}));
+    ASSERT_EQ(Matrix(right), Matrix({{4}, {8}, {12}}));
+
+    // same elements as the copying split
+    ASSERT_EQ(Matrix(left), matrix.split_col(3).first);
+    ASSERT_EQ(Matrix(right), matrix.split_col(3).second);
+
+    MY_ASSERT_THROW_MESSAGE(matrix.block(4, 0, 0, 0), std::runtime_error, "Error: Index out of range.");
+    MY_ASSERT_THROW_MESSAGE(matrix.block(1, 1, 3, 1), std::runtime_error, "Error: Index out of range.");
+    MY_ASSERT_THROW_MESSAGE(matrix.view().split_col(5), std::runtime_error, "Error: Index out of range.");
+}
+
+// operator[]() at() begin() end() operator=()
+TEST(MatrixView, access)
+{
+    Matrix matrix = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    MatrixView block = matrix.block(1, 1, 2, 2);
+
+    // rows are strided views into the matrix
+    ASSERT_EQ(Vector(block[0]), Vector({5, 6}));
+    ASSERT_EQ(Vector(block.at(1)), Vector({8, 9}));
+    block[1][0] = 0;
+    ASSERT_EQ(matrix[2][1], 0);
+
+    std::vector<Vector> rows;
+    for (const auto& row : block)
+    {
+        rows.push_back(row);
+    }
+    ASSERT_EQ(rows, std::vector<Vector>({{5, 6}, {0, 9}}));
+
+    // assignment writes through
+    block = Matrix({{-1, -2}, {-3, -4}});
+    ASSERT_EQ(matrix, Matrix({{1, 2, 3}, {4, -1, -2}, {7, -3, -4}}));
+    matrix.block(0, 0, 1, 2) = matrix.block(2, 1, 1, 2);
+    ASSERT_EQ(matrix, Matrix({{-3, -4, 3}, {4, -1, -2}, {7, -3, -4}}));
+
+    MY_ASSERT_THROW_MESSAGE(block.at(2), std::runtime_error, "Error: Index out of range.");
+    MY_ASSERT_THROW_MESSAGE(block = Matrix(1, 2, 0), std::runtime_error, "Error: The dimensions mismatch.");
+}
+
+// operator==() operator!=()
+TEST(MatrixView, compare)
+{
+    Matrix matrix = {{1, 2, 1}, {2, 1, 2}};
+
+    ASSERT_TRUE(matrix.block(0, 0, 1, 2) == Matrix({{1, 2}}));
+    ASSERT_TRUE(matrix.block(0, 0, 2, 1) == matrix.block(0, 2, 2, 1));
+    ASSERT_TRUE(matrix.block(0, 0, 1, 2) != matrix.block(0, 1, 1, 2));
+    ASSERT_TRUE(matrix.block(0, 0, 1, 2) != matrix.block(0, 0, 2, 2));
+}
+
+// operator+=() operator-=() operator*=()
+TEST(MatrixView, manipulation)
+{
+    Matrix matrix(3, 4, 1);
+    MatrixView block = matrix.block(1, 2, 2, 2);
+
+    block += Matrix({{1, 2}, {3, 4}});
+    ASSERT_EQ(matrix, Matrix({{1, 1, 1, 1}, {1, 1, 2, 3}, {1, 1, 4, 5}}));
+
+    block -= matrix.block(1, 0, 2, 2);
+    ASSERT_EQ(matrix, Matrix({{1, 1, 1, 1}, {1, 1, 1, 2}, {1, 1, 3, 4}}));
+
+    block *= 2;
+    ASSERT_EQ(matrix, Matrix({{1, 1, 1, 1}, {1, 1, 2, 4}, {1, 1, 6, 8}}));
+
+    MY_ASSERT_THROW_MESSAGE(block += matrix, std::runtime_error, "Error: The dimensions mismatch.");
+}
+
+// dot() LU
+TEST(MatrixView, dot)
+{
+    Matrix matrix = {{1, 2, 3}, {4, 5, 6}, {7, 8, 10}};
+
+    ASSERT_EQ(dot(matrix.block(0, 0, 2, 2), matrix.block(1, 1, 2, 1)), Matrix({{1 * 5 + 2 * 8}, {4 * 5 + 5 * 8}}));
+    ASSERT_EQ(dot(matrix.view().split_col(1).second, Matrix({{1}, {1}})), Matrix({{5}, {11}, {18}}));
+
+    // larger than a gemm block, with a stride different from the width
+    Matrix big(300, 300, 0);
+    big.map([](int r, int c, double& e)
+            { e = (r * 7 + c * 3) % 11 - 5; });
+    Matrix a(big.block(3, 5, 200, 150));
+    Matrix b(big.block(7, 2, 150, 170));
+    ASSERT_EQ(dot(big.block(3, 5, 200, 150), big.block(7, 2, 150, 170)), dot(a, b));
+
+    // factorize a block without copying it first
+    ASSERT_DOUBLE_EQ(LU(matrix.block(1, 1, 2, 2)).det(), 5 * 10 - 6 * 8);
+
+    MY_ASSERT_THROW_MESSAGE(dot(matrix.block(0, 0, 2, 2), matrix), std::runtime_error, "Error: The dimensions mismatch.");
+}
+
+// operator+() operator-() operator*() lazy()
+TEST(MatrixView, arithmetic)
+{
+    Matrix matrix = {{1, 2, 3}, {4, 5, 6}, {7, 8, 10}};
+    ConstMatrixView left = matrix.block(0, 0, 2, 2);
+    ConstMatrixView right = matrix.block(1, 1, 2, 2);
+
+    ASSERT_EQ(left + right, Matrix({{6, 8}, {12, 15}}));
+    ASSERT_EQ(left - Matrix({{1, 1}, {1, 1}}), Matrix({{0, 1}, {3, 4}}));
+    ASSERT_EQ(Matrix({{1, 1}, {1, 1}}) - right, Matrix({{-4, -5}, {-7, -9}}));
+    ASSERT_EQ(left * right, Matrix({{5, 12}, {32, 50}}));
+    ASSERT_EQ(right * 2, Matrix({{10, 12}, {16, 20}}));
+    ASSERT_EQ(2 * matrix.view().split_row(2).second, Matrix({{14, 16, 20}}));
+    ASSERT_EQ((left + right).det(), 6 * 15 - 8 * 12);
+
+    // fused into one pass over the blocks
+    Matrix fused = lazy(left) + lazy(right) * 2 - lazy(matrix.block(0, 1, 2, 2));
+    ASSERT_EQ(fused, Matrix({{9, 11}, {15, 19}}));
+
+    Vector row = lazy(matrix[0]) + lazy(matrix[1]);
+    ASSERT_EQ(row, Vector({5, 7, 9}));
+
+    // an operand viewing other elements of the destination is read before they are overwritten, on any number of threads
+    const int original = num_threads();
+    set_num_threads(8);
+    Matrix big(1000, 1000, 0);
+    big.map([](int r, int c, double& e)
+            { e = r * 1000 + c; });
+    const Matrix expected = Matrix(big.block(0, 0, 800, 800)) * 2;
+    big = lazy(big.block(0, 0, 800, 800)) * 2;
+    ASSERT_EQ(big, expected);
+    Vector shifted(100000, 0);
+    for (int i = 0; i < shifted.size(); i++)
+    {
+        shifted[i] = i;
+    }
+    shifted = lazy(VectorView(shifted.data() + 1, 99999)) + lazy(ConstVectorView(shifted.data(), 99999));
+    ASSERT_EQ(shifted[0], 1);
+    ASSERT_EQ(shifted[99998], 99999 + 99998);
+    set_num_threads(original);
+
+    MY_ASSERT_THROW_MESSAGE(left + matrix, std::runtime_error, "Error: The dimensions mismatch.");
+}
+
+// transpose() rank() map() for_each()
+TEST(MatrixView, production)
+{
+    Matrix matrix = {{1, 2, 3}, {2, 4, 6}, {7, 8, 10}};
+
+    ASSERT_EQ(matrix.block(0, 1, 3, 2).transpose(), Matrix({{2, 4, 8}, {3, 6, 10}}));
+    ASSERT_EQ(matrix.block(0, 0, 2, 3).rank(), 1);
+    ASSERT_EQ(matrix.block(1, 0, 2, 3).rank(), 2);
+    ASSERT_EQ(matrix.block(1, 0, 2, 3).rank(100), 0);
+
+    // larger than a tile, with a stride different from the width
+    Matrix big(300, 300, 0);
+    big.map([](int r, int c, double& e)
+            { e = r * 300 + c; });
+    ASSERT_EQ(big.block(3, 5, 70, 90).transpose(), Matrix(big.block(3, 5, 70, 90)).transpose());
+
+    matrix.block(1, 1, 2, 2).map([](int r, int c, double& e)
+                                 { e = r * 10 + c; });
+    ASSERT_EQ(matrix, Matrix({{1, 2, 3}, {2, 0, 1}, {7, 10, 11}}));
+
+    matrix.view().split_col(2).second.map([](double& e)
+                                          { e = -e; });
+    ASSERT_EQ(matrix, Matrix({{1, 2, -3}, {2, 0, -1}, {7, 10, -11}}));
+
+    double sum = 0;
+    matrix.block(0, 0, 2, 2).for_each([&sum](const double& e)
+                                      { sum += e; });
+    ASSERT_EQ(sum, 1 + 2 + 2 + 0);
+
+    std::vector<int> order;
+    matrix.block(1, 1, 2, 2).for_each([&order](int r, int c, const double&)
+                                      { order.push_back(r * 10 + c); });
+    ASSERT_EQ(order, std::vector<int>({0, 1, 10, 11}));
+}
@@ -0,0 +1,92 @@
+#include "../sources/Matrix.h"
+#include "../sources/parallel.h"
+
+#include "tool.hpp"
+
+#include <atomic>
+#include <vector>
+
+using namespace mla;
+
+// set_num_threads() num_threads()
+TEST(Parallel, num_threads)
+{
+    const int original = num_threads();
+
+    set_num_threads(3);
+    ASSERT_EQ(num_threads(), 3);
+
+    set_num_threads(0);
+    ASSERT_GE(num_threads(), 1);
+
+    set_num_threads(original);
+}
+
+// parallel_for()
+TEST(Parallel, parallel_for)
+{
+    const int original = num_threads();
+    set_num_threads(4);
+
+    // every index is visited exactly once
+    std::vector<int> visits(1000, 0);
+    kernel::parallel_for(0, 1000, 10, [&](int begin, int end)
+                         {
+        for (int i = begin; i < end; i++)
+        {
+            visits[i]++;
+        } });
+    for (int v : visits)
+    {
+        ASSERT_EQ(v, 1);
+    }
+
+    // small and empty ranges
+    std::atomic<int> calls(0);
+    kernel::parallel_for(0, 5, 10, [&](int begin, int end)
+                         { calls++; ASSERT_EQ(begin, 0); ASSERT_EQ(end, 5); });
+    kernel::parallel_for(0, 0, 10, [&](int, int)
+                         { calls++; });
+    ASSERT_EQ(calls, 1);
+
+    // nested calls run serially instead of deadlocking
+    std::atomic<int> total(0);
+    kernel::parallel_for(0, 8, 1, [&](int begin, int end)
+                         { kernel::parallel_for(begin * 100, end * 100, 1, [&](int b, int e)
+                                                { total += e - b; }); });
+    ASSERT_EQ(total, 800);
+
+    // exceptions are passed to the caller
+    MY_ASSERT_THROW_MESSAGE(kernel::parallel_for(0, 100, 1, [](int begin, int)
+                                                 { if (begin >= 50) throw std::runtime_error("Error: Test."); }),
+                            std::runtime_error, "Error: Test.");
+
+    set_num_threads(original);
+}
+
+// parallel and serial results agree
+TEST(Parallel, matrix)
+{
+    const int original = num_threads();
+
+    Matrix a = Matrix(300, 257, 0).map([](int r, int c, double& e)
+                                       { e = (r * 3 + c * 5) % 11 - 5; });
+    Matrix b = Matrix(257, 301, 0).map([](int r, int c, double& e)
+                                       { e = (r * 7 + c) % 13 - 6; });
+
+    set_num_threads(1);
+    Matrix product = dot(a, b);
+    Matrix transposed = a.transpose();
+    Matrix sum = a + a * 2 - a * a;
+
+    set_num_threads(4);
+    ASSERT_EQ(dot(a, b), product);
+    ASSERT_EQ(a.transpose(), transposed);
+    ASSERT_EQ(a + a * 2 - a * a, sum);
+    ASSERT_EQ(Matrix(300, 257, 0).map([](int r, int c, double& e)
+                                      { e = (r * 3 + c * 5) % 11 - 5; },
+                                      true),
+              a);
+
+    set_num_threads(original);
+}
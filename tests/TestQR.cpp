@@ -0,0 +1,97 @@
+#include "../sources/QR.h"
+
+#include "tool.hpp"
+
+using namespace mla;
+
+// m x n matrix with full column rank.
+static Matrix make_tall(int m, int n)
+{
+    Matrix a(m, n, 0);
+    a.map([](int r, int c, double& e)
+          { e = (r * 7 + c * 3) % 11 - 5 + (r == c ? 20 : 0); });
+    return a;
+}
+
+// Largest absolute difference of the elements of two matrices of the same shape.
+static double max_error(const Matrix& a, const Matrix& b)
+{
+    double error = 0;
+    for (int i = 0; i < a.row_size(); i++)
+    {
+        for (int j = 0; j < a.col_size(); j++)
+        {
+            error = std::max(error, std::abs(a[i][j] - b[i][j]));
+        }
+    }
+    return error;
+}
+
+// QR() row_size() col_size() is_rank_deficient() r() q()
+TEST(QR, basics)
+{
+    QR qr = Matrix({{3, 0}, {4, 5}, {0, 0}}).qr();
+    ASSERT_EQ(qr.row_size(), 3);
+    ASSERT_EQ(qr.col_size(), 2);
+    ASSERT_FALSE(qr.is_rank_deficient());
+    MY_ASSERT_MATRIX_DOUBLE_EQ(qr.r(), Matrix({{-5, -4}, {0, 3}}));
+    MY_ASSERT_MATRIX_DOUBLE_EQ(qr.q(), Matrix({{-0.6, -0.8}, {-0.8, 0.6}, {0, 0}}));
+
+    // A = QR and Q^T Q = I across several blocks of reflectors
+    for (int n : {1, 31, 32, 33, 100})
+    {
+        Matrix a = make_tall(250, n);
+        QR big = a.qr();
+        Matrix q = big.q();
+        ASSERT_LT(max_error(dot(q, big.r()), a), 1e-12);
+        ASSERT_LT(max_error(dot(q.transpose(), q), Matrix::eye(n)), 1e-13);
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < i; j++)
+            {
+                ASSERT_EQ(big.r()[i][j], 0);
+            }
+        }
+    }
+
+    ASSERT_TRUE(Matrix({{1, 2}, {2, 4}, {3, 6}}).qr().is_rank_deficient());
+    ASSERT_TRUE(Matrix(3, 2, 0).qr().is_rank_deficient());
+
+    MY_ASSERT_THROW_MESSAGE(Matrix({{1, 2, 3}, {4, 5, 6}}).qr(), std::runtime_error, "Error: The dimensions mismatch.");
+}
+
+// solve() lstsq()
+TEST(QR, solve)
+{
+    // exact fit of a line through (0, 1) (1, 3) (2, 5)
+    Vector x = lstsq(Matrix({{1, 0}, {1, 1}, {1, 2}}), Vector({1, 3, 5}));
+    ASSERT_DOUBLE_EQ(x[0], 1);
+    ASSERT_DOUBLE_EQ(x[1], 2);
+
+    // best fit, the residual is orthogonal to the columns
+    Matrix a = make_tall(300, 40);
+    Matrix b(300, 3, 0);
+    b.map([](int r, int c, double& e)
+          { e = (r * 5 + c) % 13 - 6; });
+    Matrix solution = lstsq(a, b);
+    ASSERT_EQ(solution.row_size(), 40);
+    ASSERT_EQ(solution.col_size(), 3);
+    Matrix residual = b - dot(a, solution);
+    ASSERT_LT(max_error(dot(a.transpose(), residual), Matrix(40, 3, 0)), 1e-10);
+
+    // the same as the normal equations on a well conditioned problem
+    ASSERT_LT(max_error(solution, dot(dot(a.transpose(), a).inv(), dot(a.transpose(), b))), 1e-12);
+
+    // square systems are solved exactly
+    Matrix square = {{4, -2, 1}, {-2, 4, -2}, {1, -2, 4}};
+    Vector y = square.qr().solve(Vector({11, -16, 17}));
+    ASSERT_NEAR(y[0], 1, 1e-14);
+    ASSERT_NEAR(y[1], -2, 1e-14);
+    ASSERT_NEAR(y[2], 3, 1e-14);
+
+    // views of a block
+    ASSERT_EQ(lstsq(a.block(0, 0, 300, 20), b), lstsq(Matrix(a.block(0, 0, 300, 20)), b));
+
+    MY_ASSERT_THROW_MESSAGE(lstsq(Matrix({{1, 2}, {2, 4}, {3, 6}}), Vector({1, 2, 3})), std::runtime_error, "Error: Rank deficient matrix.");
+    MY_ASSERT_THROW_MESSAGE(lstsq(a, Vector({1, 2})), std::runtime_error, "Error: The dimensions mismatch.");
+}
@@ -0,0 +1,99 @@
+#include "../sources/SparseMatrix.h"
+
+#include "tool.hpp"
+
+using namespace mla;
+
+// constructor row_size() col_size() nonzero_size() at()
+TEST(SparseMatrix, basics)
+{
+    // SparseMatrix()
+    SparseMatrix matrix1;
+    ASSERT_EQ(matrix1.row_size(), 0);
+    ASSERT_EQ(matrix1.col_size(), 0);
+    ASSERT_EQ(matrix1.nonzero_size(), 0);
+
+    // SparseMatrix(int rows, int cols)
+    SparseMatrix matrix2(2, 3);
+    ASSERT_EQ(matrix2.row_size(), 2);
+    ASSERT_EQ(matrix2.col_size(), 3);
+    ASSERT_EQ(matrix2.nonzero_size(), 0);
+    ASSERT_EQ(matrix2.to_dense(), Matrix(2, 3, 0));
+
+    // SparseMatrix(int rows, int cols, const std::vector<Triplet>& triplets)
+    SparseMatrix matrix3(3, 4, {{2, 1, 5}, {0, 3, 1}, {0, 0, 2}, {2, 1, 1}, {1, 2, 4}, {1, 2, -4}});
+    ASSERT_EQ(matrix3.nonzero_size(), 3);
+    ASSERT_EQ(matrix3.offsets(), std::vector<int>({0, 2, 2, 3}));
+    ASSERT_EQ(matrix3.indices(), std::vector<int>({0, 3, 1}));
+    ASSERT_EQ(matrix3.values(), std::vector<double>({2, 1, 6}));
+    ASSERT_EQ(matrix3.at(2, 1), 6);
+    ASSERT_EQ(matrix3.at(1, 2), 0);
+    ASSERT_EQ(matrix3.to_dense(), Matrix({{2, 0, 0, 1}, {0, 0, 0, 0}, {0, 6, 0, 0}}));
+
+    // SparseMatrix(const Matrix& matrix)
+    ASSERT_EQ(SparseMatrix(matrix3.to_dense()), matrix3);
+
+    MY_ASSERT_THROW_MESSAGE(SparseMatrix(2, 2, {{2, 0, 1}}), std::runtime_error, "Error: Index out of range.");
+    MY_ASSERT_THROW_MESSAGE(matrix3.at(0, 4), std::runtime_error, "Error: Index out of range.");
+}
+
+// to_string() operator*=() transpose()
+TEST(SparseMatrix, production)
+{
+    SparseMatrix matrix(2, 3, {{0, 1, 2}, {1, 0, 3}, {1, 2, 4}});
+
+    ASSERT_EQ(matrix.to_string(), "[(0, 1) 2.000000;\n (1, 0) 3.000000;\n (1, 2) 4.000000]");
+    ASSERT_EQ(SparseMatrix().to_string(), "[]");
+
+    matrix *= 2;
+    ASSERT_EQ(matrix.to_dense(), Matrix({{0, 4, 0}, {6, 0, 8}}));
+
+    SparseMatrix transpose = matrix.transpose();
+    ASSERT_EQ(transpose.to_dense(), matrix.to_dense().transpose());
+    ASSERT_EQ(transpose.indices(), std::vector<int>({1, 0, 1}));
+    ASSERT_EQ(transpose.transpose(), matrix);
+
+    SparseMatrix tiny(2, 2, {{0, 0, 1e-300}, {1, 1, 1}});
+    tiny *= 1e-300;
+    ASSERT_EQ(tiny.nonzero_size(), 1);
+    ASSERT_EQ(tiny.offsets(), std::vector<int>({0, 0, 1}));
+
+    matrix *= 0;
+    ASSERT_EQ(matrix.nonzero_size(), 0);
+    ASSERT_EQ(matrix, SparseMatrix(2, 3));
+}
+
+// dot()
+TEST(SparseMatrix, dot)
+{
+    SparseMatrix matrix(3, 4, {{0, 0, 2}, {0, 3, 1}, {2, 1, 6}});
+
+    ASSERT_EQ(dot(matrix, Vector({1, 2, 3, 4})), Vector({6, 0, 12}));
+    ASSERT_EQ(dot(matrix, Matrix({{1, 0}, {0, 1}, {1, 1}, {2, 3}})), Matrix({{4, 3}, {0, 0}, {0, 6}}));
+
+    // large enough to run on several threads, against a view with a stride different from the width
+    const int n = 2000;
+    std::vector<Triplet> triplets;
+    for (int i = 0; i < n; i++)
+    {
+        triplets.push_back({i, i, 4});
+        triplets.push_back({i, (i * 7 + 3) % n, -1});
+        triplets.push_back({(i * 13 + 5) % n, i, 0.5});
+    }
+    SparseMatrix big(n, n, triplets);
+    Matrix dense = big.to_dense();
+    Matrix b(n, 40, 0);
+    b.map([](int r, int c, double& e)
+          { e = (r * 3 + c * 5) % 7 - 3; });
+
+    Vector x(n, 0);
+    for (int i = 0; i < n; i++)
+    {
+        x[i] = i % 5 - 2;
+    }
+    ASSERT_EQ(dot(big, x), Vector(dot(dense, Matrix({x}).transpose()).transpose()[0]));
+    ASSERT_EQ(dot(big, b.block(0, 3, n, 30)), dot(dense, Matrix(b.block(0, 3, n, 30))));
+
+    MY_ASSERT_THROW_MESSAGE(dot(matrix, Vector({1, 2, 3})), std::runtime_error, "Error: The dimensions mismatch.");
+    MY_ASSERT_THROW_MESSAGE(dot(matrix, Matrix(3, 1, 0)), std::runtime_error, "Error: The dimensions mismatch.");
+}
@@ -0,0 +1,104 @@
+#include "../sources/Vec.h"
+
+#include "tool.hpp"
+
+using namespace mla;
+
+// Everything below except length() and the conversions is evaluated at compile time.
+static_assert(Vec<3>(1, 2, 3) + Vec<3>(4, 5, 6) == Vec<3>(5, 7, 9));
+static_assert(dot(Vec<3>(1, 2, 3), Vec<3>(4, 5, 6)) == 32);
+static_assert(cross(Vec<3>(1, 2, 3), Vec<3>(4, 5, 6)) == Vec<3>(-3, 6, -3));
+static_assert(Vec<4>().is_zero());
+static_assert(Vec<2>::size() == 2);
+
+// constructor size() operator==() operator!=()
+TEST(Vec, basics)
+{
+    // Vec()
+    Vec<3> vec1;
+    ASSERT_EQ(vec1.size(), 3);
+    ASSERT_TRUE(vec1.is_zero());
+
+    // Vec(Ts... elements)
+    Vec<3> vec2 = {1, 2, 3};
+    ASSERT_FALSE(vec2.is_zero());
+    ASSERT_EQ(vec2, Vec<3>(1, 2.0, 3.0f));
+    ASSERT_NE(vec1, vec2);
+
+    // layout
+    static_assert(sizeof(Vec<4>) == 4 * sizeof(double));
+}
+
+// operator[]() data() begin() end()
+TEST(Vec, access)
+{
+    Vec<3> vec = {1, 2, 3};
+    for (int i = 0; i < vec.size(); i++)
+    {
+        ASSERT_EQ(vec[i], i + 1);
+    }
+
+    vec[0] = 0;
+    ASSERT_EQ(vec.data()[0], 0);
+
+    double sum = 0;
+    for (double e : vec)
+    {
+        sum += e;
+    }
+    ASSERT_EQ(sum, 5);
+
+#ifndef MLA_NO_BOUNDS_CHECK
+    MY_ASSERT_THROW_MESSAGE(vec[3], std::runtime_error, "Error: Index out of range.");
+#endif
+}
+
+// Vec(const Vector& vector) operator Vector()
+TEST(Vec, convert)
+{
+    Vec<3> vec(Vector({1, 2, 3}));
+    ASSERT_EQ(vec, Vec<3>(1, 2, 3));
+
+    Vector vector = vec;
+    ASSERT_EQ(vector, Vector({1, 2, 3}));
+
+    MY_ASSERT_THROW_MESSAGE(Vec<3>(Vector({1, 2})), std::runtime_error, "Error: The dimensions mismatch.");
+}
+
+// length() operator+=() operator-=() operator*=() operator+() operator-() operator*()
+TEST(Vec, arithmetic)
+{
+    ASSERT_EQ(Vec<2>(3, 4).length(), 5);
+
+    Vec<3> vec = {1, 2, 3};
+    vec += Vec<3>(1, 1, 1);
+    ASSERT_EQ(vec, Vec<3>(2, 3, 4));
+    vec -= Vec<3>(2, 2, 2);
+    ASSERT_EQ(vec, Vec<3>(0, 1, 2));
+    vec *= Vec<3>(3, 3, 3);
+    ASSERT_EQ(vec, Vec<3>(0, 3, 6));
+    vec *= 0.5;
+    ASSERT_EQ(vec, Vec<3>(0, 1.5, 3));
+
+    ASSERT_EQ(Vec<2>(1, 2) - Vec<2>(3, 4), Vec<2>(-2, -2));
+    ASSERT_EQ(-Vec<2>(1, 2), Vec<2>(-1, -2));
+    ASSERT_EQ(Vec<3>(1, 2, 3) * Vec<3>(4, 5, 6), Vec<3>(4, 10, 18));
+    ASSERT_EQ(Vec<2>(1, 2) * 2 * 0.4, Vec<2>(0.8, 1.6));
+    ASSERT_EQ(2 * Vec<2>(1, 2), Vec<2>(2, 4));
+}
+
+// dot() cross()
+TEST(Vec, product)
+{
+    ASSERT_EQ(dot(Vec<2>(1, 2), Vec<2>(3, 4)), 11);
+    ASSERT_EQ(cross(Vec<2>(1, 2), Vec<2>(3, 4)), Vec<1>(-2));
+    ASSERT_EQ(cross(Vec<3>(1, 0, 0), Vec<3>(0, 1, 0)), Vec<3>(0, 0, 1));
+}
+
+// operator<<()
+TEST(Vec, print)
+{
+    std::ostringstream oss;
+    oss << Vec<2>(1, 2);
+    ASSERT_EQ(oss.str(), Vector({1, 2}).to_string());
+}
@@ -2,6 +2,9 @@
 
 #include "tool.hpp"
 
+#include <cmath>
+#include <sstream>
+
 using namespace mla;
 
 // constructor destructor size() is_empty()
@@ -84,8 +87,17 @@ TEST(Vector, access)
     vector[0] = 0;
     ASSERT_EQ(vector[0], 0);
 
+    // at
+    ASSERT_EQ(vector.at(4), 5);
+    vector.at(4) = 6;
+    ASSERT_EQ(std::as_const(vector).at(4), 6);
+
     // check bounds
+#ifndef MLA_NO_BOUNDS_CHECK
     MY_ASSERT_THROW_MESSAGE(vector[5], std::runtime_error, "Error: Index out of range.");
+#endif
+    MY_ASSERT_THROW_MESSAGE(vector.at(5), std::runtime_error, "Error: Index out of range.");
+    MY_ASSERT_THROW_MESSAGE(vector.at(-1), std::runtime_error, "Error: Index out of range.");
 }
 
 // begin() end()
@@ -266,3 +278,113 @@ TEST(Vector, is_parallel)
     ASSERT_TRUE(is_parallel(one, Vector({-3, -4})));
     ASSERT_TRUE(is_parallel(one, Vector({6, 8})));
 }
+
+// expression templates
+TEST(Vector, expression)
+{
+    Vector a = {1, 2, 3};
+    Vector b = {4, 5, 6};
+    Vector c = {1, 1, 1};
+
+    // operations on vectors return vectors, with the whole member API
+    static_assert(std::is_same_v<decltype(a + b), Vector>);
+    static_assert(std::is_same_v<decltype(a * 2), Vector>);
+    ASSERT_EQ((a + b)[0], 5);
+    ASSERT_EQ((b - a).length(), std::sqrt(27.0));
+    ASSERT_EQ((a * 2).size(), 3);
+
+    // a lazy() operand makes the chain an expression, evaluated in a single pass
+    static_assert(!std::is_same_v<decltype(lazy(a) + b), Vector>);
+    static_assert(!std::is_same_v<decltype(lazy(a) * 2), Vector>);
+    Vector result = lazy(a) + lazy(b) * 2 - c;
+    ASSERT_EQ(result, Vector({8, 11, 14}));
+    ASSERT_EQ(a + b * 2 - c, result);
+    ASSERT_EQ((lazy(a) - c) * (lazy(b) + c) * 0.5, Vector({0, 3, 7}));
+
+    // operands may alias the destination
+    a = lazy(a) + lazy(a) * b;
+    ASSERT_EQ(a, Vector({5, 12, 21}));
+    a += lazy(b) - c;
+    ASSERT_EQ(a, Vector({8, 16, 26}));
+    a -= lazy(b) * 2;
+    ASSERT_EQ(a, Vector({0, 6, 14}));
+
+    // assignment resizes the destination
+    Vector d;
+    d = lazy(b) * c;
+    ASSERT_EQ(d, Vector({4, 5, 6}));
+
+    // expressions are accepted where a vector is expected
+    ASSERT_EQ(dot(lazy(a) + c, b), 4 + 35 + 90);
+    ASSERT_EQ(cross(lazy(b) - c, Vector({0, 0, 1})), Vector({4, -3, 0}));
+    ASSERT_EQ(cross(b + c, {1, 0, 0}), Vector({0, 7, -6}));
+    ASSERT_EQ(dot({1, 1, 1}, lazy(c) * 2), 6);
+    ASSERT_TRUE(is_orthogonal(lazy(c) - c, b));
+    ASSERT_TRUE(is_parallel(lazy(c) * 3, c));
+    std::ostringstream os;
+    os << lazy(c) * 2 << b + c;
+    ASSERT_EQ(os.str(), "[2.000000 2.000000 2.000000][5.000000 6.000000 7.000000]");
+
+    // large vectors
+    Vector x(100000, 1), y(100000, 2);
+    ASSERT_EQ(lazy(x) * 3 - y + x, Vector(100000, 2));
+
+    MY_ASSERT_THROW_MESSAGE(a += lazy(Vector({1})) * 2, std::runtime_error, "Error: The dimensions mismatch.");
+}
+
+// operator+(Vector&&) operator-(Vector&&) operator*(Vector&&)
+TEST(Vector, temporary_operands)
+{
+    Vector a(100, 1), b(100, 2);
+
+    // a temporary operand holds the result, even in a lazy chain
+    static_assert(std::is_same_v<decltype(Vector(a) + b), Vector>);
+    static_assert(std::is_same_v<decltype(lazy(a) * 2 - Vector(b)), Vector>);
+    static_assert(std::is_same_v<decltype(2.0 * Vector(a)), Vector>);
+    static_assert(std::is_nothrow_move_constructible_v<Vector>);
+
+    Vector t = b;
+    const double* storage = t.data();
+    Vector result = (std::move(t) + a) * 2.0 - a;
+    ASSERT_EQ(result.data(), storage);
+    ASSERT_EQ(result, Vector(100, 5));
+
+    // the order of the operands is kept
+    ASSERT_EQ(a - Vector(b), Vector(100, -1));
+    ASSERT_EQ(Vector(a) - b * 2, Vector(100, -3));
+    ASSERT_EQ(Vector(a) * Vector(b), Vector(100, 2));
+    ASSERT_EQ(0.5 * Vector(b), Vector(100, 1));
+
+    MY_ASSERT_THROW_MESSAGE(Vector(a) + Vector({1}), std::runtime_error, "Error: The dimensions mismatch.");
+}
+
+// BasicVector<float> BasicVector<std::complex<double>>
+TEST(Vector, scalar_types)
+{
+    using FloatVector = BasicVector<float>;
+    using ComplexVector = BasicVector<std::complex<double>>;
+    using namespace std::complex_literals;
+
+    // float, long enough for the SIMD kernels and their tails
+    FloatVector a(37, 1), b(37, 2);
+    ASSERT_EQ(a * 3 - b + a, FloatVector(37, 2));
+    a += b;
+    ASSERT_EQ(a, FloatVector(37, 3));
+    a *= 0.5f;
+    ASSERT_EQ(a, FloatVector(37, 1.5f));
+    ASSERT_EQ(dot(a, b), 111.0f);
+    ASSERT_FLOAT_EQ(FloatVector({3, 4}).length(), 5.0f);
+    ASSERT_EQ(FloatVector({1, 2}).to_string(), "[1.000000 2.000000]");
+    ASSERT_EQ(cross(FloatVector({1, 0, 0}), FloatVector({0, 1, 0})), FloatVector({0, 0, 1}));
+
+    // complex, with the length and orthogonality taken on the Hermitian inner product
+    ComplexVector c = {1.0 + 1i, 2.0};
+    ComplexVector d = {1i, 1.0 - 1i};
+    ASSERT_EQ(c + d, ComplexVector({1.0 + 2i, 3.0 - 1i}));
+    ASSERT_EQ(c * 1i, ComplexVector({-1.0 + 1i, 2i}));
+    ASSERT_EQ(dot(c, d), (1.0 + 1i) * 1i + 2.0 * (1.0 - 1i));
+    ASSERT_DOUBLE_EQ(ComplexVector({3i, 4.0}).length(), 5);
+    ASSERT_TRUE(is_orthogonal(ComplexVector({1.0, 1i}), ComplexVector({1.0, -1i})));
+    ASSERT_FALSE(is_orthogonal(ComplexVector({1.0, 1i}), ComplexVector({1.0, 1i})));
+    ASSERT_EQ(ComplexVector({1.0 + 2i}).to_string(), "[(1.000000,2.000000)]");
+}
@@ -14,4 +14,19 @@
         ASSERT_STREQ(e.what(), message);                        \
     }
 
+#define MY_ASSERT_MATRIX_DOUBLE_EQ(actual, expected)      \
+    {                                                     \
+        const auto& a_ = (actual);                        \
+        const auto& e_ = (expected);                      \
+        ASSERT_EQ(a_.row_size(), e_.row_size());          \
+        ASSERT_EQ(a_.col_size(), e_.col_size());          \
+        for (int r_ = 0; r_ < a_.row_size(); r_++)        \
+        {                                                 \
+            for (int c_ = 0; c_ < a_.col_size(); c_++)    \
+            {                                             \
+                ASSERT_DOUBLE_EQ(a_[r_][c_], e_[r_][c_]); \
+            }                                             \
+        }                                                 \
+    }
+
 #endif // TOOL_HPP
@@ -1,10 +1,14 @@
 add_rules("mode.debug", "mode.release")
 set_languages("c++17")
 add_requires("gtest", {configs = {main = true}})
+add_requires("benchmark")
 if is_plat("windows") then -- for MSVC
     add_cxflags("/utf-8")
     add_ldflags("/subsystem:console")
 end
+if is_plat("linux") then -- for std::thread
+    add_syslinks("pthread")
+end
 
 target("tests")
     set_kind("binary")
@@ -13,4 +17,16 @@ target("tests")
     add_headerfiles("tests/*.hpp")
     add_files("sources/*.cpp")
     add_files("tests/*.cpp")
+    set_warnings("allextra")
     add_packages("gtest")
+
+target("bench")
+    set_kind("binary")
+    set_default(false)
+    add_headerfiles("sources/*.h")
+    add_headerfiles("sources/*.hpp")
+    add_headerfiles("bench/*.hpp")
+    add_files("sources/*.cpp")
+    add_files("bench/*.cpp")
+    add_packages("benchmark")
+    set_runargs("--benchmark_out=bench.json", "--benchmark_out_format=json")